@@ -3304,6 +3304,7 @@ Register MacroAssembler::tlab_refill(Label& retry,
   add(top, top, t1);
   sub(top, top, (int32_t)ThreadLocalAllocBuffer::alignment_reserve_in_bytes());
   str(top, Address(rthread, in_bytes(JavaThread::tlab_end_offset())));
+  str(top, Address(rthread, in_bytes(JavaThread::tlab_allocation_end_offset())));
   verify_tlab();
   b(retry);
 
@@ -756,6 +756,8 @@ class StubGenerator: public StubCodeGenerator {
           __ br(Assembler::HS, L_loop);
         }
         break;
+      case BarrierSet::ModRef:
+        break;
       default:
         ShouldNotReachHere();
 
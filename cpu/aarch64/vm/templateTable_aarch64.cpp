@@ -3265,6 +3265,16 @@ void TemplateTable::_new() {
   if (allow_shared_alloc) {
     __ bind(allocate_shared);
 
+    if (UseTLAB) {
+      // The TLAB end may have been lowered to a heap sampling point. The
+      // allocation crossing it must reach the runtime to be sampled, and
+      // the runtime restores the real end.
+      __ ldr(rscratch1, Address(rthread, JavaThread::tlab_end_offset()));
+      __ ldr(rscratch2, Address(rthread, JavaThread::tlab_allocation_end_offset()));
+      __ cmp(rscratch1, rscratch2);
+      __ br(Assembler::NE, slow_case);
+    }
+
     __ eden_allocate(r0, r3, 0, r10, slow_case);
     __ incr_allocated_bytes(rthread, r3, 0, rscratch1);
   }
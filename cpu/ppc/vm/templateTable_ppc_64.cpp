@@ -3602,6 +3602,11 @@ void TemplateTable::_new() {
       Register RfreeValue = RnewTopValue;
 
       __ bind(Lallocate_shared);
+      // The TLAB end may have been lowered to a heap sampling point. The
+      // allocation crossing it must reach the runtime to be sampled.
+      __ ld(RtlabWasteLimitValue, in_bytes(JavaThread::tlab_allocation_end_offset()), R16_thread);
+      __ cmpld(CCR0, RendValue, RtlabWasteLimitValue);
+      __ bne(CCR0, Lslow_case);
       // Check if tlab should be discarded (refill_waste_limit >= free).
       __ ld(RtlabWasteLimitValue, in_bytes(JavaThread::tlab_refill_waste_limit_offset()), R16_thread);
       __ subf(RfreeValue, RoldTopValue, RendValue);
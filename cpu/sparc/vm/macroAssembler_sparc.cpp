@@ -3411,6 +3411,7 @@ void MacroAssembler::tlab_refill(Label& retry, Label& try_eden, Label& slow_case
   add(top, t1, top); // t1 is tlab_size
   sub(top, ThreadLocalAllocBuffer::alignment_reserve_in_bytes(), top);
   st_ptr(top, G2_thread, in_bytes(JavaThread::tlab_end_offset()));
+  st_ptr(top, G2_thread, in_bytes(JavaThread::tlab_allocation_end_offset()));
   verify_tlab();
   ba(retry);
   delayed()->nop();
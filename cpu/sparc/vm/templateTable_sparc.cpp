@@ -3336,6 +3336,11 @@ void TemplateTable::_new() {
     __ delayed()->st_ptr(RnewTopValue, G2_thread, in_bytes(JavaThread::tlab_top_offset()));
 
     if (allow_shared_alloc) {
+      // The TLAB end may have been lowered to a heap sampling point. The
+      // allocation crossing it must reach the runtime to be sampled.
+      __ ld_ptr(G2_thread, in_bytes(JavaThread::tlab_allocation_end_offset()), RtlabWasteLimitValue);
+      __ cmp_and_brx_short(RendValue, RtlabWasteLimitValue, Assembler::notEqual, Assembler::pn, slow_case);
+
       // Check if tlab should be discarded (refill_waste_limit >= free)
       __ ld_ptr(G2_thread, in_bytes(JavaThread::tlab_refill_waste_limit_offset()), RtlabWasteLimitValue);
       __ sub(RendValue, RoldTopValue, RfreeValue);
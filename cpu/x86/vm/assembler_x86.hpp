@@ -1659,6 +1659,7 @@ private:
   void subss(XMMRegister dst, XMMRegister src);
 
   void testb(Register dst, int imm8);
+  void testb(Address dst, int imm8);
 
   void testl(Register dst, int32_t imm32);
   void testl(Register dst, Register src);
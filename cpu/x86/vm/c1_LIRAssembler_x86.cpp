@@ -37,6 +37,7 @@
 #include "memory/cardTableModRefBS.hpp"
 #include "nativeInst_x86.hpp"
 #include "oops/objArrayKlass.hpp"
+#include "runtime/safepointMechanism.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "vmreg_x86.inline.hpp"
 
@@ -606,6 +607,13 @@ void LIR_Assembler::return_op(LIR_Opr result) {
   // the poll sets the condition code, but no data registers
   AddressLiteral polling_page(os::get_polling_page(), relocInfo::poll_return_type);
 
+#ifdef _LP64
+  if (SafepointMechanism::uses_thread_local_poll()) {
+    __ movptr(rscratch1, Address(r15_thread, JavaThread::polling_page_offset()));
+    __ relocate(relocInfo::poll_return_type);
+    __ testl(rax, Address(rscratch1, 0));
+  } else
+#endif
   if (Assembler::is_polling_page_far()) {
     __ lea(rscratch1, polling_page);
     __ relocate(relocInfo::poll_return_type);
@@ -621,6 +629,15 @@ int LIR_Assembler::safepoint_poll(LIR_Opr tmp, CodeEmitInfo* info) {
   AddressLiteral polling_page(os::get_polling_page(), relocInfo::poll_type);
   guarantee(info != NULL, "Shouldn't be NULL");
   int offset = __ offset();
+#ifdef _LP64
+  if (SafepointMechanism::uses_thread_local_poll()) {
+    __ movptr(rscratch1, Address(r15_thread, JavaThread::polling_page_offset()));
+    offset = __ offset();
+    add_debug_info_for_branch(info);
+    __ relocate(relocInfo::poll_type);
+    __ testl(rax, Address(rscratch1, 0));
+  } else
+#endif
   if (Assembler::is_polling_page_far()) {
     __ lea(rscratch1, polling_page);
     offset = __ offset();
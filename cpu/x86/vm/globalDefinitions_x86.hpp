@@ -58,4 +58,9 @@ const bool CCallingConventionRequiresIntsAsLongs = false;
   #endif
 #endif
 
+// The template interpreter, C1 and C2 poll a thread-local word on x86_64.
+#if defined(_LP64) && !defined(CC_INTERP)
+#define THREAD_LOCAL_POLL
+#endif
+
 #endif // CPU_X86_VM_GLOBALDEFINITIONS_X86_HPP
@@ -176,5 +176,10 @@ define_pd_global(uintx, TypeProfileLevel, 111);
           "Use BMI1 instructions")                                          \
                                                                             \
   product(bool, UseBMI2Instructions, false,                                 \
-          "Use BMI2 instructions")
+          "Use BMI2 instructions")                                          \
+                                                                            \
+  /* time stamps */                                                         \
+  experimental(bool, UseFastUnorderedTimeStamps, false,                     \
+          "Stamp Ticks and trace events with the invariant time-stamp "     \
+          "counter; stamps from different CPUs may be slightly unordered")
 #endif // CPU_X86_VM_GLOBALS_X86_HPP
@@ -474,7 +474,7 @@ void InterpreterMacroAssembler::dispatch_base(TosState state, address* table,
 }
 
 
-void InterpreterMacroAssembler::dispatch_only(TosState state) {
+void InterpreterMacroAssembler::dispatch_only(TosState state, bool generate_poll) {
   dispatch_base(state, Interpreter::dispatch_table(state));
 }
 
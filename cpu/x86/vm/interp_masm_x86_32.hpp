@@ -127,7 +127,7 @@
   // Dispatching
   void dispatch_prolog(TosState state, int step = 0);
   void dispatch_epilog(TosState state, int step = 0);
-  void dispatch_only(TosState state);                      // dispatch via rbx, (assume rbx, is loaded already)
+  void dispatch_only(TosState state, bool generate_poll = false); // dispatch via rbx, (assume rbx, is loaded already)
   void dispatch_only_normal(TosState state);               // dispatch normal table via rbx, (assume rbx, is loaded already)
   void dispatch_only_noverify(TosState state);
   void dispatch_next(TosState state, int step = 0);        // load rbx, from [esi + step] and dispatch via rbx,
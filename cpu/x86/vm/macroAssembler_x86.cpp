@@ -4495,6 +4495,7 @@ Register MacroAssembler::tlab_refill(Label& retry,
   addptr(top, t1);
   subptr(top, (int32_t)ThreadLocalAllocBuffer::alignment_reserve_in_bytes());
   movptr(Address(thread_reg, in_bytes(JavaThread::tlab_end_offset())), top);
+  movptr(Address(thread_reg, in_bytes(JavaThread::tlab_allocation_end_offset())), top);
   verify_tlab();
   jmp(retry);
 
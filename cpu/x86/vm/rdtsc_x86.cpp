@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "rdtsc_x86.hpp"
+#include "runtime/globals_extension.hpp"
+#include "runtime/os.inline.hpp"
+#include "vm_version_x86.hpp"
+
+bool  Rdtsc::_enabled   = false;
+jlong Rdtsc::_epoch     = 0;
+jlong Rdtsc::_frequency = 0;
+
+// Length of one calibration interval
+#define RDTSC_CALIBRATION_MILLIS 5
+
+// The TSC rate in Hz, measured against os::elapsed_counter()
+jlong Rdtsc::calibrate() {
+  const jlong os_start  = os::elapsed_counter();
+  const jlong tsc_start = os::rdtsc();
+  os::naked_short_sleep(RDTSC_CALIBRATION_MILLIS);
+  const jlong os_end    = os::elapsed_counter();
+  const jlong tsc_end   = os::rdtsc();
+
+  if (os_end <= os_start || tsc_end <= tsc_start) {
+    return 0;
+  }
+  return (jlong) ((double) (tsc_end - tsc_start) *
+                  (double) os::elapsed_frequency() / (double) (os_end - os_start));
+}
+
+bool Rdtsc::initialize() {
+  assert(!_enabled, "initialize once");
+  if (!UseFastUnorderedTimeStamps) {
+    return false;
+  }
+  if (!VM_Version::supports_tscinv_bit()) {
+    warning("Ignoring UseFastUnorderedTimeStamps, the CPU has no invariant "
+            "time-stamp counter");
+    FLAG_SET_DEFAULT(UseFastUnorderedTimeStamps, false);
+    return false;
+  }
+
+  // Two intervals must agree within 1%, otherwise we were descheduled
+  // while calibrating or the counter does not tick at a constant rate.
+  jlong frequency = 0;
+  for (int attempt = 0; attempt < 3 && frequency == 0; attempt++) {
+    jlong first  = calibrate();
+    jlong second = calibrate();
+    if (first > 0 && second > 0 && ABS(first - second) <= first / 100) {
+      frequency = (first + second) / 2;
+    }
+  }
+  if (frequency == 0) {
+    warning("Ignoring UseFastUnorderedTimeStamps, could not calibrate the "
+            "time-stamp counter");
+    FLAG_SET_DEFAULT(UseFastUnorderedTimeStamps, false);
+    return false;
+  }
+
+  _frequency = frequency;
+  _epoch     = os::rdtsc();
+  _enabled   = true;
+  if (PrintMiscellaneous && Verbose) {
+    tty->print_cr("Time-stamp counter frequency: " JLONG_FORMAT " Hz", _frequency);
+  }
+  return true;
+}
+
+jlong Rdtsc::elapsed_counter() {
+  return os::rdtsc() - _epoch;
+}
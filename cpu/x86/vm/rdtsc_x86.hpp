@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef CPU_X86_VM_RDTSC_X86_HPP
+#define CPU_X86_VM_RDTSC_X86_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+// Elapsed time from the invariant time-stamp counter, for
+// -XX:+UseFastUnorderedTimeStamps.  Reading the TSC costs a few cycles
+// instead of a clock_gettime() call.  rdtsc is not serializing and the
+// counters of different sockets may drift a little apart, so the stamps
+// are only suitable for timing and tracing, not for ordering events.
+class Rdtsc : AllStatic {
+ private:
+  static bool  _enabled;
+  static jlong _epoch;
+  static jlong _frequency;
+
+  static jlong calibrate();
+
+ public:
+  // Called once after VM_Version_init().  Returns false, and clears
+  // UseFastUnorderedTimeStamps, if the counter cannot be used.
+  static bool initialize();
+
+  static bool  is_enabled()      { return _enabled; }
+  static jlong elapsed_counter();
+  static jlong frequency()       { return _frequency; }
+};
+
+#endif // CPU_X86_VM_RDTSC_X86_HPP
@@ -31,6 +31,7 @@
 #include "interpreter/interpreter.hpp"
 #include "oops/compiledICHolder.hpp"
 #include "prims/jvmtiRedefineClassesTrace.hpp"
+#include "runtime/safepointMechanism.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/vframeArray.hpp"
 #include "vmreg_x86.inline.hpp"
@@ -2392,6 +2393,11 @@ nmethod* SharedRuntime::generate_native_wrapper(MacroAssembler* masm,
 
     Label L;
     __ jcc(Assembler::notEqual, L);
+    if (SafepointMechanism::uses_thread_local_poll()) {
+      // A handshake is pending
+      __ testb(Address(r15_thread, JavaThread::polling_page_offset()), SafepointMechanism::poll_bit());
+      __ jcc(Assembler::notZero, L);
+    }
     __ cmpl(Address(r15_thread, JavaThread::suspend_flags_offset()), 0);
     __ jcc(Assembler::equal, Continue);
     __ bind(L);
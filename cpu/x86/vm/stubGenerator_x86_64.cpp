@@ -1293,6 +1293,8 @@ class StubGenerator: public StubCodeGenerator {
           __ jcc(Assembler::greaterEqual, L_loop);
         }
         break;
+      case BarrierSet::ModRef:
+        break;
       default:
         ShouldNotReachHere();
 
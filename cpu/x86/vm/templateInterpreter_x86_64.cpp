@@ -39,6 +39,7 @@
 #include "runtime/arguments.hpp"
 #include "runtime/deoptimization.hpp"
 #include "runtime/frame.inline.hpp"
+#include "runtime/safepointMechanism.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/stubRoutines.hpp"
 #include "runtime/synchronizer.hpp"
@@ -1084,6 +1085,11 @@ address InterpreterGenerator::generate_native_entry(bool synchronized) {
 
     Label L;
     __ jcc(Assembler::notEqual, L);
+    if (SafepointMechanism::uses_thread_local_poll()) {
+      // A handshake is pending
+      __ testb(Address(r15_thread, JavaThread::polling_page_offset()), SafepointMechanism::poll_bit());
+      __ jcc(Assembler::notZero, L);
+    }
     __ cmpl(Address(r15_thread, JavaThread::suspend_flags_offset()), 0);
     __ jcc(Assembler::equal, Continue);
     __ bind(L);
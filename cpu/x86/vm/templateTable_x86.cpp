@@ -33,6 +33,7 @@
 #include "oops/objArrayKlass.hpp"
 #include "oops/oop.inline.hpp"
 #include "prims/methodHandles.hpp"
+#include "runtime/safepointMechanism.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/stubRoutines.hpp"
 #include "runtime/synchronizer.hpp"
@@ -2080,7 +2081,7 @@ void TemplateTable::branch(bool is_jsr, bool is_wide) {
   // rax: return bci for jsr's, unused otherwise
   // rbx: target bytecode
   // r13: target bcp
-  __ dispatch_only(vtos);
+  __ dispatch_only(vtos, true);
 
   if (UseLoopCounter) {
     if (ProfileInterpreter) {
@@ -2445,6 +2446,22 @@ void TemplateTable::_return(TosState state) {
     __ bind(skip_register_finalizer);
   }
 
+#ifdef _LP64
+  // Stop for a handshake before returning; returns and branches are
+  // where the interpreter checks the thread-local poll.
+  if (SafepointMechanism::uses_thread_local_poll() &&
+      _desc->bytecode() != Bytecodes::_return_register_finalizer) {
+    Label no_safepoint;
+    NOT_PRODUCT(__ block_comment("Thread-local Safepoint poll"));
+    __ testb(Address(r15_thread, JavaThread::polling_page_offset()), SafepointMechanism::poll_bit());
+    __ jcc(Assembler::zero, no_safepoint);
+    __ push(state);
+    __ call_VM(noreg, CAST_FROM_FN_PTR(address, InterpreterRuntime::at_safepoint));
+    __ pop(state);
+    __ bind(no_safepoint);
+  }
+#endif
+
   __ remove_activation(state, rbcp);
   __ jmp(rbcp);
 }
@@ -3744,6 +3761,15 @@ void TemplateTable::_new() {
   if (allow_shared_alloc) {
     __ bind(allocate_shared);
 
+    if (UseTLAB) {
+      // The TLAB end may have been lowered to a heap sampling point. The
+      // allocation crossing it must reach the runtime to be sampled, and
+      // the runtime restores the real end.
+      __ movptr(rbx, Address(thread, in_bytes(JavaThread::tlab_end_offset())));
+      __ cmpptr(rbx, Address(thread, in_bytes(JavaThread::tlab_allocation_end_offset())));
+      __ jcc(Assembler::notEqual, slow_case);
+    }
+
     ExternalAddress heap_top((address)Universe::heap()->top_addr());
     ExternalAddress heap_end((address)Universe::heap()->end_addr());
 
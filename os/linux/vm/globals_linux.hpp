@@ -47,7 +47,30 @@
           "Load DLLs with executable-stack attribute in the VM Thread") \
                                                                         \
   product(bool, UseSHM, false,                                          \
-          "Use SYSV shared memory for large pages")
+          "Use SYSV shared memory for large pages")                     \
+                                                                        \
+  product(bool, UseFutexParking, true,                                  \
+          "Block parked threads with futex(2) instead of pthread "      \
+          "condition variables where the kernel supports it")           \
+                                                                        \
+  product(bool, UseContainerSupport, true,                              \
+          "Size the VM from the cgroup (v1 or v2) limits of the "       \
+          "container it runs in")                                       \
+                                                                        \
+  product(bool, PreferContainerQuotaForCPUCount, true,                  \
+          "Count CPUs from the container's cpu quota alone when both "  \
+          "quota and shares are set")                                   \
+                                                                        \
+  product(bool, PrintContainerInfo, false,                              \
+          "Print container limits as they are read")                    \
+                                                                        \
+  product(intx, ActiveProcessorCount, -1,                               \
+          "Number of CPUs the VM sizes itself for, overriding the "     \
+          "system and container values (-1 to compute)")                \
+                                                                        \
+  diagnostic(ccstr, ContainerRootPath, NULL,                            \
+          "Directory taken as the root of /proc and the cgroup mounts " \
+          "by the container support, e.g. a fake tree for testing")
 
 //
 // Defines Linux-specific default values. The flags are available on all
@@ -0,0 +1,440 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "osContainer_linux.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/os.hpp"
+
+# include <stdio.h>
+# include <string.h>
+# include <math.h>
+# include <sys/param.h>
+
+bool OSContainer::_is_initialized   = false;
+bool OSContainer::_is_containerized = false;
+jlong OSContainer::_memory_limit     = -1;
+
+// cgroup v1 cpu.shares of a single, unconstrained CPU
+#define PER_CPU_SHARES 1024
+
+// Re-read the cpu limits at most this often, availableProcessors() is
+// called a lot by some libraries
+#define OSCONTAINER_CACHE_TIMEOUT (NANOSECS_PER_SEC / 50)
+
+static int  cgroup_version = 0;       // 1 or 2, 0 if not found
+
+// Directories holding the interface files, ContainerRootPath included
+static char* memory_dir = NULL;
+static char* cpu_dir    = NULL;
+static char* cpuset_dir = NULL;
+
+#define trace_container(...)                  \
+  do {                                        \
+    if (PrintContainerInfo) {                 \
+      tty->print_cr(__VA_ARGS__);             \
+    }                                         \
+  } while (0)
+
+static const char* root_path() {
+  return ContainerRootPath != NULL ? ContainerRootPath : "";
+}
+
+// One mount of a cgroup hierarchy, from /proc/self/mountinfo
+struct CgroupMount {
+  bool found;
+  char root[MAXPATHLEN + 1];          // root of the mount within the hierarchy
+  char mount_point[MAXPATHLEN + 1];
+};
+
+// Map the process' cgroup path to the directory under the mount point.
+// Inside a container the mount is usually rooted at the container's own
+// cgroup, in which case the mount point is the answer.
+static char* subsystem_dir(const CgroupMount* mount, const char* cgroup_path) {
+  char buf[MAXPATHLEN + 1];
+  const char* suffix = "";
+  if (strcmp(mount->root, "/") == 0) {
+    if (strcmp(cgroup_path, "/") != 0) {
+      suffix = cgroup_path;
+    }
+  } else if (strcmp(mount->root, cgroup_path) != 0) {
+    size_t root_len = strlen(mount->root);
+    if (strncmp(cgroup_path, mount->root, root_len) == 0 &&
+        cgroup_path[root_len] == '/') {
+      suffix = cgroup_path + root_len;
+    }
+  }
+  jio_snprintf(buf, sizeof(buf), "%s%s%s", root_path(), mount->mount_point, suffix);
+  return os::strdup(buf, mtInternal);
+}
+
+static void strip_newline(char* s) {
+  size_t len = strlen(s);
+  if (len > 0 && s[len - 1] == '\n') {
+    s[len - 1] = '\0';
+  }
+}
+
+static bool has_token(const char* list, const char* token) {
+  size_t len = strlen(token);
+  for (const char* p = list; p != NULL; p = strchr(p, ',')) {
+    if (*p == ',') p++;
+    if (strncmp(p, token, len) == 0 && (p[len] == ',' || p[len] == '\0')) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static bool find_cgroup_dirs() {
+  char path[MAXPATHLEN + 1];
+  char line[MAXPATHLEN + 1];
+  char mount_root[MAXPATHLEN + 1];
+  char mount_point[MAXPATHLEN + 1];
+  char fstype[MAXPATHLEN + 1];
+  char options[MAXPATHLEN + 1];
+
+  CgroupMount memory  = { false };
+  CgroupMount cpu     = { false };
+  CgroupMount cpuset  = { false };
+  CgroupMount unified = { false };
+
+  jio_snprintf(path, sizeof(path), "%s/proc/self/mountinfo", root_path());
+  FILE* fp = fopen(path, "r");
+  if (fp == NULL) {
+    trace_container("Can't open %s", path);
+    return false;
+  }
+  // 36 35 98:0 /mnt1 /mnt/parent rw,noatime master:1 - cgroup cgroup rw,memory
+  while (fgets(line, sizeof(line), fp) != NULL) {
+    char* sep = strstr(line, " - ");
+    if (sep == NULL) continue;
+    *sep = '\0';
+    if (sscanf(line, "%*d %*d %*d:%*d %s %s", mount_root, mount_point) != 2 ||
+        sscanf(sep + 3, "%s %*s %s", fstype, options) != 2) {
+      continue;
+    }
+    CgroupMount* mounts[3] = { NULL, NULL, NULL };
+    if (strcmp(fstype, "cgroup2") == 0) {
+      mounts[0] = &unified;
+    } else if (strcmp(fstype, "cgroup") == 0) {
+      if (has_token(options, "memory")) mounts[0] = &memory;
+      if (has_token(options, "cpu"))    mounts[1] = &cpu;
+      if (has_token(options, "cpuset")) mounts[2] = &cpuset;
+    }
+    for (int i = 0; i < 3; i++) {
+      if (mounts[i] != NULL && !mounts[i]->found) {
+        mounts[i]->found = true;
+        strcpy(mounts[i]->root, mount_root);
+        strcpy(mounts[i]->mount_point, mount_point);
+      }
+    }
+  }
+  fclose(fp);
+
+  // Hybrid hosts mount an empty cgroup2 hierarchy next to the v1
+  // controllers; the v1 controllers hold the limits then.
+  if (memory.found || cpu.found) {
+    cgroup_version = 1;
+  } else if (unified.found) {
+    cgroup_version = 2;
+  } else {
+    trace_container("No cgroup file system mounted");
+    return false;
+  }
+
+  // 4:memory:/docker/<id> for v1, 0::/<path> for v2
+  jio_snprintf(path, sizeof(path), "%s/proc/self/cgroup", root_path());
+  fp = fopen(path, "r");
+  if (fp == NULL) {
+    trace_container("Can't open %s", path);
+    return false;
+  }
+  while (fgets(line, sizeof(line), fp) != NULL) {
+    strip_newline(line);
+    char* controllers = strchr(line, ':');
+    char* cgroup_path = controllers != NULL ? strchr(controllers + 1, ':') : NULL;
+    if (cgroup_path == NULL) continue;
+    *controllers++ = '\0';
+    *cgroup_path++ = '\0';
+    if (cgroup_version == 2) {
+      if (*controllers == '\0' && unified.found) {
+        memory_dir = subsystem_dir(&unified, cgroup_path);
+        cpu_dir    = subsystem_dir(&unified, cgroup_path);
+        cpuset_dir = subsystem_dir(&unified, cgroup_path);
+      }
+    } else {
+      if (memory.found && memory_dir == NULL && has_token(controllers, "memory")) {
+        memory_dir = subsystem_dir(&memory, cgroup_path);
+      }
+      if (cpu.found && cpu_dir == NULL && has_token(controllers, "cpu")) {
+        cpu_dir = subsystem_dir(&cpu, cgroup_path);
+      }
+      if (cpuset.found && cpuset_dir == NULL && has_token(controllers, "cpuset")) {
+        cpuset_dir = subsystem_dir(&cpuset, cgroup_path);
+      }
+    }
+  }
+  fclose(fp);
+
+  if (memory_dir == NULL && cpu_dir == NULL) {
+    trace_container("No cgroup found for this process");
+    return false;
+  }
+  trace_container("cgroup v%d: memory %s, cpu %s, cpuset %s", cgroup_version,
+                  memory_dir != NULL ? memory_dir : "<none>",
+                  cpu_dir    != NULL ? cpu_dir    : "<none>",
+                  cpuset_dir != NULL ? cpuset_dir : "<none>");
+  return true;
+}
+
+// Read the first line of an interface file.
+static bool read_line(const char* dir, const char* file, char* buf, size_t len) {
+  if (dir == NULL) {
+    return false;
+  }
+  char path[MAXPATHLEN + 1];
+  jio_snprintf(path, sizeof(path), "%s/%s", dir, file);
+  FILE* fp = fopen(path, "r");
+  if (fp == NULL) {
+    trace_container("Can't open %s", path);
+    return false;
+  }
+  bool ok = fgets(buf, (int) len, fp) != NULL;
+  fclose(fp);
+  if (ok) {
+    strip_newline(buf);
+  }
+  return ok;
+}
+
+// A number, or "max" (-1) for no limit.
+static jlong read_number(const char* dir, const char* file) {
+  char buf[64];
+  jlong value;
+  if (!read_line(dir, file, buf, sizeof(buf))) {
+    return OSCONTAINER_ERROR;
+  }
+  if (strncmp(buf, "max", 3) == 0) {
+    return -1;
+  }
+  if (sscanf(buf, JLONG_FORMAT, &value) != 1) {
+    return OSCONTAINER_ERROR;
+  }
+  return value;
+}
+
+// The value of "key value" line in a flat keyed file like memory.stat.
+static jlong read_keyed_number(const char* dir, const char* file, const char* key) {
+  if (dir == NULL) {
+    return OSCONTAINER_ERROR;
+  }
+  char path[MAXPATHLEN + 1];
+  char line[256];
+  size_t key_len = strlen(key);
+  jlong value = OSCONTAINER_ERROR;
+  jio_snprintf(path, sizeof(path), "%s/%s", dir, file);
+  FILE* fp = fopen(path, "r");
+  if (fp == NULL) {
+    return OSCONTAINER_ERROR;
+  }
+  while (fgets(line, sizeof(line), fp) != NULL) {
+    if (strncmp(line, key, key_len) == 0 && line[key_len] == ' ') {
+      if (sscanf(line + key_len + 1, JLONG_FORMAT, &value) != 1) {
+        value = OSCONTAINER_ERROR;
+      }
+      break;
+    }
+  }
+  fclose(fp);
+  return value;
+}
+
+void OSContainer::init() {
+  assert(!_is_initialized, "Initializing OSContainer more than once");
+  _is_initialized = true;
+  _is_containerized = false;
+
+  if (!UseContainerSupport) {
+    return;
+  }
+  trace_container("OSContainer::init: Initializing Container Support");
+  _is_containerized = find_cgroup_dirs();
+  if (_is_containerized) {
+    // Traced once here; os::physical_memory() uses the cached value
+    _memory_limit = memory_limit_in_bytes();
+  }
+}
+
+const char* OSContainer::container_type() {
+  return cgroup_version == 2 ? "cgroupv2" : "cgroupv1";
+}
+
+jlong OSContainer::memory_limit_in_bytes() {
+  jlong limit;
+  if (cgroup_version == 2) {
+    limit = read_number(memory_dir, "memory.max");
+  } else {
+    limit = read_number(memory_dir, "memory.limit_in_bytes");
+    // v1 reports no limit as a page aligned LONG_MAX; a limit may also
+    // be set further up the hierarchy
+    if (limit >= (max_jlong & ~(jlong) (os::vm_page_size() - 1))) {
+      limit = read_keyed_number(memory_dir, "memory.stat", "hierarchical_memory_limit");
+      if (limit >= (max_jlong & ~(jlong) (os::vm_page_size() - 1))) {
+        limit = -1;
+      }
+    }
+  }
+  trace_container("Memory Limit is: " JLONG_FORMAT, limit);
+  return limit;
+}
+
+jlong OSContainer::memory_usage_in_bytes() {
+  return read_number(memory_dir,
+                     cgroup_version == 2 ? "memory.current" : "memory.usage_in_bytes");
+}
+
+int OSContainer::cpu_quota() {
+  jlong quota;
+  if (cgroup_version == 2) {
+    // cpu.max: "$MAX $PERIOD"
+    char buf[64];
+    if (!read_line(cpu_dir, "cpu.max", buf, sizeof(buf))) {
+      return OSCONTAINER_ERROR;
+    }
+    if (strncmp(buf, "max", 3) == 0) {
+      quota = -1;
+    } else if (sscanf(buf, JLONG_FORMAT, &quota) != 1) {
+      return OSCONTAINER_ERROR;
+    }
+  } else {
+    quota = read_number(cpu_dir, "cpu.cfs_quota_us");
+  }
+  trace_container("CPU Quota is: " JLONG_FORMAT, quota);
+  return (int) quota;
+}
+
+int OSContainer::cpu_period() {
+  jlong period;
+  if (cgroup_version == 2) {
+    char buf[64];
+    if (!read_line(cpu_dir, "cpu.max", buf, sizeof(buf)) ||
+        sscanf(buf, "%*s " JLONG_FORMAT, &period) != 1) {
+      return OSCONTAINER_ERROR;
+    }
+  } else {
+    period = read_number(cpu_dir, "cpu.cfs_period_us");
+  }
+  trace_container("CPU Period is: " JLONG_FORMAT, period);
+  return (int) period;
+}
+
+// Returns -1 for the default weight, i.e. no shares were configured.
+int OSContainer::cpu_shares() {
+  jlong shares;
+  if (cgroup_version == 2) {
+    // cpu.weight ranges from 1 to 10000 with a default of 100; map it
+    // linearly onto the v1 cpu.shares range of 2 to 262144
+    jlong weight = read_number(cpu_dir, "cpu.weight");
+    if (weight <= 0) {
+      return (int) weight;
+    }
+    if (weight == 100) {
+      return -1;
+    }
+    shares = (262142 * weight - 1) / 9999 + 2;
+  } else {
+    shares = read_number(cpu_dir, "cpu.shares");
+    if (shares == PER_CPU_SHARES) {
+      return -1;
+    }
+  }
+  trace_container("CPU Shares is: " JLONG_FORMAT, shares);
+  return (int) shares;
+}
+
+// The number of CPUs the container may use: the quota rounded up, or
+// the shares relative to a single CPU, whichever is set (with both set,
+// PreferContainerQuotaForCPUCount picks the quota, otherwise the
+// smaller count wins), bounded by the CPUs in the affinity mask.
+int OSContainer::active_processor_count() {
+  static volatile jlong last_update = 0;
+  static volatile int   cached_count = 0;
+
+  jlong now = os::javaTimeNanos();
+  if (cached_count > 0 && now - last_update < OSCONTAINER_CACHE_TIMEOUT) {
+    return cached_count;
+  }
+
+  int cpu_count = os::Linux::active_processor_count();
+  int limit_count = cpu_count;
+  int quota_count = 0;
+  int share_count = 0;
+
+  int quota  = cpu_quota();
+  int period = cpu_period();
+  int share  = cpu_shares();
+
+  if (quota > -1 && period > 0) {
+    quota_count = (int) ceilf((float) quota / (float) period);
+  }
+  if (share > -1) {
+    share_count = (int) ceilf((float) share / (float) PER_CPU_SHARES);
+  }
+
+  if (quota_count != 0 && share_count != 0) {
+    limit_count = PreferContainerQuotaForCPUCount ? quota_count
+                                                  : MIN2(quota_count, share_count);
+  } else if (quota_count != 0) {
+    limit_count = quota_count;
+  } else if (share_count != 0) {
+    limit_count = share_count;
+  }
+
+  int result = MAX2(MIN2(cpu_count, limit_count), 1);
+  trace_container("OSContainer::active_processor_count: %d", result);
+
+  cached_count = result;
+  last_update = now;
+  return result;
+}
+
+void OSContainer::print_container_info(outputStream* st) {
+  if (!is_containerized()) {
+    return;
+  }
+  char buf[MAXPATHLEN + 1];
+  st->print_cr("container (%s) information:", container_type());
+  st->print_cr("  memory_limit_in_bytes: " JLONG_FORMAT, memory_limit_in_bytes());
+  st->print_cr("  memory_usage_in_bytes: " JLONG_FORMAT, memory_usage_in_bytes());
+  st->print_cr("  cpu_quota: %d", cpu_quota());
+  st->print_cr("  cpu_period: %d", cpu_period());
+  st->print_cr("  cpu_shares: %d", cpu_shares());
+  if (read_line(cpuset_dir,
+                cgroup_version == 2 ? "cpuset.cpus.effective" : "cpuset.cpus",
+                buf, sizeof(buf))) {
+    st->print_cr("  cpuset_cpus: %s", buf);
+  }
+  st->print_cr("  active_processor_count: %d", active_processor_count());
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef OS_LINUX_VM_OSCONTAINER_LINUX_HPP
+#define OS_LINUX_VM_OSCONTAINER_LINUX_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/globalDefinitions.hpp"
+#include "utilities/ostream.hpp"
+
+#define OSCONTAINER_ERROR (-2)
+
+// Resource limits of the cgroup (v1 or v2) the VM runs in.
+//
+// The cgroup mounts are found through /proc/self/mountinfo and the
+// process' cgroup through /proc/self/cgroup.  All paths are taken
+// relative to ContainerRootPath, so a directory tree mimicking /proc and
+// the cgroup mounts can stand in for the real ones.
+//
+// The limit accessors return -1 when there is no limit and
+// OSCONTAINER_ERROR when the value cannot be read.
+class OSContainer: AllStatic {
+ private:
+  static bool _is_initialized;
+  static bool _is_containerized;
+  static jlong _memory_limit;
+
+ public:
+  // Must be called after argument parsing and before ergonomics
+  static void init();
+  // False until init(), so early callers see the host values
+  static bool is_containerized() { return _is_containerized; }
+  static const char* container_type();
+
+  static jlong memory_limit_in_bytes();
+  // The memory limit as read by init()
+  static jlong cached_memory_limit() { return _memory_limit; }
+  static jlong memory_usage_in_bytes();
+
+  static int cpu_quota();
+  static int cpu_period();
+  static int cpu_shares();
+  // The CPUs the limits above amount to, at most the affinity mask size
+  static int active_processor_count();
+
+  static void print_container_info(outputStream* st);
+};
+
+#endif // OS_LINUX_VM_OSCONTAINER_LINUX_HPP
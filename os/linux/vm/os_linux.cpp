@@ -38,6 +38,7 @@
 #include "oops/oop.inline.hpp"
 #include "os_linux.inline.hpp"
 #include "os_share_linux.hpp"
+#include "osContainer_linux.hpp"
 #include "prims/jniFastGetField.hpp"
 #include "prims/jvm.h"
 #include "prims/jvm_misc.hpp"
@@ -104,6 +105,7 @@
 # include <stdint.h>
 # include <inttypes.h>
 # include <sys/ioctl.h>
+# include <linux/futex.h>
 
 PRAGMA_FORMAT_MUTE_WARNINGS_FOR_GCC
 
@@ -138,6 +140,7 @@ const int os::Linux::_vm_default_page_size = (8 * K);
 bool os::Linux::_is_floating_stack = false;
 bool os::Linux::_is_NPTL = false;
 bool os::Linux::_supports_fast_thread_cpu_time = false;
+bool os::Linux::_use_futex = false;
 const char * os::Linux::_glibc_version = NULL;
 const char * os::Linux::_libpthread_version = NULL;
 pthread_condattr_t os::Linux::_condattr[1];
@@ -175,12 +178,29 @@ julong os::available_memory() {
 julong os::Linux::available_memory() {
   // values in struct sysinfo are "unsigned long"
   struct sysinfo si;
-  sysinfo(&si);
+  julong avail_mem;
 
-  return (julong)si.freeram * si.mem_unit;
+  if (OSContainer::is_containerized()) {
+    jlong mem_limit = OSContainer::memory_limit_in_bytes();
+    jlong mem_usage = OSContainer::memory_usage_in_bytes();
+    if (mem_limit > 0 && mem_usage > 0) {
+      return mem_limit > mem_usage ? (julong)(mem_limit - mem_usage) : 0;
+    }
+  }
+
+  sysinfo(&si);
+  avail_mem = (julong)si.freeram * si.mem_unit;
+  return avail_mem;
 }
 
 julong os::physical_memory() {
+  if (OSContainer::is_containerized()) {
+    // Read once by OSContainer::init(); this is called a lot.
+    jlong mem_limit = OSContainer::cached_memory_limit();
+    if (mem_limit > 0 && (julong)mem_limit < Linux::physical_memory()) {
+      return mem_limit;
+    }
+  }
   return Linux::physical_memory();
 }
 
@@ -2147,6 +2167,8 @@ void os::print_os_info(outputStream* st) {
   os::Posix::print_load_average(st);
 
   os::Linux::print_full_memory_info(st);
+
+  OSContainer::print_container_info(st);
 }
 
 // Try to identify popular distros.
@@ -4683,6 +4705,8 @@ extern "C" {
 jint os::init_2(void) {
   Linux::fast_thread_clock_init();
 
+  Linux::futex_init();
+
   // Allocate a single page and mark it as readable for safepoint polling
   address polling_page = (address) ::mmap(NULL, Linux::page_size(), PROT_READ, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
   guarantee(polling_page != MAP_FAILED, "os::init_2: failed to allocate polling page");
@@ -4849,12 +4873,44 @@ void os::make_polling_page_readable(void) {
   }
 }
 
+int os::Linux::active_processor_count() {
+  // Linux doesn't yet have a (official) notion of processor sets, but
+  // cpusets and taskset show up in the affinity mask.
+  int cpu_count = 0;
+  int configured = os::processor_count();
+  if (configured <= CPU_SETSIZE) {
+    cpu_set_t cpus;
+    if (sched_getaffinity(0, sizeof(cpus), &cpus) == 0) {
+      cpu_count = CPU_COUNT(&cpus);
+    }
+  } else {
+    cpu_set_t* cpus = CPU_ALLOC(configured);
+    if (cpus != NULL) {
+      size_t size = CPU_ALLOC_SIZE(configured);
+      if (sched_getaffinity(0, size, cpus) == 0) {
+        cpu_count = CPU_COUNT_S(size, cpus);
+      }
+      CPU_FREE(cpus);
+    }
+  }
+  if (cpu_count <= 0) {
+    // fall back to the number of online processors
+    cpu_count = ::sysconf(_SC_NPROCESSORS_ONLN);
+  }
+  assert(cpu_count > 0 && cpu_count <= processor_count(), "sanity check");
+  return cpu_count;
+}
+
 int os::active_processor_count() {
-  // Linux doesn't yet have a (official) notion of processor sets,
-  // so just return the number of online processors.
-  int online_cpus = ::sysconf(_SC_NPROCESSORS_ONLN);
-  assert(online_cpus > 0 && online_cpus <= processor_count(), "sanity check");
-  return online_cpus;
+  // User has overridden the number of active processors
+  if (ActiveProcessorCount > 0) {
+    return (int) ActiveProcessorCount;
+  }
+
+  if (OSContainer::is_containerized()) {
+    return OSContainer::active_processor_count();
+  }
+  return os::Linux::active_processor_count();
 }
 
 void os::set_native_thread_name(const char *name) {
@@ -5499,7 +5555,9 @@ void os::PlatformEvent::park() {       // AKA "down()"
     if (Atomic::cmpxchg(v-1, &_Event, v) == v) break;
   }
   guarantee(v >= 0, "invariant");
-  if (v == 0) {
+  if (v == 0 && os::Linux::use_futex()) {
+    futex_park();
+  } else if (v == 0) {
     // Do this the hard way by blocking ...
     int status = pthread_mutex_lock(_mutex);
     assert_status(status == 0, status, "mutex_lock");
@@ -5540,6 +5598,10 @@ int os::PlatformEvent::park(jlong millis) {
   guarantee(v >= 0, "invariant");
   if (v != 0) return OS_OK;
 
+  if (os::Linux::use_futex()) {
+    return futex_park(millis);
+  }
+
   // We do this the hard way, by blocking the thread.
   // Consider enforcing a minimum timeout value.
   struct timespec abst;
@@ -5608,6 +5670,13 @@ void os::PlatformEvent::unpark() {
 
   if (Atomic::xchg(1, &_Event) >= 0) return;
 
+  if (os::Linux::use_futex()) {
+    // The owner is blocked or about to block on _Event.  Events are
+    // immortal, so a wakeup that arrives after it has left is harmless.
+    os::Linux::futex_wake(&_Event);
+    return;
+  }
+
   // Wait for the thread associated with the event to vacate
   int status = pthread_mutex_lock(_mutex);
   assert_status(status == 0, status, "mutex_lock");
@@ -5632,6 +5701,104 @@ void os::PlatformEvent::unpark() {
   }
 }
 
+// futex(2) based parking
+// -------------------------------------------------------
+//
+// With UseFutexParking the PlatformEvent and Parker state words are
+// themselves the futex: park() blocks while the word says "parked" and
+// unpark() issues a FUTEX_WAKE only when it finds the owner parked, so
+// an available permit never costs a syscall and a handoff never needs
+// the pthread mutex.  Private futexes and FUTEX_CLOCK_REALTIME absolute
+// waits need 2.6.29; on older kernels we stay with the condvar paths.
+
+#ifndef FUTEX_PRIVATE_FLAG
+  #define FUTEX_PRIVATE_FLAG 128
+#endif
+#ifndef FUTEX_CLOCK_REALTIME
+  #define FUTEX_CLOCK_REALTIME 256
+#endif
+#ifndef FUTEX_WAIT_BITSET
+  #define FUTEX_WAIT_BITSET 9
+#endif
+#ifndef FUTEX_BITSET_MATCH_ANY
+  #define FUTEX_BITSET_MATCH_ANY 0xffffffff
+#endif
+
+#define sys_futex(addr, op, val, timeout, val3) \
+  ::syscall(SYS_futex, addr, (op) | FUTEX_PRIVATE_FLAG, val, timeout, NULL, val3)
+
+void os::Linux::futex_init() {
+  if (!UseFutexParking) {
+    return;
+  }
+  // Probe the operations we use: a wake with no waiters and an absolute
+  // wait on a value that does not match, which fails with EAGAIN.
+  volatile int word = 0;
+  struct timespec ts = { 0, 0 };
+  if (sys_futex(&word, FUTEX_WAKE, 1, NULL, 0) < 0 ||
+      (sys_futex(&word, FUTEX_WAIT_BITSET | FUTEX_CLOCK_REALTIME, 1, &ts,
+                 FUTEX_BITSET_MATCH_ANY) < 0 && errno != EAGAIN)) {
+    if (!FLAG_IS_DEFAULT(UseFutexParking)) {
+      warning("futex(2) is not usable on this kernel; ignoring UseFutexParking");
+    }
+    FLAG_SET_DEFAULT(UseFutexParking, false);
+    return;
+  }
+  _use_futex = true;
+}
+
+int os::Linux::futex_wait(volatile int* addr, int expected,
+                          const struct timespec* timeout, bool is_absolute) {
+  int ret;
+  if (is_absolute) {
+    ret = sys_futex(addr, FUTEX_WAIT_BITSET | FUTEX_CLOCK_REALTIME, expected,
+                    timeout, FUTEX_BITSET_MATCH_ANY);
+  } else {
+    ret = sys_futex(addr, FUTEX_WAIT, expected, timeout, 0);
+  }
+  return ret == 0 ? 0 : errno;
+}
+
+void os::Linux::futex_wake(volatile int* addr) {
+  int ret = sys_futex(addr, FUTEX_WAKE, 1, NULL, 0);
+  assert(ret >= 0, "futex_wake");
+}
+
+void os::PlatformEvent::futex_park() {
+  // _Event is -1 while we are parked; unpark() sets it to 0 or 1
+  while (_Event < 0) {
+    int status = os::Linux::futex_wait(&_Event, -1, NULL, false);
+    assert_status(status == 0 || status == EINTR || status == EAGAIN,
+                  status, "futex_wait");
+  }
+  Atomic::xchg(0, &_Event);
+}
+
+int os::PlatformEvent::futex_park(jlong millis) {
+  if (millis < 0) millis = 0;
+  if (millis > (jlong) MAX_SECS * MILLIUNITS) {
+    millis = (jlong) MAX_SECS * MILLIUNITS;
+  }
+  const jlong deadline = os::javaTimeNanos() + millis * NANOSECS_PER_MILLISEC;
+
+  // See the comments in park(jlong) on notification, timeout, interrupt
+  // and FilterSpuriousWakeups.
+  while (_Event < 0) {
+    jlong remaining = deadline - os::javaTimeNanos();
+    if (remaining <= 0) break;
+    struct timespec ts;
+    ts.tv_sec  = remaining / NANOSECS_PER_SEC;
+    ts.tv_nsec = remaining % NANOSECS_PER_SEC;
+    int status = os::Linux::futex_wait(&_Event, -1, &ts, false);
+    assert_status(status == 0 || status == EINTR || status == EAGAIN ||
+                  status == ETIMEDOUT, status, "futex_wait");
+    if (!FilterSpuriousWakeups) break;                 // previous semantics
+    if (status == ETIMEDOUT) break;
+  }
+  // Consume a racing unpark() atomically so it is reported as OS_OK
+  return Atomic::xchg(0, &_Event) >= 0 ? OS_OK : OS_TIMEOUT;
+}
+
 
 // JSR166
 // -------------------------------------------------------
@@ -5746,7 +5913,16 @@ void Parker::park(bool isAbsolute, jlong time) {
     return;
   }
   if (time > 0) {
-    unpackTime(&absTime, isAbsolute, time);
+    if (os::Linux::use_futex()) {
+      // futex waits take the timeout as given: absolute (CLOCK_REALTIME)
+      // or relative (CLOCK_MONOTONIC)
+      jlong units = isAbsolute ? MILLIUNITS : NANOUNITS;
+      jlong secs = time / units;
+      absTime.tv_sec  = isAbsolute ? secs : MIN2(secs, (jlong) MAX_SECS);
+      absTime.tv_nsec = (time % units) * (NANOUNITS / units);
+    } else {
+      unpackTime(&absTime, isAbsolute, time);
+    }
   }
 
 
@@ -5758,6 +5934,33 @@ void Parker::park(bool isAbsolute, jlong time) {
   // the ThreadBlockInVM() CTOR and DTOR may grab Threads_lock.
   ThreadBlockInVM tbivm(jt);
 
+  if (os::Linux::use_futex()) {
+    // _counter: 1 - permit available, 0 - none, -1 - parked
+    if (Thread::is_interrupted(thread, false)) {
+      return;
+    }
+    if (Atomic::cmpxchg(-1, &_counter, 0) == 0) {
+      OSThreadWaitState osts(thread->osthread(), false /* not Object.wait() */);
+      jt->set_suspend_equivalent();
+      // cleared by handle_special_suspend_equivalent_condition() or java_suspend_self()
+
+      // A single wait: park() is allowed to return spuriously
+      int status = os::Linux::futex_wait(&_counter, -1, time == 0 ? NULL : &absTime,
+                                         isAbsolute);
+      assert_status(status == 0 || status == EINTR || status == EAGAIN ||
+                    status == ETIMEDOUT, status, "futex_wait");
+    }
+    // Consume the permit or leave the parked state.  The full barrier
+    // orders this with Java-level accesses like the fence below.
+    Atomic::xchg(0, &_counter);
+
+    // If externally suspended while waiting, re-suspend
+    if (jt->handle_special_suspend_equivalent_condition()) {
+      jt->java_suspend_self();
+    }
+    return;
+  }
+
   // Don't wait if cannot get lock since interference arises from
   // unblocking.  Also. check interrupt before trying wait
   if (Thread::is_interrupted(thread, false) || pthread_mutex_trylock(_mutex) != 0) {
@@ -5822,6 +6025,14 @@ void Parker::park(bool isAbsolute, jlong time) {
 }
 
 void Parker::unpark() {
+  if (os::Linux::use_futex()) {
+    if (Atomic::xchg(1, &_counter) < 0) {
+      // thread is parked, or about to be
+      os::Linux::futex_wake(&_counter);
+    }
+    return;
+  }
+
   int status = pthread_mutex_lock(_mutex);
   assert(status == 0, "invariant");
   const int s = _counter;
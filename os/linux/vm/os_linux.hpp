@@ -137,6 +137,9 @@ class Linux {
   static uintptr_t initial_thread_stack_size(void)                  { return _initial_thread_stack_size; }
   static bool is_initial_thread(void);
 
+  // CPUs in the process' affinity mask (which honours cpusets)
+  static int active_processor_count();
+
   static int page_size(void)                                        { return _page_size; }
   static void set_page_size(int val)                                { _page_size = val; }
 
@@ -236,6 +239,19 @@ class Linux {
   // LinuxThreads work-around for 6292965
   static int safe_cond_timedwait(pthread_cond_t *_cond, pthread_mutex_t *_mutex, const struct timespec *_abstime);
 
+  // futex(2) support for PlatformEvent and Parker (UseFutexParking)
+ private:
+  static bool _use_futex;
+
+ public:
+  static bool use_futex()                     { return _use_futex; }
+  static void futex_init();
+  // Returns 0 or an errno value; a NULL timeout waits forever, an
+  // absolute timeout is measured against CLOCK_REALTIME
+  static int  futex_wait(volatile int* addr, int expected,
+                         const struct timespec* timeout, bool is_absolute);
+  static void futex_wake(volatile int* addr);
+
  private:
   typedef int (*sched_getcpu_func_t)(void);
   typedef int (*numa_node_to_cpus_func_t)(int node, unsigned long *buffer, int bufferlen);
@@ -297,6 +313,10 @@ class PlatformEvent : public CHeapObj<mtInternal> {
   double PostPad[2];
   Thread * _Assoc;
 
+  // UseFutexParking: block on _Event itself
+  void futex_park();
+  int  futex_park(jlong millis);
+
  public:       // TODO-FIXME: make dtor private
   ~PlatformEvent() { guarantee(0, "invariant"); }
 
@@ -178,8 +178,19 @@ class java_lang_String : AllStatic {
   // hash P(31) from Kernighan & Ritchie
   //
   // For this reason, THIS ALGORITHM MUST MATCH String.hashCode().
+  //
+  // The main loop folds four elements per step using the powers of 31
+  // (31^2 = 961, 31^3 = 29791, 31^4 = 923521). This gives the same result
+  // as the one element loop, but the multiplications of a step no longer
+  // depend on each other.
   template <typename T> static unsigned int hash_code(T* s, int len) {
     unsigned int h = 0;
+    while (len >= 4) {
+      h = 923521*h + 29791*(unsigned int) s[0] + 961*(unsigned int) s[1] +
+          31*(unsigned int) s[2] + (unsigned int) s[3];
+      s += 4;
+      len -= 4;
+    }
     while (len-- > 0) {
       h = 31*h + (unsigned int) *s;
       s++;
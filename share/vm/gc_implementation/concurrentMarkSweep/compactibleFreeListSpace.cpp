@@ -32,6 +32,7 @@
 #include "gc_interface/collectedHeap.inline.hpp"
 #include "memory/allocation.inline.hpp"
 #include "memory/blockOffsetTable.inline.hpp"
+#include "memory/genCollectedHeap.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/space.inline.hpp"
 #include "memory/universe.inline.hpp"
@@ -43,6 +44,7 @@
 #include "runtime/orderAccess.inline.hpp"
 #include "runtime/vmThread.hpp"
 #include "utilities/copy.hpp"
+#include "utilities/workgroup.hpp"
 
 /////////////////////////////////////////////////////////////////////////
 //// CompactibleFreeListSpace
@@ -93,7 +95,14 @@ CompactibleFreeListSpace::CompactibleFreeListSpace(BlockOffsetSharedArray* bs,
   _marking_task_size(CardTableModRefBS::card_size_in_words * BitsPerWord *
                     CMSConcMarkMultiple),
   _collector(NULL),
-  _preconsumptionDirtyCardClosure(NULL)
+  _preconsumptionDirtyCardClosure(NULL),
+  _compaction_section_start(NULL),
+  _compaction_section_top(NULL),
+  _n_compaction_sections(0),
+  _max_compaction_sections(0),
+  _compaction_section_words(0),
+  _next_compaction_section(NULL),
+  _compacted_in_sections(false)
 {
   assert(sizeof(FreeChunk) / BytesPerWord <= MinChunkSize,
          "FreeChunk is larger than expected");
@@ -292,7 +301,9 @@ void CompactibleFreeListSpace::reset(MemRegion mr) {
 }
 
 void CompactibleFreeListSpace::reset_after_compaction() {
-  // Reset the space to the new reality - one free chunk.
+  // Reset the space to the new reality - one free chunk, plus one free
+  // chunk at the top of each section but the last if it was compacted
+  // in sections.
   MemRegion mr(compaction_top(), end());
   reset(mr);
   // Now refill the linear allocation block(s) if possible.
@@ -312,6 +323,17 @@ void CompactibleFreeListSpace::reset_after_compaction() {
       // Note that _unallocated_block is not updated here.
     }
   }
+  // The gaps are added last so that the linAB above is carved out of
+  // the chunk at the top of the space.
+  for (uint i = 0; i + 1 < _n_compaction_sections; i++) {
+    HeapWord* gap = _compaction_section_top[i];
+    size_t gap_size = pointer_delta(_compaction_section_start[i + 1], gap);
+    if (gap_size > 0) {
+      assert(gap_size >= MinChunkSize, "Chunk size is too small");
+      addChunkAndRepairOffsetTable(gap, gap_size, true /* coalesced */);
+      coalBirth(gap_size);
+    }
+  }
 }
 
 // Walks the entire dictionary, returning a coterminal
@@ -2086,6 +2108,7 @@ bool CompactibleFreeListSpace::should_concurrent_collect() const {
 
 // Support for compaction
 void CompactibleFreeListSpace::prepare_for_compaction(CompactPoint* cp) {
+  setup_compaction_sections(cp);
   scan_and_forward(this, cp);
   // Prepare_for_compaction() uses the space between live objects
   // so that later phase can skip dead space quickly.  So verification
@@ -2099,12 +2122,133 @@ void CompactibleFreeListSpace::adjust_pointers() {
   // Cannot test used() == 0 here because the free lists have already
   // been mangled by the compaction.
 
-  scan_and_adjust_pointers(this);
+  if (_n_compaction_sections > 1) {
+    par_work_on_compaction_sections(true /* adjust */);
+  } else {
+    scan_and_adjust_pointers(this);
+  }
   // See note about verification in prepare_for_compaction().
 }
 
 void CompactibleFreeListSpace::compact() {
-  scan_and_compact(this);
+  _compacted_in_sections = _n_compaction_sections > 1;
+  if (_compacted_in_sections) {
+    par_work_on_compaction_sections(false /* adjust */);
+    reset_after_scan_and_compact(this);
+  } else {
+    scan_and_compact(this);
+  }
+  release_compaction_sections();
+}
+
+// Sectioned compaction is only used when the space compacts into itself,
+// which is the case for the CMS generation, the first space compacted in
+// a full collection. A section only starts at a free region that lies at
+// least _compaction_section_words above the start of the previous one, so
+// the space is split into at most _max_compaction_sections sections.
+void CompactibleFreeListSpace::setup_compaction_sections(CompactPoint* cp) {
+  release_compaction_sections();
+  _next_compaction_section = end();
+  _compacted_in_sections = false;
+
+  FlexibleWorkGang* workers = GenCollectedHeap::heap()->workers();
+  if (!CMSParallelFullGC || workers == NULL || workers->active_workers() <= 1 ||
+      (cp->space != NULL && cp->space != this)) {
+    return;
+  }
+  // Use a few sections per worker to even out the load.
+  _max_compaction_sections = workers->active_workers() * 4;
+  _compaction_section_words =
+    MAX2(pointer_delta(end(), bottom()) / _max_compaction_sections, MinChunkSize);
+  _compaction_section_start = NEW_C_HEAP_ARRAY(HeapWord*, _max_compaction_sections, mtGC);
+  _compaction_section_top   = NEW_C_HEAP_ARRAY(HeapWord*, _max_compaction_sections, mtGC);
+  _compaction_section_start[0] = bottom();
+  _n_compaction_sections = 1;
+  _next_compaction_section = bottom() + _compaction_section_words;
+}
+
+// Called by scan_and_forward() at the start "q" of a free region at or
+// above _next_compaction_section. The free region becomes the start of a
+// new section, whose live objects are forwarded to "q" onwards.
+HeapWord* CompactibleFreeListSpace::start_compaction_section(HeapWord* q,
+                                                             HeapWord* compact_top) {
+  assert(_n_compaction_sections > 0 &&
+         _n_compaction_sections < _max_compaction_sections,
+         "sections not set up");
+  assert(compact_top <= q, "objects only slide down");
+  _compaction_section_top[_n_compaction_sections - 1] = compact_top;
+  _compaction_section_start[_n_compaction_sections] = q;
+  _n_compaction_sections++;
+  if (_n_compaction_sections < _max_compaction_sections &&
+      pointer_delta(end(), q) > _compaction_section_words) {
+    _next_compaction_section = q + _compaction_section_words;
+  } else {
+    _next_compaction_section = end();
+  }
+  return q;
+}
+
+// The end of the objects to be adjusted and compacted in section "i".
+HeapWord* CompactibleFreeListSpace::compaction_section_limit(uint i) const {
+  if (i + 1 < _n_compaction_sections) {
+    return MIN2(_compaction_section_start[i + 1], _end_of_live);
+  }
+  return _end_of_live;
+}
+
+class CFLSCompactSectionsTask: public AbstractGangTask {
+  CompactibleFreeListSpace* _sp;
+  bool                      _adjust;
+  SequentialSubTasksDone    _seq_tasks;
+
+ public:
+  CFLSCompactSectionsTask(CompactibleFreeListSpace* sp, bool adjust, uint n_workers) :
+    AbstractGangTask(adjust ? "CMS parallel adjust pointers" : "CMS parallel compaction"),
+    _sp(sp), _adjust(adjust) {
+    _seq_tasks.set_n_tasks(sp->_n_compaction_sections);
+    _seq_tasks.set_n_threads(n_workers);
+  }
+
+  void work(uint worker_id) {
+    uint i = 0;
+    while (!_seq_tasks.is_task_claimed(/* reference */ i)) {
+      HeapWord* start = _sp->_compaction_section_start[i];
+      HeapWord* limit = _sp->compaction_section_limit(i);
+      if (start >= limit) {
+        continue;
+      }
+      if (_adjust) {
+        CompactibleSpace::scan_and_adjust_pointers_range(_sp, start, limit);
+      } else {
+        CompactibleSpace::scan_and_compact_range(_sp, start, limit);
+      }
+    }
+    _seq_tasks.all_tasks_completed();
+  }
+};
+
+// Objects never move across section boundaries, so each section is
+// adjusted (phase 3) or compacted (phase 4) by a single worker.
+void CompactibleFreeListSpace::par_work_on_compaction_sections(bool adjust) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at a safepoint");
+  GenCollectedHeap* gch = GenCollectedHeap::heap();
+  FlexibleWorkGang* workers = gch->workers();
+  uint n_workers = workers->active_workers();
+  CFLSCompactSectionsTask tsk(this, adjust, n_workers);
+  gch->set_par_threads(n_workers);
+  workers->run_task(&tsk);
+  gch->set_par_threads(0);
+}
+
+void CompactibleFreeListSpace::release_compaction_sections() {
+  if (_compaction_section_start != NULL) {
+    FREE_C_HEAP_ARRAY(HeapWord*, _compaction_section_start);
+    FREE_C_HEAP_ARRAY(HeapWord*, _compaction_section_top);
+    _compaction_section_start = NULL;
+    _compaction_section_top = NULL;
+  }
+  _n_compaction_sections = 0;
+  _max_compaction_sections = 0;
 }
 
 // Fragmentation metric = 1 - [sum of (fbs**2) / (sum of fbs)**2]
@@ -2215,6 +2359,18 @@ bool CompactibleFreeListSpace::coalOverPopulated(size_t size) {
   }
 }
 
+// The census of the indexed free lists is read racily since it is
+// only used as a coalescing heuristic, but the dictionary must not
+// be walked while other parallel sweepers may be modifying it.
+bool CompactibleFreeListSpace::par_coalOverPopulated(size_t size) {
+  if (size < SmallForDictionary) {
+    return coalOverPopulated(size);
+  }
+  MutexLockerEx x(parDictionaryAllocLock(),
+                  Mutex::_no_safepoint_check_flag);
+  return dictionary()->coal_dict_over_populated(size);
+}
+
 void CompactibleFreeListSpace::smallCoalBirth(size_t size) {
   assert(size < SmallForDictionary, "Size too large for indexed list");
   AdaptiveFreeList<FreeChunk> *fl = &_indexedFreeList[size];
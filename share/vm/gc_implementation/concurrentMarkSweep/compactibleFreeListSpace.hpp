@@ -73,6 +73,8 @@ class CompactibleFreeListSpace: public CompactibleSpace {
   friend class CMSCollector;
   // Local alloc buffer for promotion into this space.
   friend class CFLS_LAB;
+  // Parallel sweepers synchronize on the par promotion locks.
+  friend class SweepClosure;
   // Allow scan_and_* functions to call (private) overrides of the auxiliary functions on this class
   template <typename SpaceType>
   friend void CompactibleSpace::scan_and_adjust_pointers(SpaceType* space);
@@ -80,6 +82,12 @@ class CompactibleFreeListSpace: public CompactibleSpace {
   friend void CompactibleSpace::scan_and_compact(SpaceType* space);
   template <typename SpaceType>
   friend void CompactibleSpace::scan_and_forward(SpaceType* space, CompactPoint* cp);
+  template <typename SpaceType>
+  friend void CompactibleSpace::scan_and_adjust_pointers_range(SpaceType* space, HeapWord* q, HeapWord* t);
+  template <typename SpaceType>
+  friend void CompactibleSpace::scan_and_compact_range(SpaceType* space, HeapWord* q, HeapWord* t);
+  // Adjusts and compacts the sections of this space in parallel.
+  friend class CFLSCompactSectionsTask;
 
   // "Size" of chunks of work (executed during parallel remark phases
   // of CMS collection); this probably belongs in CMSCollector, although
@@ -158,6 +166,22 @@ class CompactibleFreeListSpace: public CompactibleSpace {
   // Used to make the young collector update the mod union table
   MemRegionClosure* _preconsumptionDirtyCardClosure;
 
+  // Support for parallel full collections (CMSParallelFullGC): the space
+  // is forwarded as a number of sections, each of which starts with a free
+  // region into which the live objects of the section are slid down.  The
+  // sections can then be adjusted and compacted independently of each
+  // other.  Section i starts at _compaction_section_start[i]; the free
+  // space between _compaction_section_top[i] and the start of section i+1
+  // is returned to the free lists after compaction.  Section 0 starts at
+  // bottom(), and the top of the last section is compaction_top().
+  HeapWord** _compaction_section_start;
+  HeapWord** _compaction_section_top;
+  uint       _n_compaction_sections;
+  uint       _max_compaction_sections;
+  size_t     _compaction_section_words;  // Minimum distance between section starts
+  HeapWord*  _next_compaction_section;   // No section starts below this
+  bool       _compacted_in_sections;     // Last compaction used the sections
+
   // Support for compacting cms
   HeapWord* cross_threshold(HeapWord* start, HeapWord* end);
   HeapWord* forward(oop q, size_t size, CompactPoint* cp, HeapWord* compact_top);
@@ -165,9 +189,10 @@ class CompactibleFreeListSpace: public CompactibleSpace {
   // Initialization helpers.
   void initializeIndexedFreeListArray();
 
-  // Extra stuff to manage promotion parallelism.
+  // Extra stuff to manage promotion (and sweeping) parallelism.
 
-  // A lock protecting the dictionary during par promotion allocation.
+  // A lock protecting the dictionary during par promotion allocation
+  // and the free lists during parallel sweeping.
   mutable Mutex _parDictionaryAllocLock;
   Mutex* parDictionaryAllocLock() const { return &_parDictionaryAllocLock; }
 
@@ -320,6 +345,20 @@ class CompactibleFreeListSpace: public CompactibleSpace {
     return adjustObjectSize(oop(addr)->size());
   }
 
+  inline HeapWord* begin_compaction_section(HeapWord* q, HeapWord* compact_top) {
+    if (q < _next_compaction_section) {
+      return compact_top;
+    }
+    return start_compaction_section(q, compact_top);
+  }
+
+  // Support for sectioned compaction; see _compaction_section_start.
+  void      setup_compaction_sections(CompactPoint* cp);
+  HeapWord* start_compaction_section(HeapWord* q, HeapWord* compact_top);
+  HeapWord* compaction_section_limit(uint i) const;
+  void      par_work_on_compaction_sections(bool adjust);
+  void      release_compaction_sections();
+
  protected:
   // Reset the indexed free list to its initial empty condition.
   void resetIndexedFreeListArray();
@@ -536,6 +575,9 @@ class CompactibleFreeListSpace: public CompactibleSpace {
   void prepare_for_compaction(CompactPoint* cp);
   void adjust_pointers();
   void compact();
+  // True if the last compaction of the space was done in parallel
+  // sections, each of which leaves a free chunk at its top.
+  bool compacted_in_sections() const { return _compacted_in_sections; }
   // Reset the space to reflect the fact that a compaction of the
   // space has been done.
   virtual void reset_after_compaction();
@@ -598,6 +640,8 @@ class CompactibleFreeListSpace: public CompactibleSpace {
   // Return true if the count of free chunks is greater
   // than the desired number of free chunks.
   bool coalOverPopulated(size_t size);
+  // As above, but safe to call from parallel sweepers.
+  bool par_coalOverPopulated(size_t size);
 
 // Record (for each size):
 //
@@ -29,6 +29,7 @@
 #include "code/codeCache.hpp"
 #include "gc_implementation/shared/adaptiveSizePolicy.hpp"
 #include "gc_implementation/concurrentMarkSweep/cmsCollectorPolicy.hpp"
+#include "gc_implementation/concurrentMarkSweep/cmsLockVerifier.hpp"
 #include "gc_implementation/concurrentMarkSweep/cmsOopClosures.inline.hpp"
 #include "gc_implementation/concurrentMarkSweep/compactibleFreeListSpace.hpp"
 #include "gc_implementation/concurrentMarkSweep/concurrentMarkSweepGeneration.inline.hpp"
@@ -1718,7 +1719,10 @@ void CMSCollector::do_compaction_work(bool clear_all_soft_refs) {
   GenMarkSweep::invoke_at_safepoint(_cmsGen->level(),
     ref_processor(), clear_all_soft_refs);
   #ifdef ASSERT
-    CompactibleFreeListSpace* cms_space = _cmsGen->cmsSpace();
+  // A compaction done in parallel sections leaves a free chunk at the
+  // top of each section.
+  CompactibleFreeListSpace* cms_space = _cmsGen->cmsSpace();
+  if (!cms_space->compacted_in_sections()) {
     size_t free_size = cms_space->free();
     assert(free_size ==
            pointer_delta(cms_space->end(), cms_space->compaction_top())
@@ -1732,6 +1736,7 @@ void CMSCollector::do_compaction_work(bool clear_all_soft_refs) {
     assert((free_size == 0 && num == 0) ||
            (free_size > 0  && (num == 1 || num == 2)),
          "There should be at most 2 free chunks after compaction");
+  }
   #endif // ASSERT
   _collectorState = Resetting;
   assert(_restart_addr == NULL,
@@ -5325,7 +5330,7 @@ public:
                       CMSCollector*    collector,
                       const MemRegion& span,
                       CMSBitMap*       mark_bit_map,
-                      AbstractWorkGang* workers,
+                      uint             n_workers,
                       OopTaskQueueSet* task_queues):
     // XXX Should superclass AGTWOQ also know about AWG since it knows
     // about the task_queues used by the AWG? Then it could initialize
@@ -5338,7 +5343,7 @@ public:
   {
     assert(_collector->_span.equals(_span) && !_span.is_empty(),
            "Inconsistency in _span");
-    set_for_termination(workers->active_workers());
+    set_for_termination(n_workers);
   }
 
   OopTaskQueueSet* task_queues() { return queues(); }
@@ -5450,16 +5455,17 @@ void CMSRefProcTaskProxy::do_work_steal(int i,
   )
 }
 
-void CMSRefProcTaskExecutor::execute(ProcessTask& task)
+void CMSRefProcTaskExecutor::execute(ProcessTask& task, uint ergo_workers)
 {
   GenCollectedHeap* gch = GenCollectedHeap::heap();
   FlexibleWorkGang* workers = gch->workers();
   assert(workers != NULL, "Need parallel worker threads.");
+  uint n_workers = MIN2(ergo_workers, workers->active_workers());
   CMSRefProcTaskProxy rp_task(task, &_collector,
                               _collector.ref_processor()->span(),
                               _collector.markBitMap(),
-                              workers, _collector.task_queues());
-  workers->run_task(&rp_task);
+                              n_workers, _collector.task_queues());
+  workers->run_task(&rp_task, n_workers);
 }
 
 void CMSRefProcTaskExecutor::execute(EnqueueTask& task)
@@ -5604,6 +5610,223 @@ void CMSCollector::check_correct_thread_executing() {
 }
 #endif
 
+// MT Concurrent Sweeping Task
+//
+// The part of the space below the sweep limit is divided into chunks,
+// each starting at a block boundary, which are claimed and swept by
+// the concurrent GC threads. A block belongs to the chunk in which it
+// starts, so no block is swept twice and free runs never extend past a
+// chunk's end. Each worker buffers the chunks it frees and merges them
+// into the shared free lists under the space's parDictionaryAllocLock,
+// while the CMS thread holds the free list and bit map locks on behalf
+// of the gang (giving them up only while the gang yields). Free runs
+// that straddle chunk boundaries are coalesced by the CMS thread once
+// the workers are done.
+class CMSParSweepTask: public YieldingFlexibleGangTask {
+  CMSCollector*                  _collector;
+  ConcurrentMarkSweepGeneration* _gen;
+  CompactibleFreeListSpace*      _sp;
+
+  // _chunk_starts[i] is the start of the i-th chunk, and
+  // _chunk_starts[_n_chunks] is the sweep limit.
+  HeapWord**                     _chunk_starts;
+  // The free chunk, if any, ending at the end of the i-th chunk.
+  HeapWord**                     _trailing_free;
+  uint                           _n_chunks;
+  SequentialSubTasksDone         _seq_tasks;
+
+  //  Exposed here for yielding support
+  Mutex* const                   _freelist_lock;
+  Mutex* const                   _bit_map_lock;
+
+  // Each worker gets a few chunks for some load balancing, but chunks
+  // are kept large since every boundary may split a free run that must
+  // then be coalesced by the CMS thread at the end of the sweep.
+  enum {
+    ChunksPerWorker = 4,
+    MinChunkWords   = 64 * K
+  };
+
+ public:
+  CMSParSweepTask(CMSCollector* collector,
+                  ConcurrentMarkSweepGeneration* gen,
+                  uint n_workers);
+  ~CMSParSweepTask();
+
+  virtual void set_for_termination(int active_workers) {
+    _seq_tasks.set_n_threads(active_workers);
+  }
+
+  void work(uint worker_id);
+  bool should_yield() {
+    return    ConcurrentMarkSweepThread::should_yield()
+           && !_collector->foregroundGCIsActive();
+  }
+
+  virtual void coordinator_yield();  // stuff done by coordinator
+
+  // Coalesce free runs split by chunk boundaries; returns the
+  // number of boundaries coalesced across.
+  uint coalesce_chunk_boundaries();
+};
+
+CMSParSweepTask::CMSParSweepTask(CMSCollector* collector,
+                                 ConcurrentMarkSweepGeneration* gen,
+                                 uint n_workers) :
+  YieldingFlexibleGangTask("Concurrent sweeping done multi-threaded"),
+  _collector(collector),
+  _gen(gen),
+  _sp(gen->cmsSpace()),
+  _freelist_lock(gen->freelistLock()),
+  _bit_map_lock(collector->bitMapLock())
+{
+  assert_lock_strong(_freelist_lock);
+  assert_lock_strong(_bit_map_lock);
+  assert(n_workers > 0, "Unexpected n_workers argument");
+  HeapWord* const bottom = _sp->bottom();
+  HeapWord* const limit  = _sp->sweep_limit();
+  const uint max_chunks  = n_workers * ChunksPerWorker;
+  size_t chunk_size = pointer_delta(limit, bottom) / max_chunks;
+  chunk_size = align_size_up(MAX2(chunk_size, (size_t)MinChunkWords),
+                             CardTableModRefBS::card_size_in_words);
+
+  _chunk_starts  = NEW_C_HEAP_ARRAY(HeapWord*, max_chunks + 1, mtGC);
+  _trailing_free = NEW_C_HEAP_ARRAY(HeapWord*, max_chunks, mtGC);
+
+  uint n = 0;
+  _chunk_starts[n++] = bottom;
+  for (HeapWord* boundary = bottom + chunk_size;
+       boundary < limit && n < max_chunks;
+       boundary += chunk_size) {
+    // Find the first block starting at or above the (card aligned)
+    // boundary. Since we hold the free list lock, blocks cannot be
+    // carved up under us, and blocks that are allocated but not yet
+    // initialized carry Printezis marks giving their size.
+    HeapWord* blk = _sp->block_start_careful(boundary);
+    while (blk < boundary) {
+      size_t sz = _sp->block_size_no_stall(blk, collector);
+      assert(sz > 0, "Should always be able to compute a size");
+      if (sz == 0) {
+        break;
+      }
+      blk += sz;
+    }
+    // If no new block starts in this chunk (or we could not tell),
+    // the previous chunk simply extends over it.
+    if (blk >= boundary && blk < limit && blk > _chunk_starts[n - 1]) {
+      _chunk_starts[n++] = blk;
+    }
+  }
+  _chunk_starts[n] = limit;
+  _n_chunks = n;
+  _seq_tasks.set_n_tasks(_n_chunks);
+  _seq_tasks.set_n_threads(n_workers);
+}
+
+CMSParSweepTask::~CMSParSweepTask() {
+  FREE_C_HEAP_ARRAY(HeapWord*, _chunk_starts);
+  FREE_C_HEAP_ARRAY(HeapWord*, _trailing_free);
+}
+
+void CMSParSweepTask::work(uint worker_id) {
+  elapsedTimer _timer;
+  _timer.start();
+  uint nth_task = 0;
+  while (!_seq_tasks.is_task_claimed(/* reference */ nth_task)) {
+    HeapWord* const start = _chunk_starts[nth_task];
+    HeapWord* const end   = _chunk_starts[nth_task + 1];
+    _trailing_free[nth_task] = NULL;
+    if (start < end) {
+      SweepClosure cl(_collector, _gen, &_collector->_markBitMap,
+                      this, MemRegion(start, end));
+      // As in CompactibleFreeListSpace::blk_iterate_careful(); the
+      // closure steps us to the end of the space once it is done.
+      HeapWord *cur, *limit;
+      for (cur = start, limit = _sp->end(); cur < limit;
+           cur += cl.do_blk_careful(cur));
+      _trailing_free[nth_task] = cl.trailing_free_chunk();
+    }
+  }
+  _seq_tasks.all_tasks_completed();
+  _timer.stop();
+  if (PrintCMSStatistics != 0) {
+    gclog_or_tty->print_cr("Finished sweeping in %dth thread: %3.3f sec",
+      worker_id, _timer.seconds());
+  }
+}
+
+void CMSParSweepTask::coordinator_yield() {
+  assert(ConcurrentMarkSweepThread::cms_thread_has_cms_token(),
+         "CMS thread should hold CMS token");
+  // First give up the locks, then yield, then re-lock;
+  // see the comments in CMSConcMarkingTask::coordinator_yield().
+  assert_lock_strong(_bit_map_lock);
+  assert_lock_strong(_freelist_lock);
+  _bit_map_lock->unlock();
+  _freelist_lock->unlock();
+  ConcurrentMarkSweepThread::desynchronize(true);
+  _collector->stopTimer();
+  if (PrintCMSStatistics != 0) {
+    _collector->incrementYields();
+  }
+
+  for (unsigned i = 0; i < CMSCoordinatorYieldSleepCount &&
+                   ConcurrentMarkSweepThread::should_yield() &&
+                   !CMSCollector::foregroundGCIsActive(); ++i) {
+    os::sleep(Thread::current(), 1, false);
+  }
+
+  ConcurrentMarkSweepThread::synchronize(true);
+  _freelist_lock->lock();
+  _bit_map_lock->lock_without_safepoint_check();
+  _collector->startTimer();
+}
+
+uint CMSParSweepTask::coalesce_chunk_boundaries() {
+  assert(completed(), "Workers should be done");
+  assert_lock_strong(_freelist_lock);
+  if (FLSCoalescePolicy == 0) {  // never coalesce
+    return 0;
+  }
+  uint n_coalesced = 0;
+  HeapWord* left = NULL;  // free chunk ending at the start of chunk i
+  for (uint i = 0; i < _n_chunks; i++) {
+    HeapWord* const start = _chunk_starts[i];
+    if (start >= _chunk_starts[i + 1]) {
+      continue;
+    }
+    if (left != NULL) {
+      FreeChunk* const lc = (FreeChunk*)left;
+      FreeChunk* const rc = (FreeChunk*)start;
+      // Either chunk may have been allocated out of while the
+      // gang yielded, so check that both are still free.
+      if (lc->is_free() && !lc->cantCoalesce() &&
+          left + lc->size() == start &&
+          rc->is_free() && !rc->cantCoalesce()) {
+        const size_t left_size  = lc->size();
+        const size_t right_size = rc->size();
+        if (CMSTraceSweeper) {
+          gclog_or_tty->print_cr("Sweep: coalescing " PTR_FORMAT " (" SIZE_FORMAT ")"
+                                 " with " PTR_FORMAT " (" SIZE_FORMAT ")",
+                                 lc, left_size, rc, right_size);
+        }
+        _sp->coalDeath(left_size);
+        _sp->removeFreeChunkFromFreeLists(lc);
+        _sp->coalDeath(right_size);
+        _sp->removeFreeChunkFromFreeLists(rc);
+        _sp->coalBirth(left_size + right_size);
+        _sp->addChunkAndRepairOffsetTable(left, left_size + right_size, true);
+        if (_trailing_free[i] == start) {
+          _trailing_free[i] = left;
+        }
+        n_coalesced++;
+      }
+    }
+    left = _trailing_free[i];
+  }
+  return n_coalesced;
+}
+
 void CMSCollector::sweep() {
   assert(_collectorState == Sweeping, "just checking");
   check_correct_thread_executing();
@@ -5770,7 +5993,10 @@ void CMSCollector::sweepWork(ConcurrentMarkSweepGeneration* gen) {
                                       _intra_sweep_estimate.padded_average());
   gen->setNearLargestChunk();
 
-  {
+  if (CMSParallelSweepEnabled && CMSConcurrentMTEnabled && CMSYield &&
+      conc_workers() != NULL) {
+    do_sweeping_mt(gen);
+  } else {
     SweepClosure sweepClosure(this, gen, &_markBitMap, CMSYield);
     gen->cmsSpace()->blk_iterate_careful(&sweepClosure);
     // We need to free-up/coalesce garbage/blocks from a
@@ -5787,6 +6013,32 @@ void CMSCollector::sweepWork(ConcurrentMarkSweepGeneration* gen) {
   }
 }
 
+void CMSCollector::do_sweeping_mt(ConcurrentMarkSweepGeneration* gen) {
+  assert(CMSParallelSweepEnabled && conc_workers() != NULL, "precondition");
+  int num_workers = AdaptiveSizePolicy::calc_active_conc_workers(
+                                       conc_workers()->total_workers(),
+                                       conc_workers()->active_workers(),
+                                       Threads::number_of_non_daemon_threads());
+  conc_workers()->set_active_workers(num_workers);
+
+  NOT_PRODUCT(
+    gen->cmsSpace()->initializeIndexedFreeListArrayReturnedBytes();
+    gen->cmsSpace()->dictionary()->initialize_dict_returned_bytes();
+  )
+  CMSParSweepTask tsk(this, gen, num_workers);
+  conc_workers()->start_task(&tsk);
+  while (tsk.yielded()) {
+    tsk.coordinator_yield();
+    conc_workers()->continue_task(&tsk);
+  }
+  assert(tsk.completed(), "Inconsistency");
+  uint n_coalesced = tsk.coalesce_chunk_boundaries();
+  if (PrintCMSStatistics != 0) {
+    gclog_or_tty->print_cr(" (parallel sweep: %d workers, %u chunk boundaries coalesced) ",
+                           num_workers, n_coalesced);
+  }
+}
+
 // Reset CMS data structures (for now just the marking bit map)
 // preparatory for the next cycle.
 void CMSCollector::reset(bool concurrent) {
@@ -7364,7 +7616,12 @@ SweepClosure::SweepClosure(CMSCollector* collector,
   _inFreeRange(false),           // No free range at beginning of sweep
   _freeRangeInFreeLists(false),  // No free range at beginning of sweep
   _lastFreeRangeCoalesced(false),
-  _freeFinger(g->used_region().start())
+  _freeFinger(g->used_region().start()),
+  _task(NULL),
+  _parLock(NULL),
+  _numPending(0),
+  _lastFlushedChunk(NULL),
+  _lastFlushedEnd(NULL)
 {
   NOT_PRODUCT(
     _numObjectsFreed = 0;
@@ -7386,6 +7643,45 @@ SweepClosure::SweepClosure(CMSCollector* collector,
   }
 }
 
+SweepClosure::SweepClosure(CMSCollector* collector,
+                           ConcurrentMarkSweepGeneration* g,
+                           CMSBitMap* bitMap, CMSParSweepTask* task,
+                           MemRegion span) :
+  _collector(collector),
+  _g(g),
+  _sp(g->cmsSpace()),
+  _limit(span.end()),
+  _freelistLock(_sp->freelistLock()),
+  _bitMap(bitMap),
+  _yield(true),
+  _inFreeRange(false),
+  _freeRangeInFreeLists(false),
+  _lastFreeRangeCoalesced(false),
+  _freeFinger(span.start()),
+  _task(task),
+  _parLock(_sp->parDictionaryAllocLock()),
+  _numPending(0),
+  _lastFlushedChunk(NULL),
+  _lastFlushedEnd(NULL)
+{
+  NOT_PRODUCT(
+    _numObjectsFreed = 0;
+    _numWordsFreed   = 0;
+    _numObjectsLive = 0;
+    _numWordsLive = 0;
+    _numObjectsAlreadyFree = 0;
+    _numWordsAlreadyFree = 0;
+    _last_fc = NULL;
+  )
+  assert(task != NULL, "Use the serial constructor");
+  assert(_limit > span.start() && _limit <= _sp->sweep_limit(),
+         "sweep _limit out of bounds");
+  if (CMSTraceSweeper) {
+    gclog_or_tty->print_cr("Starting parallel sweep of [" PTR_FORMAT "," PTR_FORMAT ")",
+                           span.start(), _limit);
+  }
+}
+
 void SweepClosure::print_on(outputStream* st) const {
   tty->print_cr("_sp = [" PTR_FORMAT "," PTR_FORMAT ")",
                 _sp->bottom(), _sp->end());
@@ -7402,7 +7698,8 @@ void SweepClosure::print_on(outputStream* st) const {
 // you may need to review this code to see if it needs to be
 // enabled in product mode.
 SweepClosure::~SweepClosure() {
-  assert_lock_strong(_freelistLock);
+  // Parallel sweepers rely on the CMS thread holding the lock on their behalf.
+  CMSLockVerifier::assert_locked(_freelistLock);
   assert(_limit >= _sp->bottom() && _limit <= _sp->end(),
          "sweep _limit out of bounds");
   if (inFreeRange()) {
@@ -7410,7 +7707,8 @@ SweepClosure::~SweepClosure() {
     print();
     ShouldNotReachHere();
   }
-  if (Verbose && PrintGC) {
+  assert(_numPending == 0, "Pending chunks should have been merged");
+  if (Verbose && PrintGC && _task == NULL) {
     gclog_or_tty->print("Collected "SIZE_FORMAT" objects, " SIZE_FORMAT " bytes",
                         _numObjectsFreed, _numWordsFreed*sizeof(HeapWord));
     gclog_or_tty->print_cr("\nLive "SIZE_FORMAT" objects,  "
@@ -7457,7 +7755,7 @@ void SweepClosure::initialize_free_range(HeapWord* freeFinger,
       FreeChunk* fc = (FreeChunk*) freeFinger;
       assert(fc->is_free(), "A chunk on the free list should be free.");
       assert(fc->size() > 0, "Free range should have a size");
-      assert(_sp->verify_chunk_in_free_list(fc), "Chunk is not in free lists");
+      assert(verify_chunk_in_free_list(fc), "Chunk is not in free lists");
     }
   }
 }
@@ -7519,6 +7817,7 @@ size_t SweepClosure::do_blk_careful(HeapWord* addr) {
                    lastFreeRangeCoalesced() ? 1 : 0);
       }
     }
+    merge_pending_chunks();
 
     // help the iterator loop finish
     return pointer_delta(_sp->end(), addr);
@@ -7531,7 +7830,7 @@ size_t SweepClosure::do_blk_careful(HeapWord* addr) {
     // Chunk that is already free
     res = fc->size();
     do_already_free_chunk(fc);
-    debug_only(_sp->verifyFreeLists());
+    debug_only(verify_free_lists());
     // If we flush the chunk at hand in lookahead_and_flush()
     // and it's coalesced with a preceding chunk, then the
     // process of "mangling" the payload of the coalesced block
@@ -7550,7 +7849,7 @@ size_t SweepClosure::do_blk_careful(HeapWord* addr) {
   } else if (!_bitMap->isMarked(addr)) {
     // Chunk is fresh garbage
     res = do_garbage_chunk(fc);
-    debug_only(_sp->verifyFreeLists());
+    debug_only(verify_free_lists());
     NOT_PRODUCT(
       _numObjectsFreed++;
       _numWordsFreed += res;
@@ -7558,7 +7857,7 @@ size_t SweepClosure::do_blk_careful(HeapWord* addr) {
   } else {
     // Chunk that is alive.
     res = do_live_chunk(fc);
-    debug_only(_sp->verifyFreeLists());
+    debug_only(verify_free_lists());
     NOT_PRODUCT(
         _numObjectsLive++;
         _numWordsLive += res;
@@ -7615,7 +7914,7 @@ void SweepClosure::do_already_free_chunk(FreeChunk* fc) {
   // Chunks that cannot be coalesced are not in the
   // free lists.
   if (CMSTestInFreeList && !fc->cantCoalesce()) {
-    assert(_sp->verify_chunk_in_free_list(fc),
+    assert(verify_chunk_in_free_list(fc),
       "free chunk should be in free lists");
   }
   // a chunk that is already free, should not have been
@@ -7662,6 +7961,7 @@ void SweepClosure::do_already_free_chunk(FreeChunk* fc) {
           gclog_or_tty->print("  -- pick up free block " PTR_FORMAT " (" SIZE_FORMAT ")\n", fc, size);
         }
         // remove it from the free lists
+        MutexLockerEx x(_parLock, Mutex::_no_safepoint_check_flag);
         _sp->removeFreeChunkFromFreeLists(fc);
         set_lastFreeRangeCoalesced(true);
         // If the chunk is being coalesced and the current free range is
@@ -7673,7 +7973,7 @@ void SweepClosure::do_already_free_chunk(FreeChunk* fc) {
           assert(ffc->size() == pointer_delta(addr, freeFinger()),
             "Size of free range is inconsistent with chunk size.");
           if (CMSTestInFreeList) {
-            assert(_sp->verify_chunk_in_free_list(ffc),
+            assert(verify_chunk_in_free_list(ffc),
               "free range is not in free lists");
           }
           _sp->removeFreeChunkFromFreeLists(ffc);
@@ -7732,9 +8032,10 @@ size_t SweepClosure::do_garbage_chunk(FreeChunk* fc) {
         assert(ffc->size() == pointer_delta(addr, freeFinger()),
           "Size of free range is inconsistent with chunk size.");
         if (CMSTestInFreeList) {
-          assert(_sp->verify_chunk_in_free_list(ffc),
+          assert(verify_chunk_in_free_list(ffc),
             "free range is not in free lists");
         }
+        MutexLockerEx x(_parLock, Mutex::_no_safepoint_check_flag);
         _sp->removeFreeChunkFromFreeLists(ffc);
         set_freeRangeInFreeLists(false);
       }
@@ -7810,7 +8111,7 @@ void SweepClosure::do_post_free_or_garbage_chunk(FreeChunk* fc,
   assert(_sp->adaptive_freelists(), "Should only be used in this case.");
   assert((HeapWord*)fc <= _limit, "sweep invariant");
   if (CMSTestInFreeList && fcInFreeLists) {
-    assert(_sp->verify_chunk_in_free_list(fc), "free chunk is not in free lists");
+    assert(verify_chunk_in_free_list(fc), "free chunk is not in free lists");
   }
 
   if (CMSTraceSweeper) {
@@ -7829,17 +8130,17 @@ void SweepClosure::do_post_free_or_garbage_chunk(FreeChunk* fc,
       break;
     }
     case 1: { // coalesce if left & right chunks on overpopulated lists
-      coalesce = _sp->coalOverPopulated(left) &&
-                 _sp->coalOverPopulated(right);
+      coalesce = coal_over_populated(left) &&
+                 coal_over_populated(right);
       break;
     }
     case 2: { // coalesce if left chunk on overpopulated list (default)
-      coalesce = _sp->coalOverPopulated(left);
+      coalesce = coal_over_populated(left);
       break;
     }
     case 3: { // coalesce if left OR right chunk on overpopulated list
-      coalesce = _sp->coalOverPopulated(left) ||
-                 _sp->coalOverPopulated(right);
+      coalesce = coal_over_populated(left) ||
+                 coal_over_populated(right);
       break;
     }
     case 4: { // always coalesce
@@ -7860,12 +8161,13 @@ void SweepClosure::do_post_free_or_garbage_chunk(FreeChunk* fc,
     // Coalesce the current free range on the left with the new
     // chunk on the right.  If either is on a free list,
     // it must be removed from the list and stashed in the closure.
+    MutexLockerEx x(_parLock, Mutex::_no_safepoint_check_flag);
     if (freeRangeInFreeLists()) {
       FreeChunk* const ffc = (FreeChunk*)freeFinger();
       assert(ffc->size() == pointer_delta(fc_addr, freeFinger()),
         "Size of free range is inconsistent with chunk size.");
       if (CMSTestInFreeList) {
-        assert(_sp->verify_chunk_in_free_list(ffc),
+        assert(verify_chunk_in_free_list(ffc),
           "Chunk is not in free lists");
       }
       _sp->coalDeath(ffc->size());
@@ -7939,7 +8241,7 @@ void SweepClosure::flush_cur_free_chunk(HeapWord* chunk, size_t size) {
     if (CMSTestInFreeList) {
       FreeChunk* fc = (FreeChunk*) chunk;
       fc->set_size(size);
-      assert(!_sp->verify_chunk_in_free_list(fc),
+      assert(!verify_chunk_in_free_list(fc),
         "chunk should not be in free lists yet");
     }
     if (CMSTraceSweeper) {
@@ -7951,18 +8253,70 @@ void SweepClosure::flush_cur_free_chunk(HeapWord* chunk, size_t size) {
     // was removed so add it back.
     // If the current free range was coalesced, then the death
     // of the free range was recorded.  Record a birth now.
-    if (lastFreeRangeCoalesced()) {
-      _sp->coalBirth(size);
+    if (_task != NULL) {
+      // Parallel sweepers defer the addition to the shared free
+      // lists; the chunk is inaccessible to allocators until then.
+      if (_numPending == PendingChunksSize) {
+        merge_pending_chunks();
+      }
+      PendingChunk* pc = &_pending[_numPending++];
+      pc->_chunk     = chunk;
+      pc->_size      = size;
+      pc->_coalesced = lastFreeRangeCoalesced();
+    } else {
+      if (lastFreeRangeCoalesced()) {
+        _sp->coalBirth(size);
+      }
+      _sp->addChunkAndRepairOffsetTable(chunk, size,
+              lastFreeRangeCoalesced());
     }
-    _sp->addChunkAndRepairOffsetTable(chunk, size,
-            lastFreeRangeCoalesced());
   } else if (CMSTraceSweeper) {
     gclog_or_tty->print_cr("Already in free list: nothing to flush");
   }
+  _lastFlushedChunk = chunk;
+  _lastFlushedEnd   = chunk + size;
   set_inFreeRange(false);
   set_freeRangeInFreeLists(false);
 }
 
+void SweepClosure::merge_pending_chunks() {
+  if (_numPending == 0) {
+    return;
+  }
+  assert(_task != NULL, "Only parallel sweepers buffer chunks");
+  MutexLockerEx x(_parLock, Mutex::_no_safepoint_check_flag);
+  for (size_t i = 0; i < _numPending; i++) {
+    PendingChunk* pc = &_pending[i];
+    if (pc->_coalesced) {
+      _sp->coalBirth(pc->_size);
+    }
+    _sp->addChunkAndRepairOffsetTable(pc->_chunk, pc->_size, pc->_coalesced);
+  }
+  _numPending = 0;
+}
+
+bool SweepClosure::coal_over_populated(size_t size) {
+  return _task != NULL ? _sp->par_coalOverPopulated(size)
+                       : _sp->coalOverPopulated(size);
+}
+
+bool SweepClosure::verify_chunk_in_free_list(FreeChunk* fc) const {
+  if (_parLock != NULL && !_parLock->owned_by_self()) {
+    MutexLockerEx x(_parLock, Mutex::_no_safepoint_check_flag);
+    return _sp->verify_chunk_in_free_list(fc);
+  }
+  return _sp->verify_chunk_in_free_list(fc);
+}
+
+void SweepClosure::verify_free_lists() const {
+  if (_parLock != NULL && !_parLock->owned_by_self()) {
+    MutexLockerEx x(_parLock, Mutex::_no_safepoint_check_flag);
+    _sp->verifyFreeLists();
+  } else {
+    _sp->verifyFreeLists();
+  }
+}
+
 // We take a break if we've been at this for a while,
 // so as to avoid monopolizing the locks involved.
 void SweepClosure::do_yield_work(HeapWord* addr) {
@@ -7976,6 +8330,14 @@ void SweepClosure::do_yield_work(HeapWord* addr) {
     flush_cur_free_chunk(freeFinger(), pointer_delta(addr, freeFinger()));
   }
 
+  if (_task != NULL) {
+    // Make our chunks available to allocators while we are yielding;
+    // the coordinator gives up and re-acquires the locks for the gang.
+    merge_pending_chunks();
+    _task->yield();
+    return;
+  }
+
   // First give up the locks, then yield, then re-lock.
   // We should probably use a constructor/destructor idiom to
   // do this unlock/lock or modify the MutexUnlocker class to
@@ -57,6 +57,7 @@
 class AdaptiveSizePolicy;
 class CMSConcMarkingTask;
 class CMSGCAdaptivePolicyCounters;
+class CMSParSweepTask;
 class CMSTracer;
 class ConcurrentGCTimer;
 class ConcurrentMarkSweepGeneration;
@@ -486,7 +487,7 @@ public:
   { }
 
   // Executes a task using worker threads.
-  virtual void execute(ProcessTask& task);
+  virtual void execute(ProcessTask& task, uint ergo_workers);
   virtual void execute(EnqueueTask& task);
 private:
   CMSCollector& _collector;
@@ -502,6 +503,7 @@ class CMSCollector: public CHeapObj<mtGC> {
   friend class CMSParInitialMarkTask;
   friend class CMSParRemarkTask;
   friend class CMSConcMarkingTask;
+  friend class CMSParSweepTask;
   friend class CMSRefProcTaskProxy;
   friend class CMSRefProcTaskExecutor;
   friend class ScanMarkedObjectsAgainCarefullyClosure;  // for sampling eden
@@ -800,6 +802,7 @@ class CMSCollector: public CHeapObj<mtGC> {
 
   // Concurrent sweeping work
   void sweepWork(ConcurrentMarkSweepGeneration* gen);
+  void do_sweeping_mt(ConcurrentMarkSweepGeneration* gen); // Multi-threaded sweeping
 
   // (Concurrent) resetting of support data structures
   void reset(bool concurrent);
@@ -1644,6 +1647,25 @@ class SweepClosure: public BlkClosureCareful {
                                         // When _inFreeRange is set, this
                                         // indicates the accumulated size
                                         // of the "left hand chunk"
+  CMSParSweepTask*               _task; // When non-NULL, the parallel sweep
+                                        // task on whose behalf this closure
+                                        // sweeps a single chunk of the space
+  Mutex*                         _parLock;
+                                        // Serializes free list updates among
+                                        // parallel sweepers (NULL if serial)
+  // When sweeping in parallel, the chunks returned by this closure
+  // are buffered locally and merged into the shared free lists in
+  // batches, so as to amortize the cost of taking _parLock.
+  enum { PendingChunksSize = 64 };
+  struct PendingChunk {
+    HeapWord* _chunk;
+    size_t    _size;
+    bool      _coalesced;
+  };
+  PendingChunk                   _pending[PendingChunksSize];
+  size_t                         _numPending;
+  HeapWord*                      _lastFlushedChunk; // The most recently
+  HeapWord*                      _lastFlushedEnd;   // returned free range
   NOT_PRODUCT(
     size_t                       _numObjectsFreed;
     size_t                       _numWordsFreed;
@@ -1682,6 +1704,13 @@ class SweepClosure: public BlkClosureCareful {
   void initialize_free_range(HeapWord* freeFinger, bool freeRangeInFreeLists);
   // Return this chunk to the free lists.
   void flush_cur_free_chunk(HeapWord* chunk, size_t size);
+  // Merge the locally buffered chunks into the shared free lists.
+  void merge_pending_chunks();
+
+  // Free list queries that are safe in the face of parallel sweepers.
+  bool coal_over_populated(size_t size);
+  bool verify_chunk_in_free_list(FreeChunk* fc) const;
+  void verify_free_lists() const;
 
   // Check if we should yield and do so when necessary.
   inline void do_yield_check(HeapWord* addr);
@@ -1695,9 +1724,18 @@ class SweepClosure: public BlkClosureCareful {
  public:
   SweepClosure(CMSCollector* collector, ConcurrentMarkSweepGeneration* g,
                CMSBitMap* bitMap, bool should_yield);
+  // Sweep the blocks in [span.start(), span.end()) on behalf of
+  // a parallel sweep task; span.start() must be a block boundary.
+  SweepClosure(CMSCollector* collector, ConcurrentMarkSweepGeneration* g,
+               CMSBitMap* bitMap, CMSParSweepTask* task, MemRegion span);
   ~SweepClosure() PRODUCT_RETURN;
 
   size_t       do_blk_careful(HeapWord* addr);
+  // The free chunk, if any, that this closure returned to the
+  // free lists and that ends exactly at the end of the swept span.
+  HeapWord*    trailing_free_chunk() const {
+    return _lastFlushedEnd == _limit ? _lastFlushedChunk : NULL;
+  }
   void         print() const { print_on(tty); }
   void         print_on(outputStream *st) const;
 };
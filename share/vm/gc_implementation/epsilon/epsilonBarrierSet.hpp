@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#ifndef SHARE_VM_GC_IMPLEMENTATION_EPSILON_EPSILONBARRIERSET_HPP
+#define SHARE_VM_GC_IMPLEMENTATION_EPSILON_EPSILONBARRIERSET_HPP
+
+#include "memory/modRefBarrierSet.hpp"
+
+// The Epsilon collector never moves or traces objects, so it needs no
+// barriers at all.  The barrier set reports itself as a plain ModRef
+// barrier set, which the interpreter and the compilers already treat as
+// "no pre- or post-barrier", and makes every barrier operation a no-op.
+// The array and region operations claim to be optimized, since callers
+// assert that before invoking them; there is nothing to do either way.
+
+class EpsilonBarrierSet: public ModRefBarrierSet {
+public:
+  EpsilonBarrierSet() :
+    ModRefBarrierSet(BarrierSet::FakeRtti(BarrierSet::ModRef, 0)) { }
+
+  bool has_write_ref_barrier()     { return false; }
+  bool has_write_ref_pre_barrier() { return false; }
+  bool has_write_ref_array_opt()   { return true; }
+  bool has_write_region_opt()      { return true; }
+
+  void invalidate(MemRegion mr, bool whole_heap = false) { }
+  void clear(MemRegion mr) { }
+
+  void resize_covered_region(MemRegion new_region) { }
+  bool is_aligned(HeapWord* addr) { return true; }
+
+  void print_on(outputStream* st) const {
+    st->print_cr("Epsilon barrier set (no barriers)");
+  }
+
+protected:
+  void write_ref_field_work(void* field, oop new_val, bool release = false) { }
+  void write_ref_array_work(MemRegion mr) { }
+  void write_region_work(MemRegion mr) { }
+};
+
+#endif // SHARE_VM_GC_IMPLEMENTATION_EPSILON_EPSILONBARRIERSET_HPP
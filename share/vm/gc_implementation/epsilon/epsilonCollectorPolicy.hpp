@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#ifndef SHARE_VM_GC_IMPLEMENTATION_EPSILON_EPSILONCOLLECTORPOLICY_HPP
+#define SHARE_VM_GC_IMPLEMENTATION_EPSILON_EPSILONCOLLECTORPOLICY_HPP
+
+#include "memory/collectorPolicy.hpp"
+
+// The Epsilon collector only sizes the heap; it has a single space and
+// never collects, so allocation failures are reported straight back to
+// the caller by EpsilonHeap instead of going through the policy.
+
+class EpsilonCollectorPolicy: public CollectorPolicy {
+protected:
+  virtual void initialize_alignments() {
+    _space_alignment = os::vm_page_size();
+    _heap_alignment = compute_heap_alignment();
+  }
+
+public:
+  EpsilonCollectorPolicy() : CollectorPolicy() { }
+
+  virtual BarrierSet::Name barrier_set_name() { return BarrierSet::ModRef; }
+
+  virtual HeapWord* mem_allocate_work(size_t size,
+                                      bool is_tlab,
+                                      bool* gc_overhead_limit_was_exceeded) {
+    ShouldNotCallThis();
+    return NULL;
+  }
+
+  virtual HeapWord* satisfy_failed_allocation(size_t size, bool is_tlab) {
+    ShouldNotCallThis();
+    return NULL;
+  }
+
+  virtual void post_heap_initialize() { }
+};
+
+#endif // SHARE_VM_GC_IMPLEMENTATION_EPSILON_EPSILONCOLLECTORPOLICY_HPP
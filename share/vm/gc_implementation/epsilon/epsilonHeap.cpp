@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#include "precompiled.hpp"
+#include "gc_implementation/epsilon/epsilonBarrierSet.hpp"
+#include "gc_implementation/epsilon/epsilonHeap.hpp"
+#include "gc_implementation/shared/spaceDecorator.hpp"
+#include "memory/universe.hpp"
+#include "oops/oop.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "services/memTracker.hpp"
+
+EpsilonHeap::EpsilonHeap() :
+  CollectedHeap(),
+  _policy(NULL),
+  _space(NULL),
+  _max_tlab_size(0),
+  _start_time_ms(0) {
+}
+
+EpsilonHeap* EpsilonHeap::heap() {
+  CollectedHeap* heap = Universe::heap();
+  assert(heap != NULL, "Uninitialized access to EpsilonHeap::heap()");
+  assert(heap->kind() == CollectedHeap::EpsilonHeap, "Not an Epsilon heap");
+  return (EpsilonHeap*)heap;
+}
+
+jint EpsilonHeap::initialize() {
+  CollectedHeap::pre_initialize();
+
+  _policy = new EpsilonCollectorPolicy();
+  _policy->initialize_all();
+
+  size_t init_byte_size = _policy->initial_heap_byte_size();
+  size_t max_byte_size = _policy->max_heap_byte_size();
+  size_t align = _policy->heap_alignment();
+
+  ReservedSpace heap_rs = Universe::reserve_heap(max_byte_size, align);
+  if (!heap_rs.is_reserved()) {
+    vm_shutdown_during_initialization(
+      "Could not reserve enough space for object heap");
+    return JNI_ENOMEM;
+  }
+  MemTracker::record_virtual_memory_type((address)heap_rs.base(), mtJavaHeap);
+
+  if (!_virtual_space.initialize(heap_rs, init_byte_size)) {
+    vm_shutdown_during_initialization(
+      "Could not commit the initial object heap");
+    return JNI_ENOMEM;
+  }
+
+  MemRegion committed((HeapWord*)_virtual_space.low(),
+                      (HeapWord*)_virtual_space.high());
+  initialize_reserved_region((HeapWord*)heap_rs.base(),
+                             (HeapWord*)(heap_rs.base() + heap_rs.size()));
+
+  _space = new ContiguousSpace();
+  _space->initialize(committed, SpaceDecorator::Clear, SpaceDecorator::Mangle);
+
+  _max_tlab_size = MIN2(CollectedHeap::max_tlab_size(),
+                        (size_t)align_size_down(EpsilonMaxTLABSize, HeapWordSize) / HeapWordSize);
+
+  _barrier_set = new EpsilonBarrierSet();
+  oopDesc::set_bs(_barrier_set);
+
+  _start_time_ms = os::javaTimeNanos() / NANOSECS_PER_MILLISEC;
+
+  if (PrintGCDetails) {
+    gclog_or_tty->print_cr("Epsilon heap: " SIZE_FORMAT "K reserved, "
+                           SIZE_FORMAT "K committed, " SIZE_FORMAT "K max TLAB",
+                           max_byte_size / K, init_byte_size / K,
+                           _max_tlab_size * HeapWordSize / K);
+  }
+  return JNI_OK;
+}
+
+HeapWord* EpsilonHeap::allocate_work(size_t size) {
+  HeapWord* result = _space->par_allocate(size);
+  if (result == NULL) {
+    result = expand_and_allocate(size);
+  }
+  return result;
+}
+
+HeapWord* EpsilonHeap::expand_and_allocate(size_t size) {
+  MutexLockerEx ml(Heap_lock);
+
+  // Another thread may have expanded the space while we were waiting.
+  HeapWord* result = _space->par_allocate(size);
+  while (result == NULL) {
+    size_t want = size * HeapWordSize;
+    size_t space_left = _virtual_space.uncommitted_size();
+    if (want > space_left + _space->free()) {
+      // Out of heap; the caller reports OutOfMemoryError.
+      return NULL;
+    }
+    size_t expand = MIN2(space_left, MAX2(want, (size_t)EpsilonMinHeapExpand));
+    if (!_virtual_space.expand_by(expand)) {
+      return NULL;
+    }
+    _space->set_end((HeapWord*)_virtual_space.high());
+    if (PrintGCDetails && Verbose) {
+      gclog_or_tty->print_cr("Epsilon heap expanded to " SIZE_FORMAT "K, "
+                             SIZE_FORMAT "K used",
+                             capacity() / K, used() / K);
+    }
+    result = _space->par_allocate(size);
+  }
+  return result;
+}
+
+HeapWord* EpsilonHeap::mem_allocate(size_t size,
+                                    bool* gc_overhead_limit_was_exceeded) {
+  *gc_overhead_limit_was_exceeded = false;
+  return allocate_work(size);
+}
+
+HeapWord* EpsilonHeap::allocate_new_tlab(size_t size) {
+  return allocate_work(size);
+}
+
+size_t EpsilonHeap::unsafe_max_tlab_alloc(Thread* thr) const {
+  // Report the space that can be handed out without committing more;
+  // larger TLABs are still satisfied by expanding the space.
+  return MIN2(_space->free() + _virtual_space.uncommitted_size(),
+              _max_tlab_size * HeapWordSize);
+}
+
+void EpsilonHeap::collect(GCCause::Cause cause) {
+  if (PrintGC) {
+    gclog_or_tty->print_cr("Epsilon heap ignores collection request: %s, "
+                           SIZE_FORMAT "K used, " SIZE_FORMAT "K committed",
+                           GCCause::to_string(cause), used() / K, capacity() / K);
+  }
+}
+
+void EpsilonHeap::do_full_collection(bool clear_all_soft_refs) {
+  collect(gc_cause());
+}
+
+void EpsilonHeap::oop_iterate(ExtendedOopClosure* cl) {
+  _space->oop_iterate(cl);
+}
+
+void EpsilonHeap::object_iterate(ObjectClosure* cl) {
+  _space->object_iterate(cl);
+}
+
+HeapWord* EpsilonHeap::block_start(const void* addr) const {
+  return _space->block_start_const(addr);
+}
+
+size_t EpsilonHeap::block_size(const HeapWord* addr) const {
+  return _space->block_size(addr);
+}
+
+bool EpsilonHeap::block_is_obj(const HeapWord* addr) const {
+  return _space->block_is_obj(addr);
+}
+
+jlong EpsilonHeap::millis_since_last_gc() {
+  // There has never been a GC; report the time since startup.
+  return os::javaTimeNanos() / NANOSECS_PER_MILLISEC - _start_time_ms;
+}
+
+void EpsilonHeap::print_on(outputStream* st) const {
+  st->print_cr("Epsilon Heap");
+  st->print_cr(" total " SIZE_FORMAT "K, used " SIZE_FORMAT "K, max " SIZE_FORMAT "K",
+               capacity() / K, used() / K, max_capacity() / K);
+  st->print(" ");
+  _space->print_on(st);
+  MetaspaceAux::print_on(st);
+}
+
+void EpsilonHeap::print_tracing_info() const {
+  if (PrintGCDetails) {
+    gclog_or_tty->print_cr("Epsilon heap: " SIZE_FORMAT "K allocated in total, "
+                           SIZE_FORMAT "K committed",
+                           used() / K, capacity() / K);
+  }
+}
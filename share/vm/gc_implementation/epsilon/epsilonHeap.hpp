@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#ifndef SHARE_VM_GC_IMPLEMENTATION_EPSILON_EPSILONHEAP_HPP
+#define SHARE_VM_GC_IMPLEMENTATION_EPSILON_EPSILONHEAP_HPP
+
+#include "gc_implementation/epsilon/epsilonCollectorPolicy.hpp"
+#include "gc_interface/collectedHeap.hpp"
+#include "memory/space.hpp"
+#include "runtime/virtualspace.hpp"
+
+// EpsilonHeap is an experimental collector that allocates but never
+// reclaims memory (-XX:+UnlockExperimentalVMOptions -XX:+UseEpsilonGC).
+// All objects and TLABs are bump-pointer allocated from one contiguous
+// space, which is committed on demand up to the maximum heap size.  There
+// are no barriers.  When the space is exhausted, allocation fails and the
+// caller throws OutOfMemoryError.
+//
+// It is meant as a baseline for measuring allocation and barrier costs
+// separately from collection work, and for short-lived jobs that finish
+// before they run out of heap.
+
+class EpsilonHeap : public CollectedHeap {
+  friend class VMStructs;
+private:
+  EpsilonCollectorPolicy* _policy;
+  VirtualSpace            _virtual_space;
+  ContiguousSpace*        _space;
+  size_t                  _max_tlab_size;
+  jlong                   _start_time_ms;
+
+  // Commit more of the reserved space so that an allocation of "size"
+  // words can succeed, then retry it.  Returns NULL if the reserved space
+  // is exhausted.
+  HeapWord* expand_and_allocate(size_t size);
+  HeapWord* allocate_work(size_t size);
+
+public:
+  EpsilonHeap();
+
+  static EpsilonHeap* heap();
+
+  virtual CollectedHeap::Name kind() const { return CollectedHeap::EpsilonHeap; }
+
+  virtual CollectorPolicy* collector_policy() const { return _policy; }
+  virtual AdaptiveSizePolicy* size_policy() { return NULL; }
+
+  virtual jint initialize();
+  virtual void post_initialize() { }
+
+  ContiguousSpace* space() const { return _space; }
+
+  static size_t conservative_max_heap_alignment() {
+    return CollectorPolicy::compute_heap_alignment();
+  }
+
+  virtual size_t capacity()     const { return _space->capacity(); }
+  virtual size_t used()         const { return _space->used(); }
+  virtual size_t max_capacity() const { return _virtual_space.reserved_size(); }
+
+  virtual bool is_maximal_no_gc() const {
+    // No GC is ever going to happen; the heap is maximal once it is
+    // fully committed.
+    return _virtual_space.uncommitted_size() == 0;
+  }
+
+  virtual bool is_in(const void* p) const { return _space->is_in(p); }
+  virtual bool is_scavengable(const void* p) { return false; }
+  virtual bool is_in_partial_collection(const void* p) { return false; }
+
+  // Allocation
+  virtual HeapWord* mem_allocate(size_t size,
+                                 bool* gc_overhead_limit_was_exceeded);
+  virtual HeapWord* allocate_new_tlab(size_t size);
+
+  virtual bool supports_inline_contig_alloc() const { return true; }
+  virtual HeapWord** top_addr() const { return _space->top_addr(); }
+  virtual HeapWord** end_addr() const { return _space->end_addr(); }
+
+  // TLAB support
+  virtual bool supports_tlab_allocation() const { return true; }
+  virtual size_t tlab_capacity(Thread* thr) const { return capacity(); }
+  virtual size_t tlab_used(Thread* thr) const { return used(); }
+  virtual size_t max_tlab_size() const { return _max_tlab_size; }
+  virtual size_t unsafe_max_tlab_alloc(Thread* thr) const;
+
+  // No barriers.
+  virtual bool can_elide_tlab_store_barriers() const { return true; }
+  virtual bool can_elide_initializing_store_barrier(oop new_obj) { return true; }
+  virtual bool card_mark_must_follow_store() const { return false; }
+
+  // Collection requests are ignored.
+  virtual void collect(GCCause::Cause cause);
+  virtual void do_full_collection(bool clear_all_soft_refs);
+
+  // Heap walking
+  virtual bool supports_heap_inspection() const { return true; }
+  virtual void oop_iterate(ExtendedOopClosure* cl);
+  virtual void object_iterate(ObjectClosure* cl);
+  virtual void safe_object_iterate(ObjectClosure* cl) { object_iterate(cl); }
+
+  virtual HeapWord* block_start(const void* addr) const;
+  virtual size_t block_size(const HeapWord* addr) const;
+  virtual bool block_is_obj(const HeapWord* addr) const;
+
+  virtual jlong millis_since_last_gc();
+
+  // No GC threads.
+  virtual void print_gc_threads_on(outputStream* st) const { }
+  virtual void gc_threads_do(ThreadClosure* tc) const { }
+
+  virtual void prepare_for_verify() { }
+  virtual void verify(bool silent, VerifyOption option) { }
+
+  virtual void print_on(outputStream* st) const;
+  virtual void print_tracing_info() const;
+};
+
+#endif // SHARE_VM_GC_IMPLEMENTATION_EPSILON_EPSILONHEAP_HPP
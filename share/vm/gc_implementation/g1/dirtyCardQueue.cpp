@@ -30,6 +30,7 @@
 #include "runtime/mutexLocker.hpp"
 #include "runtime/safepoint.hpp"
 #include "runtime/thread.inline.hpp"
+#include "utilities/quickSort.hpp"
 #include "utilities/workgroup.hpp"
 
 bool DirtyCardQueue::apply_closure(CardTableEntryClosure* cl,
@@ -45,12 +46,40 @@ bool DirtyCardQueue::apply_closure(CardTableEntryClosure* cl,
   return res;
 }
 
+static int compare_card_ptrs(void* card1, void* card2) {
+  if (card1 < card2) {
+    return -1;
+  } else if (card1 > card2) {
+    return 1;
+  }
+  return 0;
+}
+
+void DirtyCardQueue::sort_buffer(void** buf, size_t index, size_t sz) {
+  void** first = buf + byte_index_to_index((int)index);
+  int length = byte_index_to_index((int)(sz - index));
+  if (length < 2) {
+    return;
+  }
+  QuickSort::sort<void*>(first, length, compare_card_ptrs, false);
+  // Duplicates are now adjacent. Only the first one would find its card
+  // still dirty, so drop the others up front.
+  for (int i = length - 1; i > 0; i--) {
+    if (first[i] == first[i - 1]) {
+      first[i] = NULL;
+    }
+  }
+}
+
 bool DirtyCardQueue::apply_closure_to_buffer(CardTableEntryClosure* cl,
                                              void** buf,
                                              size_t index, size_t sz,
                                              bool consume,
                                              uint worker_i) {
   if (cl == NULL) return true;
+  if (consume) {
+    sort_buffer(buf, index, sz);
+  }
   for (size_t i = index; i < sz; i += oopSize) {
     int ind = byte_index_to_index((int)i);
     jbyte* card_ptr = (jbyte*)buf[ind];
@@ -62,11 +62,16 @@ public:
                      bool consume = true,
                      uint worker_i = 0);
 
+  // Sorts the card pointers in "buf" from "index" up to "sz" by address and
+  // clears duplicate entries, so that the cards of a region are refined
+  // back to back and each dirty card is only visited once.
+  static void sort_buffer(void** buf, size_t index, size_t sz);
+
   // Apply the closure to all elements of "buf", down to "index"
   // (inclusive.)  If returns "false", then a closure application returned
-  // "false", and we return immediately.  If "consume" is true, entries are
-  // set to NULL as they are processed, so they will not be processed again
-  // later.
+  // "false", and we return immediately.  If "consume" is true, the entries
+  // are first sorted by card address, and entries are set to NULL as they
+  // are processed, so they will not be processed again later.
   static bool apply_closure_to_buffer(CardTableEntryClosure* cl,
                                       void** buf, size_t index, size_t sz,
                                       bool consume = true,
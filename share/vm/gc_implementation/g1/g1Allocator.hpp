@@ -28,6 +28,7 @@
 #include "gc_implementation/g1/g1AllocationContext.hpp"
 #include "gc_implementation/g1/g1AllocRegion.hpp"
 #include "gc_implementation/g1/g1InCSetState.hpp"
+#include "gc_implementation/g1/g1NUMA.hpp"
 #include "gc_implementation/shared/parGCAllocBuffer.hpp"
 
 // Base class for G1 allocators.
@@ -53,12 +54,23 @@ public:
    virtual void release_gc_alloc_regions(uint no_of_gc_workers, EvacuationInfo& evacuation_info) = 0;
    virtual void abandon_gc_alloc_regions() = 0;
 
-   virtual MutatorAllocRegion*    mutator_alloc_region(AllocationContext_t context) = 0;
-   virtual SurvivorGCAllocRegion* survivor_gc_alloc_region(AllocationContext_t context) = 0;
+   // Mutator and survivor alloc regions are kept per NUMA node; node_index
+   // selects the one to use (see G1NUMA).
+   virtual MutatorAllocRegion*    mutator_alloc_region(AllocationContext_t context, uint node_index) = 0;
+   virtual SurvivorGCAllocRegion* survivor_gc_alloc_region(AllocationContext_t context, uint node_index) = 0;
    virtual OldGCAllocRegion*      old_gc_alloc_region(AllocationContext_t context) = 0;
    virtual size_t                 used() = 0;
    virtual bool                   is_retained_old_region(HeapRegion* hr) = 0;
 
+   // The number of survivor regions allocated into during the current
+   // GC, summed over all nodes.
+   virtual uint                   survivor_gc_alloc_regions_count(AllocationContext_t context) = 0;
+
+   // The index of the alloc regions to use for the current thread.
+   uint current_node_index() const {
+     return G1NUMA::numa()->index_of_current_thread();
+   }
+
    void                           reuse_retained_old_region(EvacuationInfo& evacuation_info,
                                                             OldGCAllocRegion* old,
                                                             HeapRegion** retained);
@@ -92,12 +104,17 @@ public:
 // The default allocator for G1.
 class G1DefaultAllocator : public G1Allocator {
 protected:
-  // Alloc region used to satisfy mutator allocation requests.
-  MutatorAllocRegion _mutator_alloc_region;
+  // Alloc regions used to satisfy mutator allocation requests, one per
+  // active NUMA node.
+  MutatorAllocRegion* _mutator_alloc_regions;
 
-  // Alloc region used to satisfy allocation requests by the GC for
-  // survivor objects.
-  SurvivorGCAllocRegion _survivor_gc_alloc_region;
+  // Alloc regions used to satisfy allocation requests by the GC for
+  // survivor objects, one per active NUMA node.
+  SurvivorGCAllocRegion* _survivor_gc_alloc_regions;
+
+  // The number of mutator and survivor alloc regions, i.e. the number of
+  // active NUMA nodes.
+  uint _num_alloc_regions;
 
   // Alloc region used to satisfy allocation requests by the GC for
   // old objects.
@@ -105,7 +122,8 @@ protected:
 
   HeapRegion* _retained_old_gc_alloc_region;
 public:
-  G1DefaultAllocator(G1CollectedHeap* heap) : G1Allocator(heap), _retained_old_gc_alloc_region(NULL) { }
+  G1DefaultAllocator(G1CollectedHeap* heap);
+  ~G1DefaultAllocator();
 
   virtual void init_mutator_alloc_region();
   virtual void release_mutator_alloc_region();
@@ -118,14 +136,20 @@ public:
     return _retained_old_gc_alloc_region == hr;
   }
 
-  virtual MutatorAllocRegion* mutator_alloc_region(AllocationContext_t context) {
-    return &_mutator_alloc_region;
+  virtual MutatorAllocRegion* mutator_alloc_region(AllocationContext_t context, uint node_index) {
+    assert(node_index < _num_alloc_regions,
+           err_msg("Invalid index: %u, max: %u", node_index, _num_alloc_regions));
+    return &_mutator_alloc_regions[node_index];
   }
 
-  virtual SurvivorGCAllocRegion* survivor_gc_alloc_region(AllocationContext_t context) {
-    return &_survivor_gc_alloc_region;
+  virtual SurvivorGCAllocRegion* survivor_gc_alloc_region(AllocationContext_t context, uint node_index) {
+    assert(node_index < _num_alloc_regions,
+           err_msg("Invalid index: %u, max: %u", node_index, _num_alloc_regions));
+    return &_survivor_gc_alloc_regions[node_index];
   }
 
+  virtual uint survivor_gc_alloc_regions_count(AllocationContext_t context);
+
   virtual OldGCAllocRegion* old_gc_alloc_region(AllocationContext_t context) {
     return &_old_gc_alloc_region;
   }
@@ -135,10 +159,12 @@ public:
            "Should be owned on this thread's behalf.");
     size_t result = _summary_bytes_used;
 
-    // Read only once in case it is set to NULL concurrently
-    HeapRegion* hr = mutator_alloc_region(AllocationContext::current())->get();
-    if (hr != NULL) {
-      result += hr->used();
+    for (uint i = 0; i < _num_alloc_regions; i++) {
+      // Read only once in case it is set to NULL concurrently
+      HeapRegion* hr = mutator_alloc_region(AllocationContext::current(), i)->get();
+      if (hr != NULL) {
+        result += hr->used();
+      }
     }
     return result;
   }
@@ -66,6 +66,7 @@ class CodeRootSetTable : public Hashtable<nmethod*, mtGC> {
 
   void copy_to(CodeRootSetTable* new_table);
   void nmethods_do(CodeBlobClosure* blk);
+  size_t nmethods_do(CodeBlobClosure* blk, int start, int end);
 
   template<typename CB>
   int remove_if(CB& should_remove);
@@ -170,6 +171,17 @@ void CodeRootSetTable::nmethods_do(CodeBlobClosure* blk) {
   }
 }
 
+size_t CodeRootSetTable::nmethods_do(CodeBlobClosure* blk, int start, int end) {
+  size_t visited = 0;
+  for (int index = start; index < end; ++index) {
+    for (Entry* e = bucket(index); e != NULL; e = e->next()) {
+      blk->do_code_blob(e->literal());
+      visited++;
+    }
+  }
+  return visited;
+}
+
 template<typename CB>
 int CodeRootSetTable::remove_if(CB& should_remove) {
   int num_removed = 0;
@@ -294,6 +306,19 @@ void G1CodeRootSet::nmethods_do(CodeBlobClosure* blk) const {
   }
 }
 
+size_t G1CodeRootSet::num_buckets() const {
+  return _table != NULL ? (size_t)_table->table_size() : 0;
+}
+
+size_t G1CodeRootSet::nmethods_do(CodeBlobClosure* blk, size_t start, size_t end) const {
+  assert(start <= end && end <= num_buckets(),
+         err_msg("Invalid bucket range [" SIZE_FORMAT ", " SIZE_FORMAT ")", start, end));
+  if (_table == NULL) {
+    return 0;
+  }
+  return _table->nmethods_do(blk, (int)start, (int)end);
+}
+
 class CleanCallback : public StackObj {
   class PointsIntoHRDetectionClosure : public OopClosure {
     HeapRegion* _hr;
@@ -345,6 +370,13 @@ void G1CodeRootSet::clean(HeapRegion* owner) {
 #ifndef PRODUCT
 
 class G1CodeRootSetTest {
+  class CountingCodeBlobClosure : public CodeBlobClosure {
+   public:
+    size_t _count;
+    CountingCodeBlobClosure() : _count(0) { }
+    void do_code_blob(CodeBlob* cb) { _count++; }
+  };
+
  public:
   static void test() {
     {
@@ -377,6 +409,17 @@ class G1CodeRootSetTest {
 
       assert(CodeRootSetTable::_purge_list != NULL, "should have grown to large hashtable");
 
+      // Iterating over disjoint bucket ranges visits every element once.
+      CountingCodeBlobClosure count_cl;
+      size_t num_visited = 0;
+      for (size_t start = 0; start < set1.num_buckets(); start += 7) {
+        size_t end = MIN2(start + 7, set1.num_buckets());
+        num_visited += set1.nmethods_do(&count_cl, start, end);
+      }
+      assert(num_visited == num_to_add && count_cl._count == num_to_add,
+          err_msg("Visited "SIZE_FORMAT" ("SIZE_FORMAT") code roots in bucket ranges, "
+              "but the set contains "SIZE_FORMAT, num_visited, count_cl._count, num_to_add));
+
       size_t num_popped = 0;
       for (size_t i = 1; i <= num_to_add; i++) {
         bool removed = set1.remove((nmethod*)i);
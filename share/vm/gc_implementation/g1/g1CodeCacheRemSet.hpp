@@ -69,6 +69,14 @@ class G1CodeRootSet VALUE_OBJ_CLASS_SPEC {
 
   void nmethods_do(CodeBlobClosure* blk) const;
 
+  // Number of hash buckets. Disjoint bucket ranges can be iterated
+  // over by different threads at the same time.
+  size_t num_buckets() const;
+
+  // Applies blk to the nmethods in buckets [start, end). Returns the
+  // number of nmethods visited.
+  size_t nmethods_do(CodeBlobClosure* blk, size_t start, size_t end) const;
+
   // Remove all nmethods which no longer contain pointers into our "owner" region
   void clean(HeapRegion* owner);
 
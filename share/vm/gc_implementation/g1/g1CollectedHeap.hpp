@@ -34,6 +34,7 @@
 #include "gc_implementation/g1/g1HRPrinter.hpp"
 #include "gc_implementation/g1/g1InCSetState.hpp"
 #include "gc_implementation/g1/g1MonitoringSupport.hpp"
+#include "gc_implementation/g1/g1NUMA.hpp"
 #include "gc_implementation/g1/g1SATBCardTableModRefBS.hpp"
 #include "gc_implementation/g1/g1YCTypes.hpp"
 #include "gc_implementation/g1/heapRegionManager.hpp"
@@ -205,6 +206,10 @@ private:
 
   static size_t _humongous_object_threshold_in_words;
 
+  // The NUMA topology as seen by G1. Created first so that the region
+  // sets below can size their per-node information.
+  G1NUMA* _numa;
+
   // The secondary free list which contains regions that have been
   // freed up during the cleanup process. This will be appended to
   // the master free list when appropriate.
@@ -430,14 +435,17 @@ protected:
   // check whether there's anything available on the
   // secondary_free_list and/or wait for more regions to appear on
   // that list, if _free_regions_coming is set.
-  HeapRegion* new_region_try_secondary_free_list(bool is_old);
+  HeapRegion* new_region_try_secondary_free_list(bool is_old, uint node_index);
 
   // Try to allocate a single non-humongous HeapRegion sufficient for
   // an allocation of the given word_size. If do_expand is true,
   // attempt to expand the heap if necessary to satisfy the allocation
   // request. If the region is to be used as an old region or for a
   // humongous object, set is_old to true. If not, to false.
-  HeapRegion* new_region(size_t word_size, bool is_old, bool do_expand);
+  // The region is preferably taken from the NUMA node with index
+  // node_index, if any.
+  HeapRegion* new_region(size_t word_size, bool is_old, bool do_expand,
+                         uint node_index = G1NUMA::AnyNodeIndex);
 
   // Initialize a contiguous set of free regions of length num_regions
   // and starting at index first so that they appear as a single
@@ -506,6 +514,7 @@ protected:
   // pause. This should only be used for non-humongous allocations.
   HeapWord* attempt_allocation_slow(size_t word_size,
                                     AllocationContext_t context,
+                                    uint node_index,
                                     uint* gc_count_before_ret,
                                     uint* gclocker_retry_count_ret);
 
@@ -542,7 +551,8 @@ protected:
 
   // Allocation attempt during GC for a survivor object / PLAB.
   inline HeapWord* survivor_attempt_allocation(size_t word_size,
-                                               AllocationContext_t context);
+                                               AllocationContext_t context,
+                                               uint node_index);
 
   // Allocation attempt during GC for an old object / PLAB.
   inline HeapWord* old_attempt_allocation(size_t word_size,
@@ -551,13 +561,13 @@ protected:
   // These methods are the "callbacks" from the G1AllocRegion class.
 
   // For mutator alloc regions.
-  HeapRegion* new_mutator_alloc_region(size_t word_size, bool force);
+  HeapRegion* new_mutator_alloc_region(size_t word_size, bool force, uint node_index);
   void retire_mutator_alloc_region(HeapRegion* alloc_region,
                                    size_t allocated_bytes);
 
   // For GC alloc regions.
   HeapRegion* new_gc_alloc_region(size_t word_size, uint count,
-                                  InCSetState dest);
+                                  InCSetState dest, uint node_index);
   void retire_gc_alloc_region(HeapRegion* alloc_region,
                               size_t allocated_bytes, InCSetState dest);
 
@@ -609,6 +619,10 @@ public:
     return _allocator;
   }
 
+  G1NUMA* numa() const {
+    return _numa;
+  }
+
   G1MonitoringSupport* g1mm() {
     assert(_g1mm != NULL, "should have been initialized");
     return _g1mm;
@@ -810,6 +824,10 @@ protected:
   // True iff a evacuation has failed in the current collection.
   bool _evacuation_failed;
 
+  // True iff an evacuation failed in the current collection because no
+  // space was left to copy into, not because the object is pinned.
+  bool _to_space_exhausted;
+
   EvacuationFailedInfo* _evacuation_failed_info_array;
 
   // Failed evacuations cause some logical from-space objects to have
@@ -851,8 +869,10 @@ protected:
   // structures.
   void finalize_for_evac_failure();
 
-  // An attempt to evacuate "obj" has failed; take necessary steps.
-  oop handle_evacuation_failure_par(G1ParScanThreadState* _par_scan_state, oop obj);
+  // An attempt to evacuate "obj" has failed, or "obj" is in a region
+  // with pinned objects and must stay in place; take necessary steps.
+  oop handle_evacuation_failure_par(G1ParScanThreadState* _par_scan_state, oop obj,
+                                    bool pinned = false);
   void handle_evacuation_failure_common(oop obj, markOop m);
 
 #ifndef PRODUCT
@@ -1227,6 +1247,7 @@ public:
 
   // True iff an evacuation has failed in the most-recent collection.
   bool evacuation_failed() { return _evacuation_failed; }
+  bool to_space_exhausted() { return _to_space_exhausted; }
 
   void remove_from_old_sets(const HeapRegionSetCount& old_regions_removed, const HeapRegionSetCount& humongous_regions_removed);
   void prepend_to_freelist(FreeRegionList* list);
@@ -1379,6 +1400,14 @@ public:
   // Does this heap support heap inspection? (+PrintClassHistogram)
   virtual bool supports_heap_inspection() const { return true; }
 
+  // With G1PinJNICriticalRegions, pinning an object pins the region that
+  // contains it instead of entering the GC_locker. Young collections keep
+  // the objects of pinned regions in place and retain those regions as
+  // old; mixed collections leave pinned old regions out of the
+  // collection set; full collections do not compact pinned regions.
+  virtual oop pin_object(JavaThread* thread, oop obj);
+  virtual void unpin_object(JavaThread* thread, oop obj);
+
   // Section on thread-local allocation buffers (TLABs)
   // See CollectedHeap for semantics.
 
@@ -954,7 +954,7 @@ void G1CollectorPolicy::record_collection_pause_end(double pause_time_ms, Evacua
   size_t cur_used_bytes = _g1->used();
   assert(cur_used_bytes == _g1->recalculate_used(), "It should!");
   bool last_pause_included_initial_mark = false;
-  bool update_stats = !_g1->evacuation_failed();
+  bool update_stats = !_g1->to_space_exhausted();
 
 #ifndef PRODUCT
   if (G1YoungSurvRateVerbose) {
@@ -2005,6 +2005,17 @@ void G1CollectorPolicy::finalize_cset(double target_pause_time_ms, EvacuationInf
         break;
       }
 
+      if (hr->has_pinned_objects()) {
+        // None of its objects could be evacuated. Drop the region from the
+        // candidates; it will be reconsidered after the next marking.
+        ergo_verbose0(ErgoCSetConstruction,
+                      "skip old region",
+                      ergo_format_reason("region has pinned objects"));
+        cset_chooser->remove_and_move_to_next(hr);
+        hr = cset_chooser->peek();
+        continue;
+      }
+
       double predicted_time_ms = predict_region_elapsed_time_ms(hr, gcs_are_young());
       if (check_time_remaining) {
         if (predicted_time_ms > time_remaining_ms) {
@@ -167,6 +167,7 @@ G1GCPhaseTimes::G1GCPhaseTimes(uint max_gc_threads) :
   _last_update_rs_processed_buffers(_max_gc_threads, "%d"),
   _last_scan_rs_times_ms(_max_gc_threads, "%.1lf"),
   _last_strong_code_root_scan_times_ms(_max_gc_threads, "%.1lf"),
+  _last_strong_code_root_scan_nmethods(_max_gc_threads, SIZE_FORMAT),
   _last_obj_copy_times_ms(_max_gc_threads, "%.1lf"),
   _last_termination_times_ms(_max_gc_threads, "%.1lf"),
   _last_termination_attempts(_max_gc_threads, SIZE_FORMAT),
@@ -193,6 +194,7 @@ void G1GCPhaseTimes::note_gc_start(uint active_gc_threads) {
   _last_update_rs_processed_buffers.reset();
   _last_scan_rs_times_ms.reset();
   _last_strong_code_root_scan_times_ms.reset();
+  _last_strong_code_root_scan_nmethods.reset();
   _last_obj_copy_times_ms.reset();
   _last_termination_times_ms.reset();
   _last_termination_attempts.reset();
@@ -213,6 +215,7 @@ void G1GCPhaseTimes::note_gc_end() {
   _last_update_rs_processed_buffers.verify();
   _last_scan_rs_times_ms.verify();
   _last_strong_code_root_scan_times_ms.verify();
+  _last_strong_code_root_scan_nmethods.verify();
   _last_obj_copy_times_ms.verify();
   _last_termination_times_ms.verify();
   _last_termination_attempts.verify();
@@ -302,6 +305,9 @@ void G1GCPhaseTimes::print(double pause_time_sec) {
     _last_update_rs_processed_buffers.print(3, "Processed Buffers");
   _last_scan_rs_times_ms.print(2, "Scan RS (ms)");
   _last_strong_code_root_scan_times_ms.print(2, "Code Root Scanning (ms)");
+  if (G1Log::finest()) {
+    _last_strong_code_root_scan_nmethods.print(3, "Scanned NMethods");
+  }
   _last_obj_copy_times_ms.print(2, "Object Copy (ms)");
   _last_termination_times_ms.print(2, "Termination (ms)");
   if (G1Log::finest()) {
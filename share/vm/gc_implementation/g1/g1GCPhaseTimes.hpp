@@ -120,6 +120,7 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
   WorkerDataArray<int>    _last_update_rs_processed_buffers;
   WorkerDataArray<double> _last_scan_rs_times_ms;
   WorkerDataArray<double> _last_strong_code_root_scan_times_ms;
+  WorkerDataArray<size_t> _last_strong_code_root_scan_nmethods;
   WorkerDataArray<double> _last_obj_copy_times_ms;
   WorkerDataArray<double> _last_termination_times_ms;
   WorkerDataArray<size_t> _last_termination_attempts;
@@ -200,8 +201,9 @@ class G1GCPhaseTimes : public CHeapObj<mtGC> {
     _last_scan_rs_times_ms.set(worker_i, ms);
   }
 
-  void record_strong_code_root_scan_time(uint worker_i, double ms) {
+  void record_strong_code_root_scan_time(uint worker_i, double ms, size_t nmethods) {
     _last_strong_code_root_scan_times_ms.set(worker_i, ms);
+    _last_strong_code_root_scan_nmethods.set(worker_i, nmethods);
   }
 
   void record_obj_copy_time(uint worker_i, double ms) {
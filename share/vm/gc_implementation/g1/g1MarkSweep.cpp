@@ -217,6 +217,13 @@ class G1AdjustPointersClosure: public HeapRegionClosure {
         // point all the oops to the new location
         obj->adjust_pointers();
       }
+    } else if (r->has_pinned_objects()) {
+      // Pinned regions were not prepared for compaction; dead objects
+      // have been replaced by fillers, so just walk all objects.
+      HeapWord* cur = r->bottom();
+      while (cur < r->top()) {
+        cur += oop(cur)->adjust_pointers();
+      }
     } else {
       // This really ought to be "as_CompactibleSpace"...
       r->adjust_pointers();
@@ -276,6 +283,10 @@ public:
         }
         hr->reset_during_compaction();
       }
+    } else if (hr->has_pinned_objects()) {
+      // Nothing moves in a pinned region.
+      hr->set_compaction_top(hr->top());
+      hr->reset_after_compaction();
     } else {
       hr->compact();
     }
@@ -340,6 +351,24 @@ void G1PrepareCompactClosure::prepare_for_compaction_work(CompactPoint* cp,
   _mrbs->clear(MemRegion(hr->compaction_top(), end));
 }
 
+void G1PrepareCompactClosure::prepare_pinned_region(HeapRegion* hr) {
+  // Live objects keep their address, so they get no forwarding pointer.
+  // Dead objects are overwritten with fillers of the same size, which
+  // keeps the block offset table valid and the region parsable after
+  // their classes have been unloaded.
+  HeapWord* cur = hr->bottom();
+  while (cur < hr->top()) {
+    oop obj = oop(cur);
+    size_t size = obj->size();
+    if (obj->is_gc_marked()) {
+      obj->init_mark();
+    } else {
+      CollectedHeap::fill_with_object(cur, size);
+    }
+    cur += size;
+  }
+}
+
 void G1PrepareCompactClosure::update_sets() {
   // We'll recalculate total used bytes and recreate the free list
   // at the end of the GC, so no point in updating those values here.
@@ -359,6 +388,8 @@ bool G1PrepareCompactClosure::doHeapRegion(HeapRegion* hr) {
     } else {
       assert(hr->is_continues_humongous(), "Invalid humongous.");
     }
+  } else if (hr->has_pinned_objects()) {
+    prepare_pinned_region(hr);
   } else {
     prepare_for_compaction(hr, hr->end());
   }
@@ -81,6 +81,7 @@ class G1PrepareCompactClosure : public HeapRegionClosure {
   virtual void prepare_for_compaction(HeapRegion* hr, HeapWord* end);
   void prepare_for_compaction_work(CompactPoint* cp, HeapRegion* hr, HeapWord* end);
   void free_humongous_region(HeapRegion* hr);
+  void prepare_pinned_region(HeapRegion* hr);
   bool is_cp_initialized() const { return _cp.space != NULL; }
 
  public:
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#ifndef SHARE_VM_GC_IMPLEMENTATION_G1_G1NUMA_HPP
+#define SHARE_VM_GC_IMPLEMENTATION_G1_G1NUMA_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+class HeapRegion;
+
+// Keeps track of the NUMA topology as far as G1 is concerned. Every active
+// node id reported by the OS is mapped to a dense index in the range
+// [0, num_active_nodes()), which is what the rest of G1 uses to tag heap
+// regions and to select per-node allocation regions.
+//
+// Heap regions are assigned a preferred node in an interleaved fashion
+// based on their index (taking into account that a large page may span
+// several regions), and the memory backing them is requested from that
+// node when it is committed.
+//
+// If UseNUMA is off, or the machine has only a single node, there is a
+// single active node with index 0 and all requests are no-ops.
+class G1NUMA: public CHeapObj<mtGC> {
+  // Mapping of the OS node ids to a dense, zero-based index. Contains
+  // UnknownNodeIndex for ids that are not active.
+  uint* _node_id_to_index_map;
+  // Length of _node_id_to_index_map.
+  int _len_node_id_to_index_map;
+
+  // Active node ids, indexed by node index.
+  int* _node_ids;
+  uint _num_active_node_ids;
+
+  // HeapRegion size and the page size used to back the heap.
+  size_t _region_size;
+  size_t _page_size;
+
+  static G1NUMA* _inst;
+
+  G1NUMA();
+  void initialize(bool use_numa);
+  void initialize_without_numa();
+
+  size_t region_size() const;
+  size_t page_size() const;
+
+public:
+  static const uint UnknownNodeIndex = UINT_MAX;
+  static const uint AnyNodeIndex = UnknownNodeIndex - 1;
+
+  static G1NUMA* numa() { return _inst; }
+
+  static G1NUMA* create();
+
+  ~G1NUMA();
+
+  // Sets heap region size and page size after those values
+  // are determined at G1CollectedHeap::initialize().
+  void set_region_info(size_t region_size, size_t page_size);
+
+  // Returns active memory node count.
+  uint num_active_nodes() const { return _num_active_node_ids; }
+
+  // Returns true if more than one active node is available, i.e. if
+  // node-aware allocation has any effect.
+  bool is_enabled() const { return num_active_nodes() > 1; }
+
+  // Returns the active node ids.
+  const int* node_ids() const { return _node_ids; }
+
+  // Returns node index of the given node id.
+  // Precondition: node_id is an active node id.
+  inline uint index_of_node_id(int node_id) const;
+
+  // Returns the node id of the given node index.
+  int numa_id(uint index) const;
+
+  // Returns the node index of the node the current thread is running on.
+  uint index_of_current_thread() const;
+
+  // Returns the preferred node index of the region with the given index.
+  // A region backed by a large page shares the node of that page.
+  uint preferred_node_index_for_index(uint region_index) const;
+
+  // Requests the given memory area, belonging to the region with the given
+  // index, to be placed on the preferred node of that region.
+  void request_memory_on_node(void* aligned_address, size_t size_in_bytes, uint region_index);
+
+  // Maximum number of free list entries to look at when searching for a
+  // region on a particular node. Regions are interleaved across nodes in
+  // address order, so a matching region is usually found within a few
+  // entries; the bound keeps the search cheap if it is not.
+  uint max_search_depth() const;
+
+  void print_on(outputStream* st) const;
+};
+
+inline uint G1NUMA::index_of_node_id(int node_id) const {
+  assert(node_id >= 0, err_msg("invalid node id %d", node_id));
+  assert(node_id < _len_node_id_to_index_map, err_msg("invalid node id %d", node_id));
+  uint node_index = _node_id_to_index_map[node_id];
+  assert(node_index != UnknownNodeIndex, err_msg("invalid node id %d", node_id));
+  return node_index;
+}
+
+#endif // SHARE_VM_GC_IMPLEMENTATION_G1_G1NUMA_HPP
@@ -24,6 +24,8 @@
 
 #include "precompiled.hpp"
 #include "gc_implementation/g1/g1PageBasedVirtualSpace.hpp"
+#include "gc_interface/collectedHeap.hpp"
+#include "memory/universe.hpp"
 #include "oops/markOop.hpp"
 #include "oops/oop.inline.hpp"
 #include "services/memTracker.hpp"
@@ -144,10 +146,16 @@ bool G1PageBasedVirtualSpace::commit(uintptr_t start, size_t size_in_pages) {
   }
   _committed.set_range(start, end);
 
+  return zero_filled;
+}
+
+void G1PageBasedVirtualSpace::pretouch(uintptr_t start, size_t size_in_pages) {
+  assert(is_area_committed(start, size_in_pages), "Specified area is not committed");
+
   if (AlwaysPreTouch) {
-    os::pretouch_memory(page_start(start), page_start(end));
+    Universe::heap()->pretouch_memory(page_start(start), page_start(start + size_in_pages),
+                                      _page_size);
   }
-  return zero_filled;
 }
 
 void G1PageBasedVirtualSpace::uncommit(uintptr_t start, size_t size_in_pages) {
@@ -64,10 +64,6 @@ class G1PageBasedVirtualSpace VALUE_OBJ_CLASS_SPEC {
 
   // Returns the index of the page which contains the given address.
   uintptr_t  addr_to_page_index(char* addr) const;
-  // Returns the address of the given page index.
-  char*  page_start(uintptr_t index);
-  // Returns the byte size of the given number of pages.
-  size_t byte_size_for_pages(size_t num);
 
   // Returns true if the entire area is backed by committed memory.
   bool is_area_committed(uintptr_t start, size_t size_in_pages) const;
@@ -78,8 +74,18 @@ class G1PageBasedVirtualSpace VALUE_OBJ_CLASS_SPEC {
 
   // Commit the given area of pages starting at start being size_in_pages large.
   // Returns true if the given area is zero filled upon completion.
+  // The memory is not pre-touched; callers that need it must call
+  // pretouch() once they have finished placing the memory.
   bool commit(uintptr_t start, size_t size_in_pages);
 
+  // Touch the given committed area of pages if AlwaysPreTouch is set.
+  void pretouch(uintptr_t start, size_t size_in_pages);
+
+  // Returns the address of the given page index.
+  char*  page_start(uintptr_t index);
+  // Returns the byte size of the given number of pages.
+  size_t byte_size_for_pages(size_t num);
+
   // Uncommit the given area of pages starting at start being size_in_pages large.
   void uncommit(uintptr_t start, size_t size_in_pages);
 
@@ -201,6 +201,11 @@ oop G1ParScanThreadState::copy_to_survivor_space(InCSetState const state,
                                                  markOop const old_mark) {
   const size_t word_sz = old->size();
   HeapRegion* const from_region = _g1h->heap_region_containing_raw(old);
+  if (from_region->has_pinned_objects()) {
+    // Objects in a pinned region stay where they are; the region is
+    // retained like one whose evacuation failed.
+    return _g1h->handle_evacuation_failure_par(this, old, true /* pinned */);
+  }
   // +1 to make the -1 indexes valid...
   const int young_index = from_region->young_index_in_cset()+1;
   assert( (from_region->is_young() && young_index >  0) ||
@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "gc_implementation/g1/g1BiasedArray.hpp"
+#include "gc_implementation/g1/g1NUMA.hpp"
 #include "gc_implementation/g1/g1RegionToSpaceMapper.hpp"
 #include "memory/allocation.inline.hpp"
 #include "runtime/virtualspace.hpp"
@@ -38,7 +39,8 @@ G1RegionToSpaceMapper::G1RegionToSpaceMapper(ReservedSpace rs,
   _commit_granularity(commit_granularity),
   _region_granularity(region_granularity),
   _listener(NULL),
-  _commit_map() {
+  _commit_map(),
+  _memory_type(type) {
   guarantee(is_power_of_2(commit_granularity), "must be");
   guarantee(is_power_of_2(region_granularity), "must be");
   _storage.initialize_with_granularity(rs, commit_granularity);
@@ -67,7 +69,12 @@ class G1RegionsLargerThanCommitSizeMapper : public G1RegionToSpaceMapper {
   }
 
   virtual void commit_regions(uintptr_t start_idx, size_t num_regions) {
-    bool zero_filled = _storage.commit(start_idx * _pages_per_region, num_regions * _pages_per_region);
+    size_t const start_page = start_idx * _pages_per_region;
+    bool zero_filled = _storage.commit(start_page, num_regions * _pages_per_region);
+    for (uint region_idx = (uint)start_idx; region_idx < start_idx + num_regions; region_idx++) {
+      numa_request_on_node(region_idx * _pages_per_region, _pages_per_region, region_idx);
+    }
+    _storage.pretouch(start_page, num_regions * _pages_per_region);
     _commit_map.set_range(start_idx, start_idx + num_regions);
     fire_on_commit(start_idx, num_regions, zero_filled);
   }
@@ -118,6 +125,8 @@ class G1RegionsSmallerThanCommitSizeMapper : public G1RegionToSpaceMapper {
       bool zero_filled = false;
       if (old_refcount == 0) {
         zero_filled = _storage.commit(idx, 1);
+        numa_request_on_node(idx, 1, (uint)i);
+        _storage.pretouch(idx, 1);
       }
       _refcounts.set_by_index(idx, old_refcount + 1);
       _commit_map.set_bit(i);
@@ -140,6 +149,14 @@ class G1RegionsSmallerThanCommitSizeMapper : public G1RegionToSpaceMapper {
   }
 };
 
+void G1RegionToSpaceMapper::numa_request_on_node(size_t start_page, size_t num_pages, uint region_idx) {
+  if (_memory_type == mtJavaHeap) {
+    G1NUMA::numa()->request_memory_on_node(_storage.page_start(start_page),
+                                           _storage.byte_size_for_pages(num_pages),
+                                           region_idx);
+  }
+}
+
 void G1RegionToSpaceMapper::fire_on_commit(uint start_idx, size_t num_regions, bool zero_filled) {
   if (_listener != NULL) {
     _listener->on_commit(start_idx, num_regions, zero_filled);
@@ -51,8 +51,15 @@ class G1RegionToSpaceMapper : public CHeapObj<mtGC> {
   // Mapping management
   BitMap _commit_map;
 
+  MemoryType _memory_type;
+
   G1RegionToSpaceMapper(ReservedSpace rs, size_t commit_granularity, size_t region_granularity, MemoryType type);
 
+  // Request the pages starting at start_page backing the region with index
+  // region_idx to be placed on that region's preferred NUMA node. Only the
+  // Java heap itself is placed; auxiliary data structures are left alone.
+  void numa_request_on_node(size_t start_page, size_t num_pages, uint region_idx);
+
   void fire_on_commit(uint start_idx, size_t num_regions, bool zero_filled);
  public:
   MemRegion reserved() { return _storage.reserved(); }
@@ -108,6 +108,7 @@ class ScanRSClosure : public HeapRegionClosure {
   G1SATBCardTableModRefBS *_ct_bs;
 
   double _strong_code_root_scan_time_sec;
+  size_t _strong_code_roots_scanned;
   uint   _worker_i;
   int    _block_size;
   bool   _try_claimed;
@@ -119,6 +120,7 @@ public:
     _oc(oc),
     _code_root_cl(code_root_cl),
     _strong_code_root_scan_time_sec(0.0),
+    _strong_code_roots_scanned(0),
     _cards(0),
     _cards_done(0),
     _worker_i(worker_i),
@@ -165,7 +167,7 @@ public:
 
   void scan_strong_code_roots(HeapRegion* r) {
     double scan_start = os::elapsedTime();
-    r->strong_code_roots_do(_code_root_cl);
+    _strong_code_roots_scanned += r->rem_set()->strong_code_roots_par_do(_code_root_cl);
     _strong_code_root_scan_time_sec += (os::elapsedTime() - scan_start);
   }
 
@@ -213,10 +215,12 @@ public:
         scanCard(card_index, card_region);
       }
     }
-    if (!_try_claimed) {
-      // Scan the strong code root list attached to the current region
-      scan_strong_code_roots(r);
+    // Scan the strong code root list attached to the current region.
+    // Workers that visit a claimed region in their second pass help
+    // with the parts of a large list that are still unclaimed.
+    scan_strong_code_roots(r);
 
+    if (!_try_claimed) {
       hrrs->set_iter_complete();
     }
     return false;
@@ -226,6 +230,8 @@ public:
     return _strong_code_root_scan_time_sec;
   }
 
+  size_t strong_code_roots_scanned() { return _strong_code_roots_scanned; }
+
   size_t cards_done() { return _cards_done;}
   size_t cards_looked_up() { return _cards;}
 };
@@ -250,7 +256,8 @@ void G1RemSet::scanRS(G1ParPushHeapRSClosure* oc,
 
   _g1p->phase_times()->record_scan_rs_time(worker_i, scan_rs_time_sec * 1000.0);
   _g1p->phase_times()->record_strong_code_root_scan_time(worker_i,
-                                                         scanRScl.strong_code_root_scan_time_sec() * 1000.0);
+                                                         scanRScl.strong_code_root_scan_time_sec() * 1000.0,
+                                                         scanRScl.strong_code_roots_scanned());
 }
 
 // Closure used for updating RSets and recording references that
@@ -33,6 +33,7 @@
 #include "oops/typeArrayOop.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/prefetch.inline.hpp"
 
 //
 // Freelist in the deduplication table entry cache. Links table
@@ -285,19 +286,7 @@ unsigned int G1StringDedupTable::hash_code(typeArrayOop value) {
   return hash;
 }
 
-void G1StringDedupTable::deduplicate(oop java_string, G1StringDedupStat& stat) {
-  assert(java_lang_String::is_instance(java_string), "Must be a string");
-  No_Safepoint_Verifier nsv;
-
-  stat.inc_inspected();
-
-  typeArrayOop value = java_lang_String::value(java_string);
-  if (value == NULL) {
-    // String has no value
-    stat.inc_skipped();
-    return;
-  }
-
+unsigned int G1StringDedupTable::hash_code(oop java_string, typeArrayOop value, G1StringDedupStat& stat) {
   unsigned int hash = 0;
 
   if (use_java_hash()) {
@@ -316,29 +305,93 @@ void G1StringDedupTable::deduplicate(oop java_string, G1StringDedupStat& stat) {
     java_lang_String::set_hash(java_string, hash);
   }
 
-  typeArrayOop existing_value = lookup_or_add(value, hash);
-  if (existing_value == value) {
-    // Same value, already known
-    stat.inc_known();
-    return;
+  return hash;
+}
+
+void G1StringDedupTable::lookup_or_add(typeArrayOop* values, unsigned int* hashes,
+                                       typeArrayOop* existing_values, size_t count) {
+  // Protect the table from concurrent access. Also note that this lock
+  // acts as a fence for _table, which could have been replaced by a new
+  // instance if the table was resized or rehashed.
+  MutexLockerEx ml(StringDedupTable_lock, Mutex::_no_safepoint_check_flag);
+
+  for (size_t i = 0; i < count; i++) {
+    if (values[i] != NULL) {
+      Prefetch::read(_table->bucket(_table->hash_to_index(hashes[i])), 0);
+    }
   }
 
-  // Get size of value array
-  uintx size_in_bytes = value->size() * HeapWordSize;
-  stat.inc_new(size_in_bytes);
+  for (size_t i = 0; i < count; i++) {
+    existing_values[i] = NULL;
+    if (values[i] != NULL) {
+      existing_values[i] = _table->lookup_or_add_inner(values[i], hashes[i]);
+    }
+  }
+}
 
-  if (existing_value != NULL) {
-    // Enqueue the reference to make sure it is kept alive. Concurrent mark might
-    // otherwise declare it dead if there are no other strong references to this object.
-    G1SATBCardTableModRefBS::enqueue(existing_value);
+void G1StringDedupTable::deduplicate(oop java_string, G1StringDedupStat& stat) {
+  deduplicate(&java_string, 1, stat);
+}
 
-    // Existing value found, deduplicate string
-    java_lang_String::set_value(java_string, existing_value);
+void G1StringDedupTable::deduplicate(oop* java_strings, size_t count, G1StringDedupStat& stat) {
+  assert(count <= BatchSize, err_msg("Batch too large: " SIZE_FORMAT, count));
+  No_Safepoint_Verifier nsv;
 
-    if (G1CollectedHeap::heap()->is_in_young(value)) {
-      stat.inc_deduped_young(size_in_bytes);
-    } else {
-      stat.inc_deduped_old(size_in_bytes);
+  typeArrayOop values[BatchSize];
+  typeArrayOop existing_values[BatchSize];
+  unsigned int hashes[BatchSize];
+
+  // Start loading all character arrays before hashing the first one
+  for (size_t i = 0; i < count; i++) {
+    assert(java_lang_String::is_instance(java_strings[i]), "Must be a string");
+    values[i] = java_lang_String::value(java_strings[i]);
+    if (values[i] != NULL) {
+      Prefetch::read(values[i], arrayOopDesc::base_offset_in_bytes(T_CHAR));
+    }
+  }
+
+  for (size_t i = 0; i < count; i++) {
+    stat.inc_inspected();
+    if (values[i] == NULL) {
+      // String has no value
+      stat.inc_skipped();
+      continue;
+    }
+    hashes[i] = hash_code(java_strings[i], values[i], stat);
+  }
+
+  lookup_or_add(values, hashes, existing_values, count);
+
+  for (size_t i = 0; i < count; i++) {
+    typeArrayOop value = values[i];
+    typeArrayOop existing_value = existing_values[i];
+    if (value == NULL) {
+      continue;
+    }
+
+    if (existing_value == value) {
+      // Same value, already known
+      stat.inc_known();
+      continue;
+    }
+
+    // Get size of value array
+    uintx size_in_bytes = value->size() * HeapWordSize;
+    stat.inc_new(size_in_bytes);
+
+    if (existing_value != NULL) {
+      // Enqueue the reference to make sure it is kept alive. Concurrent mark might
+      // otherwise declare it dead if there are no other strong references to this object.
+      G1SATBCardTableModRefBS::enqueue(existing_value);
+
+      // Existing value found, deduplicate string
+      java_lang_String::set_value(java_strings[i], existing_value);
+
+      if (G1CollectedHeap::heap()->is_in_young(value)) {
+        stat.inc_deduped_young(size_in_bytes);
+      } else {
+        stat.inc_deduped_old(size_in_bytes);
+      }
     }
   }
 }
@@ -168,14 +168,11 @@ private:
   // table entry if no matching character array exists.
   typeArrayOop lookup_or_add_inner(typeArrayOop value, unsigned int hash);
 
-  // Thread safe lookup or add of table entry
-  static typeArrayOop lookup_or_add(typeArrayOop value, unsigned int hash) {
-    // Protect the table from concurrent access. Also note that this lock
-    // acts as a fence for _table, which could have been replaced by a new
-    // instance if the table was resized or rehashed.
-    MutexLockerEx ml(StringDedupTable_lock, Mutex::_no_safepoint_check_flag);
-    return _table->lookup_or_add_inner(value, hash);
-  }
+  // Thread safe lookup or add of table entries for a batch of character
+  // arrays. NULL values are skipped. The hash buckets of the whole batch
+  // are prefetched before the first probe.
+  static void lookup_or_add(typeArrayOop* values, unsigned int* hashes,
+                            typeArrayOop* existing_values, size_t count);
 
   // Returns true if the hashtable is currently using a Java compatible
   // hash function.
@@ -189,18 +186,31 @@ private:
   // currently active hash function and hash seed.
   static unsigned int hash_code(typeArrayOop value);
 
+  // Returns the hash code for the given String object and its character
+  // array, using the cached hash code when possible.
+  static unsigned int hash_code(oop java_string, typeArrayOop value, G1StringDedupStat& stat);
+
   static uintx unlink_or_oops_do(G1StringDedupUnlinkOrOopsDoClosure* cl,
                                  size_t partition_begin,
                                  size_t partition_end,
                                  uint worker_id);
 
 public:
+  // Maximum number of String objects deduplicated as one batch.
+  static const size_t BatchSize = 16;
+
   static void create();
 
   // Deduplicates the given String object, or adds its backing
   // character array to the deduplication hashtable.
   static void deduplicate(oop java_string, G1StringDedupStat& stat);
 
+  // Deduplicates a batch of at most BatchSize String objects. Hash codes
+  // for the whole batch are computed before the table is locked, and all
+  // probes are done under a single lock acquisition, so that the cache
+  // misses on character arrays and hash buckets overlap.
+  static void deduplicate(oop* java_strings, size_t count, G1StringDedupStat& stat);
+
   // If a table resize is needed, returns a newly allocated empty
   // hashtable of the proper size.
   static G1StringDedupTable* prepare_resize();
@@ -78,14 +78,23 @@ void G1StringDedupThread::run() {
 
       stat.mark_exec();
 
-      // Process the queue
+      // Process the queue in batches. Popped strings are no longer
+      // visible to the GC, so a batch must be finished before yielding.
       for (;;) {
-        oop java_string = G1StringDedupQueue::pop();
-        if (java_string == NULL) {
+        oop java_strings[G1StringDedupTable::BatchSize];
+        size_t count = 0;
+        while (count < G1StringDedupTable::BatchSize) {
+          oop java_string = G1StringDedupQueue::pop();
+          if (java_string == NULL) {
+            break;
+          }
+          java_strings[count++] = java_string;
+        }
+        if (count == 0) {
           break;
         }
 
-        G1StringDedupTable::deduplicate(java_string, stat);
+        G1StringDedupTable::deduplicate(java_strings, count, stat);
 
         // Safepoint this thread if needed
         if (sts.should_yield()) {
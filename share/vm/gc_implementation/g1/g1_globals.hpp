@@ -74,6 +74,10 @@
   experimental(bool, G1TraceStringSymbolTableScrubbing, false,              \
           "Trace information string and symbol table scrubbing.")           \
                                                                             \
+  diagnostic(bool, G1TraceNUMA, false,                                      \
+          "Trace NUMA node placement of heap regions and node-aware "       \
+          "region allocation")                                              \
+                                                                            \
   product(double, G1ConcMarkStepDurationMillis, 10.0,                       \
           "Target duration of individual concurrent marking steps "         \
           "in milliseconds.")                                               \
@@ -281,6 +285,10 @@
           "Print some information about large object liveness "             \
           "at every young GC.")                                             \
                                                                             \
+  product(bool, G1PinJNICriticalRegions, true,                              \
+          "Pin the region holding an object accessed through a JNI "        \
+          "critical section instead of blocking GCs with the GC locker")    \
+                                                                            \
   experimental(uintx, G1OldCSetRegionThresholdPercent, 10,                  \
           "An upper bound for the number of old CSet regions expressed "    \
           "as a percentage of the heap size.")                              \
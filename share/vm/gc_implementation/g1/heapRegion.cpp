@@ -26,6 +26,7 @@
 #include "code/nmethod.hpp"
 #include "gc_implementation/g1/g1BlockOffsetTable.inline.hpp"
 #include "gc_implementation/g1/g1CollectedHeap.inline.hpp"
+#include "gc_implementation/g1/g1NUMA.hpp"
 #include "gc_implementation/g1/g1OopClosures.inline.hpp"
 #include "gc_implementation/g1/heapRegion.inline.hpp"
 #include "gc_implementation/g1/heapRegionBounds.inline.hpp"
@@ -164,6 +165,8 @@ void HeapRegion::hr_clear(bool par, bool clear_space, bool locked) {
          "we should have already filtered out humongous regions");
   assert(!in_collection_set(),
          err_msg("Should not clear heap region %u in the collection set", hrm_index()));
+  assert(!has_pinned_objects(),
+         err_msg("Should not clear heap region %u with pinned objects", hrm_index()));
 
   set_allocation_context(AllocationContext::system());
   set_young_index_in_cset(-1);
@@ -263,7 +266,7 @@ HeapRegion::HeapRegion(uint hrm_index,
     _allocation_context(AllocationContext::system()),
     _humongous_start_region(NULL),
     _next_in_special_set(NULL),
-    _evacuation_failed(false),
+    _evacuation_failed(false), _pinned_object_count(0),
     _prev_marked_bytes(0), _next_marked_bytes(0), _gc_efficiency(0.0),
     _next_young_region(NULL),
     _next_dirty_cards_region(NULL), _next(NULL), _prev(NULL),
@@ -272,7 +275,7 @@ HeapRegion::HeapRegion(uint hrm_index,
 #endif // ASSERT
      _young_index_in_cset(-1), _surv_rate_group(NULL), _age_index(-1),
     _rem_set(NULL), _recorded_rs_length(0), _predicted_elapsed_time_ms(0),
-    _predicted_bytes_to_copy(0)
+    _predicted_bytes_to_copy(0), _node_index(0)
 {
   _rem_set = new HeapRegionRemSet(sharedOffsetArray, this);
   assert(HeapRegionRemSet::num_par_rem_sets() > 0, "Invariant.");
@@ -624,6 +627,12 @@ void HeapRegion::print_on(outputStream* st) const {
   else
     st->print("   ");
   st->print(" TS %5d", _gc_time_stamp);
+  if (UseNUMA && G1NUMA::numa()->is_enabled()) {
+    st->print(" N%2u", _node_index);
+  }
+  if (has_pinned_objects()) {
+    st->print(" PIN %d", pinned_object_count());
+  }
   st->print(" PTAMS "PTR_FORMAT" NTAMS "PTR_FORMAT,
             prev_top_at_mark_start(), next_top_at_mark_start());
   G1OffsetTableContigSpace::print_on(st);
@@ -240,6 +240,10 @@ class HeapRegion: public G1OffsetTableContigSpace {
   // True iff an attempt to evacuate an object in the region failed.
   bool _evacuation_failed;
 
+  // Number of objects in this region currently pinned by JNI critical
+  // sections. Objects in a pinned region are never moved.
+  volatile jint _pinned_object_count;
+
   // A heap region may be a member one of a number of special subsets, each
   // represented as linked lists through the field below.  Currently, there
   // is only one set:
@@ -305,6 +309,10 @@ class HeapRegion: public G1OffsetTableContigSpace {
   // the total value for the collection set.
   size_t _predicted_bytes_to_copy;
 
+  // The index of the NUMA node the memory of this region is preferably
+  // placed on (see G1NUMA).
+  uint _node_index;
+
  public:
   HeapRegion(uint hrm_index,
              G1BlockOffsetSharedArray* sharedOffsetArray,
@@ -355,6 +363,11 @@ class HeapRegion: public G1OffsetTableContigSpace {
   // sequence, otherwise -1.
   uint hrm_index() const { return _hrm_index; }
 
+  // The (dense) index of the NUMA node this region's memory is preferably
+  // placed on.
+  uint node_index() const { return _node_index; }
+  void set_node_index(uint node_index) { _node_index = node_index; }
+
   // The number of bytes marked live in the region in the last marking phase.
   size_t marked_bytes()    { return _prev_marked_bytes; }
   size_t live_bytes() {
@@ -690,6 +703,13 @@ class HeapRegion: public G1OffsetTableContigSpace {
     }
   }
 
+  // Object pinning. The count only changes outside of safepoints (from
+  // threads in the VM), so GC pauses see a stable value.
+  jint pinned_object_count() const { return _pinned_object_count; }
+  bool has_pinned_objects() const { return pinned_object_count() > 0; }
+  inline void increment_pinned_object_count();
+  inline void decrement_pinned_object_count();
+
   // Requires that "mr" be entirely within the region.
   // Apply "cl->do_object" to all objects that intersect with "mr".
   // If the iteration encounters an unparseable portion of the region,
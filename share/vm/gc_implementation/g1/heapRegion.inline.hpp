@@ -196,6 +196,16 @@ inline void HeapRegion::note_end_of_copying(bool during_initial_mark) {
   }
 }
 
+inline void HeapRegion::increment_pinned_object_count() {
+  Atomic::inc(&_pinned_object_count);
+}
+
+inline void HeapRegion::decrement_pinned_object_count() {
+  assert(has_pinned_objects(),
+         err_msg("region %u has no pinned objects", hrm_index()));
+  Atomic::dec(&_pinned_object_count);
+}
+
 inline bool HeapRegion::in_collection_set() const {
   return G1CollectedHeap::heap()->is_in_cset(this);
 }
@@ -55,6 +55,34 @@ void HeapRegionManager::initialize(G1RegionToSpaceMapper* heap_storage,
   _available_map.clear();
 }
 
+HeapRegion* HeapRegionManager::allocate_free_region(bool is_old, uint requested_node_index) {
+  HeapRegion* hr = NULL;
+  bool from_head = is_old;
+  G1NUMA* numa = G1NUMA::numa();
+
+  if (requested_node_index != G1NUMA::AnyNodeIndex && numa->is_enabled()) {
+    // Try to allocate with requested node index.
+    hr = _free_list.remove_region_with_node_index(from_head, requested_node_index,
+                                                  numa->max_search_depth());
+    if (G1TraceNUMA && hr == NULL) {
+      gclog_or_tty->print_cr("G1 NUMA: no free %s region on node %d within search depth",
+                             is_old ? "old" : "young", numa->numa_id(requested_node_index));
+    }
+  }
+
+  if (hr == NULL) {
+    // If there's a single active node or we did not get a region from our requested node,
+    // try without requested node index.
+    hr = _free_list.remove_region(from_head);
+  }
+
+  if (hr != NULL) {
+    assert(hr->next() == NULL, "Single region should not have next");
+    assert(is_available(hr->hrm_index()), "Must be committed");
+  }
+  return hr;
+}
+
 bool HeapRegionManager::is_available(uint region) const {
   return _available_map.at(region);
 }
@@ -141,6 +169,7 @@ void HeapRegionManager::make_regions_available(uint start, uint num_regions) {
     MemRegion mr(bottom, bottom + HeapRegion::GrainWords);
 
     hr->initialize(mr);
+    hr->set_node_index(G1NUMA::numa()->preferred_node_index_for_index(i));
     insert_into_free_list(at(i));
   }
 }
@@ -26,6 +26,7 @@
 #define SHARE_VM_GC_IMPLEMENTATION_G1_HEAPREGIONMANAGER_HPP
 
 #include "gc_implementation/g1/g1BiasedArray.hpp"
+#include "gc_implementation/g1/g1NUMA.hpp"
 #include "gc_implementation/g1/g1RegionToSpaceMapper.hpp"
 #include "gc_implementation/g1/heapRegionSet.hpp"
 
@@ -161,15 +162,10 @@ public:
     _free_list.add_ordered(list);
   }
 
-  HeapRegion* allocate_free_region(bool is_old) {
-    HeapRegion* hr = _free_list.remove_region(is_old);
-
-    if (hr != NULL) {
-      assert(hr->next() == NULL, "Single region should not have next");
-      assert(is_available(hr->hrm_index()), "Must be committed");
-    }
-    return hr;
-  }
+  // Allocate a free region, preferably one placed on the NUMA node with
+  // the given index. Falls back to any free region if there is none on
+  // that node (or none is requested).
+  HeapRegion* allocate_free_region(bool is_old, uint requested_node_index = G1NUMA::AnyNodeIndex);
 
   inline void allocate_free_regions_starting_at(uint first, uint num_regions);
 
@@ -183,6 +179,12 @@ public:
     return _free_list.length();
   }
 
+  // Return the number of committed free regions preferably placed on the
+  // NUMA node with the given index.
+  uint num_free_regions(uint node_index) const {
+    return _free_list.length(node_index);
+  }
+
   size_t total_capacity_bytes() const {
     return num_free_regions() * HeapRegion::GrainBytes;
   }
@@ -818,7 +818,8 @@ HeapRegionRemSet::HeapRegionRemSet(G1BlockOffsetSharedArray* bosa,
                                    HeapRegion* hr)
   : _bosa(bosa),
     _m(Mutex::leaf, FormatBuffer<128>("HeapRegionRemSet lock #%u", hr->hrm_index()), true, Monitor::_safepoint_check_never),
-    _code_roots(), _other_regions(hr, &_m), _iter_state(Unclaimed), _iter_claimed(0) {
+    _code_roots(), _other_regions(hr, &_m), _iter_state(Unclaimed), _iter_claimed(0),
+    _code_roots_iter_claimed(0) {
   reset_for_par_iteration();
 }
 
@@ -893,6 +894,7 @@ void HeapRegionRemSet::clear_locked() {
 void HeapRegionRemSet::reset_for_par_iteration() {
   _iter_state = Unclaimed;
   _iter_claimed = 0;
+  _code_roots_iter_claimed = 0;
   // It's good to check this to make sure that the two methods are in sync.
   assert(verify_ready_for_par_iteration(), "post-condition");
 }
@@ -940,6 +942,19 @@ void HeapRegionRemSet::strong_code_roots_do(CodeBlobClosure* blk) const {
   _code_roots.nmethods_do(blk);
 }
 
+size_t HeapRegionRemSet::strong_code_roots_par_do(CodeBlobClosure* blk) {
+  size_t num_buckets = _code_roots.num_buckets();
+  size_t visited = 0;
+  while (_code_roots_iter_claimed < num_buckets) {
+    size_t start = Atomic::add(CodeRootsClaimChunkSize, &_code_roots_iter_claimed) - CodeRootsClaimChunkSize;
+    if (start >= num_buckets) {
+      break;
+    }
+    visited += _code_roots.nmethods_do(blk, start, MIN2(start + CodeRootsClaimChunkSize, num_buckets));
+  }
+  return visited;
+}
+
 void HeapRegionRemSet::clean_strong_code_roots(HeapRegion* hr) {
   _code_roots.clean(hr);
 }
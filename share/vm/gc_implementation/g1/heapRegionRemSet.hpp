@@ -239,6 +239,11 @@ private:
   enum ParIterState { Unclaimed, Claimed, Complete };
   volatile ParIterState _iter_state;
   volatile size_t _iter_claimed;
+  volatile size_t _code_roots_iter_claimed;
+
+  // The number of code root set buckets a thread claims at a time
+  // when scanning the strong code roots in parallel.
+  static const size_t CodeRootsClaimChunkSize = 16;
 
   // Unused unless G1RecordHRRSOops is true.
 
@@ -326,7 +331,7 @@ public:
   void reset_for_par_iteration();
 
   bool verify_ready_for_par_iteration() {
-    return (_iter_state == Unclaimed) && (_iter_claimed == 0);
+    return (_iter_state == Unclaimed) && (_iter_claimed == 0) && (_code_roots_iter_claimed == 0);
   }
 
   // The actual # of bytes this hr_remset takes up.
@@ -366,6 +371,12 @@ public:
   // the strong code roots list
   void strong_code_roots_do(CodeBlobClosure* blk) const;
 
+  // Like strong_code_roots_do(), but any number of threads may scan the
+  // same list at the same time: chunks of the list are claimed until none
+  // are left, so a large list is not serialized on one thread. Returns
+  // the number of entries this thread visited.
+  size_t strong_code_roots_par_do(CodeBlobClosure* blk);
+
   void clean_strong_code_roots(HeapRegion* hr);
 
   // Returns the number of elements in the strong code roots list
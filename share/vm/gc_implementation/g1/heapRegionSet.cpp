@@ -100,6 +100,42 @@ HeapRegionSetBase::HeapRegionSetBase(const char* name, bool humongous, bool free
     _count()
 { }
 
+FreeRegionList::NodeInfo::NodeInfo() : _num_nodes(0), _length_of_node(NULL) {
+  _num_nodes = G1NUMA::numa()->num_active_nodes();
+  _length_of_node = NEW_C_HEAP_ARRAY(uint, _num_nodes, mtGC);
+  clear();
+}
+
+FreeRegionList::NodeInfo::~NodeInfo() {
+  FREE_C_HEAP_ARRAY(uint, _length_of_node);
+}
+
+void FreeRegionList::NodeInfo::clear() {
+  for (uint i = 0; i < _num_nodes; ++i) {
+    _length_of_node[i] = 0;
+  }
+}
+
+void FreeRegionList::NodeInfo::add(NodeInfo* info) {
+  for (uint i = 0; i < _num_nodes; ++i) {
+    _length_of_node[i] += info->_length_of_node[i];
+  }
+}
+
+FreeRegionList::NodeInfo* FreeRegionList::create_node_info() {
+  G1NUMA* numa = G1NUMA::numa();
+  if (numa != NULL && numa->is_enabled()) {
+    return new NodeInfo();
+  }
+  return NULL;
+}
+
+FreeRegionList::~FreeRegionList() {
+  if (_node_info != NULL) {
+    delete _node_info;
+  }
+}
+
 void FreeRegionList::set_unrealistically_long_length(uint len) {
   guarantee(_unrealistically_long_length == 0, "should only be set once");
   _unrealistically_long_length = len;
@@ -191,6 +227,9 @@ void FreeRegionList::add_ordered(FreeRegionList* from_list) {
   }
 
   _count.increment(from_list->length(), from_list->total_capacity_bytes());
+  if (_node_info != NULL && from_list->_node_info != NULL) {
+    _node_info->add(from_list->_node_info);
+  }
   from_list->clear();
 
   verify_optional();
@@ -238,6 +277,7 @@ void FreeRegionList::remove_starting_at(HeapRegion* first, uint num_regions) {
     curr->set_next(NULL);
     curr->set_prev(NULL);
     remove(curr);
+    decrease_length(curr->node_index());
 
     count++;
     curr = next;
@@ -272,6 +312,10 @@ void FreeRegionList::clear() {
   _head = NULL;
   _tail = NULL;
   _last = NULL;
+
+  if (_node_info != NULL) {
+    _node_info->clear();
+  }
 }
 
 void FreeRegionList::print_on(outputStream* out, bool print_contents) {
@@ -279,6 +323,13 @@ void FreeRegionList::print_on(outputStream* out, bool print_contents) {
   out->print_cr("  Linking");
   out->print_cr("    head              : "PTR_FORMAT, _head);
   out->print_cr("    tail              : "PTR_FORMAT, _tail);
+  if (_node_info != NULL) {
+    out->print_cr("  Nodes");
+    G1NUMA* numa = G1NUMA::numa();
+    for (uint i = 0; i < numa->num_active_nodes(); i++) {
+      out->print_cr("    node %-11d : %14u", numa->numa_id(i), length(i));
+    }
+  }
 
   if (print_contents) {
     out->print_cr("  Contents");
@@ -324,6 +375,19 @@ void FreeRegionList::verify_list() {
   guarantee(_tail == prev0, err_msg("Expected %s to end with %u but it ended with %u.", name(), _tail->hrm_index(), prev0->hrm_index()));
   guarantee(_tail == NULL || _tail->next() == NULL, "_tail should not have a next");
   guarantee(length() == count, err_msg("%s count mismatch. Expected %u, actual %u.", name(), length(), count));
+  if (_node_info != NULL) {
+    uint num_nodes = G1NUMA::numa()->num_active_nodes();
+    for (uint i = 0; i < num_nodes; i++) {
+      uint node_count = 0;
+      for (HeapRegion* hr = _head; hr != NULL; hr = hr->next()) {
+        if (hr->node_index() == i) {
+          node_count++;
+        }
+      }
+      guarantee(length(i) == node_count, err_msg("%s count mismatch for node %u. Expected %u, actual %u.",
+                                                 name(), i, length(i), node_count));
+    }
+  }
   guarantee(total_capacity_bytes() == capacity, err_msg("%s capacity mismatch. Expected " SIZE_FORMAT ", actual " SIZE_FORMAT,
       name(), total_capacity_bytes(), capacity));
 }
@@ -406,6 +470,19 @@ void HumongousRegionSetMtSafeChecker::check() {
   }
 }
 
+// Without NUMA there is no per-node information and length(node_index)
+// is the total length.
+static void verify_node_lengths(FreeRegionList* l, uint on_node0, uint on_node1) {
+  G1NUMA* numa = G1NUMA::numa();
+  if (numa != NULL && numa->is_enabled()) {
+    assert(l->length(0) == on_node0, err_msg("wrong length %u for node 0", l->length(0)));
+    assert(l->length(1) == on_node1, err_msg("wrong length %u for node 1", l->length(1)));
+  } else {
+    assert(l->length(0) == l->length(), "should be the total length");
+    assert(l->length(1) == l->length(), "should be the total length");
+  }
+}
+
 void FreeRegionList_test() {
   FreeRegionList l("test");
 
@@ -447,6 +524,45 @@ void FreeRegionList_test() {
   assert(l.length() == num_regions_in_test, "wrong length");
   l.verify_list();
 
+  // Node-aware removal: alternate the preferred nodes of the regions and
+  // check that only matching regions within the search depth are taken.
+  l.remove_all();
+  hr0.set_node_index(0);
+  hr1.set_node_index(1);
+  hr2.set_node_index(0);
+  hr3.set_node_index(1);
+  hr4.set_node_index(0);
+  verify_node_lengths(&l, 0, 0);
+  l.add_ordered(&hr0);
+  verify_node_lengths(&l, 1, 0);
+  l.add_ordered(&hr1);
+  verify_node_lengths(&l, 1, 1);
+  l.add_ordered(&hr2);
+  verify_node_lengths(&l, 2, 1);
+  l.add_ordered(&hr3);
+  verify_node_lengths(&l, 2, 2);
+  l.add_ordered(&hr4);
+  verify_node_lengths(&l, 3, 2);
+  HeapRegion* hr = l.remove_region_with_node_index(true /* from_head */, 1, num_regions_in_test);
+  assert(hr == &hr1, "should find the first region on node 1");
+  verify_node_lengths(&l, 3, 1);
+  hr = l.remove_region_with_node_index(false /* from_head */, 1, num_regions_in_test);
+  assert(hr == &hr3, "should find the last region on node 1");
+  verify_node_lengths(&l, 3, 0);
+  hr = l.remove_region_with_node_index(true /* from_head */, 1, num_regions_in_test);
+  assert(hr == NULL, "no more regions on node 1");
+  verify_node_lengths(&l, 3, 0);
+  hr = l.remove_region_with_node_index(false /* from_head */, 0, 1);
+  assert(hr == &hr4, "tail is on node 0");
+  verify_node_lengths(&l, 2, 0);
+  assert(l.length() == num_regions_in_test - 3, "wrong length");
+  l.verify_list();
+  l.remove_all();
+  verify_node_lengths(&l, 0, 0);
+  hr0.set_node_index(0);
+  hr1.set_node_index(0);
+  hr3.set_node_index(0);
+
   bot_storage->uncommit_regions(0, num_regions_in_test);
   delete bot_storage;
   FREE_C_HEAP_ARRAY(HeapWord, bot_data);
@@ -202,6 +202,27 @@ class FreeRegionList : public HeapRegionSetBase {
   friend class FreeRegionListIterator;
 
 private:
+  // Keeps track of the number of regions in the list that are
+  // preferably placed on each NUMA node (see G1NUMA). Only maintained
+  // if there is more than one active node.
+  class NodeInfo : public CHeapObj<mtGC> {
+    uint  _num_nodes;
+    uint* _length_of_node;
+
+  public:
+    NodeInfo();
+    ~NodeInfo();
+
+    inline void increase_length(uint node_index);
+    inline void decrease_length(uint node_index);
+
+    inline uint length(uint node_index) const;
+
+    void clear();
+
+    void add(NodeInfo* info);
+  };
+
   HeapRegion* _head;
   HeapRegion* _tail;
 
@@ -209,11 +230,18 @@ private:
   // time. It helps to improve performance when adding several ordered items in a row.
   HeapRegion* _last;
 
+  NodeInfo* _node_info;
+
   static uint _unrealistically_long_length;
 
   inline HeapRegion* remove_from_head_impl();
   inline HeapRegion* remove_from_tail_impl();
 
+  inline void increase_length(uint node_index);
+  inline void decrease_length(uint node_index);
+
+  static NodeInfo* create_node_info();
+
 protected:
   virtual void fill_in_ext_msg_extra(hrs_ext_msg* msg);
 
@@ -222,10 +250,13 @@ protected:
 
 public:
   FreeRegionList(const char* name, HRSMtSafeChecker* mt_safety_checker = NULL):
-    HeapRegionSetBase(name, false /* humongous */, true /* empty */, mt_safety_checker) {
+    HeapRegionSetBase(name, false /* humongous */, true /* empty */, mt_safety_checker),
+    _node_info(create_node_info()) {
     clear();
   }
 
+  ~FreeRegionList();
+
   void verify_list();
 
 #ifdef ASSERT
@@ -244,6 +275,13 @@ public:
   // Removes from head or tail based on the given argument.
   HeapRegion* remove_region(bool from_head);
 
+  // Removes the first region preferably placed on the given NUMA node,
+  // searching at most max_search_depth entries from the head or tail
+  // based on from_head. Returns NULL if no such region was found.
+  HeapRegion* remove_region_with_node_index(bool from_head,
+                                            uint requested_node_index,
+                                            uint max_search_depth);
+
   // Merge two ordered lists. The result is also ordered. The order is
   // determined by hrm_index.
   void add_ordered(FreeRegionList* from_list);
@@ -256,6 +294,12 @@ public:
   // Num_regions must be > 1.
   void remove_starting_at(HeapRegion* first, uint num_regions);
 
+  // Returns the number of regions in the list that are preferably placed
+  // on the given NUMA node, or the total length if no per-node
+  // information is maintained.
+  inline uint length(uint node_index) const;
+  using HeapRegionSetBase::length;
+
   virtual void verify();
 
   virtual void print_on(outputStream* out, bool print_contents = false);
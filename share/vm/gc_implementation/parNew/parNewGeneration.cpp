@@ -823,17 +823,18 @@ public:
 };
 
 
-void ParNewRefProcTaskExecutor::execute(ProcessTask& task)
+void ParNewRefProcTaskExecutor::execute(ProcessTask& task, uint ergo_workers)
 {
   GenCollectedHeap* gch = GenCollectedHeap::heap();
   assert(gch->kind() == CollectedHeap::GenCollectedHeap,
          "not a generational heap");
   FlexibleWorkGang* workers = gch->workers();
   assert(workers != NULL, "Need parallel worker threads.");
-  _state_set.reset(workers->active_workers(), _generation.promotion_failed());
+  uint n_workers = MIN2(ergo_workers, workers->active_workers());
+  _state_set.reset(n_workers, _generation.promotion_failed());
   ParNewRefProcTaskProxy rp_task(task, _generation, *_generation.next_gen(),
                                  _generation.reserved().end(), _state_set);
-  workers->run_task(&rp_task);
+  workers->run_task(&rp_task, n_workers);
   _state_set.reset(0 /* bad value in debug if not reset */,
                    _generation.promotion_failed());
 }
@@ -32,12 +32,15 @@
 #include "gc_implementation/parallelScavenge/psAdaptiveSizePolicy.hpp"
 #include "gc_implementation/parallelScavenge/psMarkSweep.hpp"
 #include "gc_implementation/parallelScavenge/psParallelCompact.hpp"
+#include "gc_implementation/parallelScavenge/psPeriodicGC.hpp"
 #include "gc_implementation/parallelScavenge/psPromotionManager.hpp"
 #include "gc_implementation/parallelScavenge/psScavenge.hpp"
 #include "gc_implementation/parallelScavenge/vmPSOperations.hpp"
 #include "gc_implementation/shared/gcHeapSummary.hpp"
 #include "gc_implementation/shared/gcWhen.hpp"
+#include "gc_implementation/shared/pretouchTask.hpp"
 #include "memory/gcLocker.inline.hpp"
+#include "memory/resourceArea.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/java.hpp"
@@ -86,6 +89,10 @@ jint ParallelScavengeHeap::initialize() {
     return JNI_ENOMEM;
   }
 
+  // Set up the GCTaskManager.  This is done before the generations are
+  // made so that their initial commit can be pre-touched in parallel.
+  _gc_task_manager = GCTaskManager::create(ParallelGCThreads);
+
   // Make up the generations
   // Calculate the maximum size that a generation can grow.  This
   // includes growth into the other generation.  Note that the
@@ -122,9 +129,6 @@ jint ParallelScavengeHeap::initialize() {
     new PSGCAdaptivePolicyCounters("ParScav:MSC", 2, 3, _size_policy);
   _psh = this;
 
-  // Set up the GCTaskManager
-  _gc_task_manager = GCTaskManager::create(ParallelGCThreads);
-
   if (UseParallelOldGC && !PSParallelCompact::initialize()) {
     return JNI_ENOMEM;
   }
@@ -141,6 +145,7 @@ void ParallelScavengeHeap::post_initialize() {
     PSMarkSweep::initialize();
   }
   PSPromotionManager::initialize();
+  PSPeriodicGC::initialize();
 }
 
 void ParallelScavengeHeap::update_counters() {
@@ -618,6 +623,47 @@ void ParallelScavengeHeap::gc_threads_do(ThreadClosure* tc) const {
   PSScavenge::gc_task_manager()->threads_do(tc);
 }
 
+// Touches one chunk of the memory being pre-touched.
+class PretouchGCTask : public GCTask {
+  char* const  _start;
+  char* const  _end;
+  const size_t _page_size;
+ public:
+  PretouchGCTask(char* start, char* end, size_t page_size) :
+    _start(start), _end(end), _page_size(page_size) { }
+
+  char* name() { return (char *)"pretouch-task"; }
+
+  void do_it(GCTaskManager* manager, uint which) {
+    os::pretouch_memory(_start, _end, _page_size);
+  }
+};
+
+// Like PretouchTask::pretouch(), but with the GC task threads.
+void ParallelScavengeHeap::pretouch_memory(char* start, char* end, size_t page_size) {
+  if (start >= end) {
+    return;
+  }
+  GCTaskManager* manager = gc_task_manager();
+  page_size = PretouchTask::setup_range(start, end, page_size);
+  size_t chunk_size = PretouchTask::chunk_size(page_size);
+  if (manager == NULL || ParallelGCThreads <= 1 ||
+      pointer_delta(end, start, sizeof(char)) <= chunk_size ||
+      !PretouchTask::can_use_workers()) {
+    os::pretouch_memory(start, end, page_size);
+    return;
+  }
+
+  ResourceMark rm;
+  GCTaskQueue* q = GCTaskQueue::create();
+  for (char* cur = start; cur < end; ) {
+    char* cur_end = cur + MIN2(chunk_size, pointer_delta(end, cur, sizeof(char)));
+    q->enqueue(new PretouchGCTask(cur, cur_end, page_size));
+    cur = cur_end;
+  }
+  manager->execute_and_wait(q);
+}
+
 void ParallelScavengeHeap::print_gc_threads_on(outputStream* st) const {
   PSScavenge::gc_task_manager()->print_threads_on(st);
 }
@@ -710,6 +756,50 @@ void ParallelScavengeHeap::resize_old_gen(size_t desired_free_space) {
   _old_gen->resize(desired_free_space);
 }
 
+// The old gen keeps MinHeapFreeRatio percent of its capacity free, as
+// the serial collectors' generations do after a full collection, and the
+// young gen shrinks towards its minimum size.  Shrinking the young gen
+// requires UseAdaptiveSizePolicy, which lays out its spaces.
+void ParallelScavengeHeap::shrink_after_periodic_gc() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at a safepoint");
+  const size_t old_before = old_gen()->capacity_in_bytes();
+  const size_t young_before = young_gen()->capacity_in_bytes();
+
+  size_t desired_free = old_gen()->max_gen_size();
+  if (MinHeapFreeRatio < 100) {
+    desired_free = (size_t)(old_gen()->used_in_bytes() *
+                            ((double)MinHeapFreeRatio / (100 - MinHeapFreeRatio)));
+  }
+  resize_old_gen(desired_free);
+
+  if (UseAdaptiveSizePolicy) {
+    PSYoungGen* young = young_gen();
+    // See the corresponding code in PSMarkSweep::invoke_no_policy().
+    if (young->from_space()->is_empty()) {
+      young->from_space()->clear(SpaceDecorator::Mangle);
+      young->swap_spaces();
+    }
+    size_t survivor_size = young->to_space()->capacity_in_bytes();
+    size_t eden_size = young->virtual_space()->alignment();
+    if (young->min_gen_size() > 2 * survivor_size + eden_size) {
+      eden_size = young->min_gen_size() - 2 * survivor_size;
+    }
+    resize_young_gen(eden_size, survivor_size);
+  }
+
+  if (UsePerfData) {
+    gc_policy_counters()->update_old_capacity(old_gen()->capacity_in_bytes());
+    gc_policy_counters()->update_young_capacity(young_gen()->capacity_in_bytes());
+  }
+  if (PrintGCDetails) {
+    gclog_or_tty->print_cr("[Periodic GC: old gen " SIZE_FORMAT "K->" SIZE_FORMAT "K,"
+                           " young gen " SIZE_FORMAT "K->" SIZE_FORMAT "K committed]",
+                           old_before / K, old_gen()->capacity_in_bytes() / K,
+                           young_before / K, young_gen()->capacity_in_bytes() / K);
+  }
+  PSPeriodicGC::periodic_gc_done();
+}
+
 ParallelScavengeHeap::ParStrongRootsScope::ParStrongRootsScope() {
   // nothing particular
 }
@@ -221,6 +221,7 @@ class ParallelScavengeHeap : public CollectedHeap {
   virtual void print_on_error(outputStream* st) const;
   virtual void print_gc_threads_on(outputStream* st) const;
   virtual void gc_threads_do(ThreadClosure* tc) const;
+  virtual void pretouch_memory(char* start, char* end, size_t page_size);
   virtual void print_tracing_info() const;
 
   void verify(bool silent, VerifyOption option /* ignored */);
@@ -235,6 +236,10 @@ class ParallelScavengeHeap : public CollectedHeap {
   // generation may be expanded in preparation for the resize.
   void resize_old_gen(size_t desired_free_space);
 
+  // Uncommit the free parts of the generations after a periodic
+  // collection of an idle heap (PSPeriodicGCInterval).
+  void shrink_after_periodic_gc();
+
   // Save the tops of the spaces in all generations
   void record_gen_tops_before_GC() PRODUCT_RETURN;
 
@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#include "precompiled.hpp"
+#include "gc_implementation/parallelScavenge/parallelScavengeHeap.hpp"
+#include "gc_implementation/parallelScavenge/psPeriodicGC.hpp"
+#include "gc_interface/gcCause.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "runtime/safepoint.hpp"
+#include "runtime/task.hpp"
+
+volatile bool PSPeriodicGC::_has_pending_request = false;
+uint          PSPeriodicGC::_last_gc_count = 0;
+jlong         PSPeriodicGC::_last_gc_time_ms = 0;
+volatile uint PSPeriodicGC::_periodic_gc_count = 0;
+
+// The interval of the task is at most PeriodicTask::max_interval, so
+// longer PSPeriodicGCIntervals are checked a few times per interval.
+class PSPeriodicGCTask : public PeriodicTask {
+ public:
+  PSPeriodicGCTask(size_t interval_time) : PeriodicTask(interval_time) {}
+
+  virtual void task() {
+    PSPeriodicGC::check_for_idle_heap();
+  }
+};
+
+void PSPeriodicGC::initialize() {
+  if (PSPeriodicGCInterval == 0) {
+    return;
+  }
+  size_t interval = MIN2((size_t)PSPeriodicGCInterval, (size_t)PeriodicTask::max_interval);
+  interval = MAX2((size_t)align_size_down(interval, PeriodicTask::interval_gran),
+                  (size_t)PeriodicTask::min_interval);
+  _last_gc_count = Universe::heap()->total_collections();
+  _last_gc_time_ms = os::javaTimeNanos() / NANOSECS_PER_MILLISEC;
+  PSPeriodicGCTask* task = new PSPeriodicGCTask(interval);
+  task->enroll();
+}
+
+void PSPeriodicGC::check_for_idle_heap() {
+  // Racy read of the collection count; a missed update only delays
+  // the periodic collection.
+  uint gc_count = Universe::heap()->total_collections();
+  jlong now = os::javaTimeNanos() / NANOSECS_PER_MILLISEC;
+  if (gc_count != _last_gc_count) {
+    _last_gc_count = gc_count;
+    _last_gc_time_ms = now;
+    return;
+  }
+  if (now - _last_gc_time_ms < (jlong)PSPeriodicGCInterval) {
+    return;
+  }
+  if (gc_count == _periodic_gc_count) {
+    // Nothing has been collected since the last periodic collection,
+    // which already shrunk the heap.
+    return;
+  }
+  if (PSPeriodicGCSystemLoadThreshold > 0) {
+    double load = 0.0;
+    if (os::loadavg(&load, 1) != -1 && load > (double)PSPeriodicGCSystemLoadThreshold) {
+      if (PrintGCDetails && Verbose) {
+        gclog_or_tty->print_cr("Periodic GC skipped: system load %.2f above "
+                               UINTX_FORMAT, load, PSPeriodicGCSystemLoadThreshold);
+      }
+      return;
+    }
+  }
+
+  // Wait for another full interval before asking again.
+  _last_gc_time_ms = now;
+  MutexLockerEx ml(Service_lock, Mutex::_no_safepoint_check_flag);
+  _has_pending_request = true;
+  Service_lock->notify_all();
+}
+
+void PSPeriodicGC::do_periodic_gc() {
+  {
+    MutexLockerEx ml(Service_lock, Mutex::_no_safepoint_check_flag);
+    _has_pending_request = false;
+  }
+  // The collection is skipped if another one happens before it starts,
+  // in which case the heap was not idle after all.
+  Universe::heap()->collect(GCCause::_periodic_collection);
+}
+
+void PSPeriodicGC::periodic_gc_done() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at a safepoint");
+  _periodic_gc_count = Universe::heap()->total_collections();
+}
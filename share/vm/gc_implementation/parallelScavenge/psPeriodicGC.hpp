@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#ifndef SHARE_VM_GC_IMPLEMENTATION_PARALLELSCAVENGE_PSPERIODICGC_HPP
+#define SHARE_VM_GC_IMPLEMENTATION_PARALLELSCAVENGE_PSPERIODICGC_HPP
+
+#include "memory/allocation.hpp"
+
+// Returns the unused parts of an idle heap to the OS (PSPeriodicGCInterval).
+//
+// A PeriodicTask run by the WatcherThread notices that no collection has
+// happened for PSPeriodicGCInterval milliseconds, and asks the
+// ServiceThread to do a full collection with cause
+// GCCause::_periodic_collection.  After that collection the generations
+// are shrunk by ParallelScavengeHeap::shrink_after_periodic_gc().
+
+class PSPeriodicGC : AllStatic {
+  friend class PSPeriodicGCTask;
+
+  static volatile bool _has_pending_request;
+
+  // State of the periodic task, only accessed by the WatcherThread.
+  static uint  _last_gc_count;    // total_collections() when last checked
+  static jlong _last_gc_time_ms;  // When _last_gc_count was last changed
+
+  // total_collections() after the last periodic collection.
+  static volatile uint _periodic_gc_count;
+
+  static void check_for_idle_heap();
+
+ public:
+  static void initialize();
+
+  // Called by the ServiceThread with the Service_lock held.
+  static bool has_pending_request() { return _has_pending_request; }
+
+  // Called by the ServiceThread to do the requested collection.
+  static void do_periodic_gc();
+
+  // Called at the end of a periodic collection.
+  static void periodic_gc_done();
+};
+
+#endif // SHARE_VM_GC_IMPLEMENTATION_PARALLELSCAVENGE_PSPERIODICGC_HPP
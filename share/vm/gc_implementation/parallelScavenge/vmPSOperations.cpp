@@ -52,7 +52,7 @@ void VM_ParallelGCFailedAllocation::doit() {
   }
 }
 
-// Only used for System.gc() calls
+// Only used for System.gc() calls and periodic collections
 VM_ParallelGCSystemGC::VM_ParallelGCSystemGC(uint gc_count,
                                              uint full_gc_count,
                                              GCCause::Cause gc_cause) :
@@ -74,5 +74,8 @@ void VM_ParallelGCSystemGC::doit() {
     heap->invoke_scavenge();
   } else {
     heap->do_full_collection(false);
+    if (_gc_cause == GCCause::_periodic_collection) {
+      heap->shrink_after_periodic_gc();
+    }
   }
 }
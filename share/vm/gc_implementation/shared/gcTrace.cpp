@@ -84,10 +84,10 @@ void GCTracer::report_gc_end(const Ticks& timestamp, TimePartitions* time_partit
 void GCTracer::report_gc_reference_stats(const ReferenceProcessorStats& rps) const {
   assert_set_gc_id();
 
-  send_reference_stats_event(REF_SOFT, rps.soft_count());
-  send_reference_stats_event(REF_WEAK, rps.weak_count());
-  send_reference_stats_event(REF_FINAL, rps.final_count());
-  send_reference_stats_event(REF_PHANTOM, rps.phantom_count());
+  send_reference_stats_event(REF_SOFT, rps.soft_count(), rps.soft_time_ms());
+  send_reference_stats_event(REF_WEAK, rps.weak_count(), rps.weak_time_ms());
+  send_reference_stats_event(REF_FINAL, rps.final_count(), rps.final_time_ms());
+  send_reference_stats_event(REF_PHANTOM, rps.phantom_count(), rps.phantom_time_ms());
 }
 
 #if INCLUDE_SERVICES
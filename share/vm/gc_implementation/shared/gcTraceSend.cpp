@@ -55,12 +55,13 @@ void GCTracer::send_garbage_collection_event() const {
   }
 }
 
-void GCTracer::send_reference_stats_event(ReferenceType type, size_t count) const {
+void GCTracer::send_reference_stats_event(ReferenceType type, size_t count, double time_ms) const {
   EventGCReferenceStatistics e;
   if (e.should_commit()) {
       e.set_gcId(_shared_gc_info.gc_id().id());
       e.set_type((u1)type);
       e.set_count(count);
+      e.set_time(time_ms);
       e.commit();
   }
 }
@@ -28,6 +28,8 @@
 #if INCLUDE_ALL_GCS
 #include "gc_implementation/shared/mutableSpace.hpp"
 #include "gc_implementation/shared/spaceDecorator.hpp"
+#include "gc_interface/collectedHeap.hpp"
+#include "memory/universe.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/safepoint.hpp"
 #include "runtime/thread.hpp"
@@ -63,7 +65,10 @@ void MutableSpace::numa_setup_pages(MemRegion mr, bool clear_space) {
 }
 
 void MutableSpace::pretouch_pages(MemRegion mr) {
-  os::pretouch_memory((char*)mr.start(), (char*)mr.end());
+  // Stride by the small page size: the space cannot tell whether its
+  // reservation actually got large pages, and touching every small page
+  // of a large page costs little once the first touch has faulted it in.
+  Universe::heap()->pretouch_memory((char*)mr.start(), (char*)mr.end(), os::vm_page_size());
 }
 
 void MutableSpace::initialize(MemRegion mr,
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#include "precompiled.hpp"
+#include "gc_implementation/shared/pretouchTask.hpp"
+#include "runtime/atomic.inline.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/init.hpp"
+#include "runtime/os.hpp"
+#include "runtime/safepoint.hpp"
+#include "runtime/thread.inline.hpp"
+
+PretouchTask::PretouchTask(const char* task_name, char* start_address,
+                           char* end_address, size_t page_size,
+                           size_t chunk_size) :
+  AbstractGangTask(task_name),
+  _cur_addr(start_address),
+  _end_addr(end_address),
+  _page_size(page_size),
+  _chunk_size(chunk_size) {
+  assert(chunk_size >= page_size, "chunk smaller than a page");
+}
+
+void PretouchTask::work(uint worker_id) {
+  while (true) {
+    char* touch_addr = (char*)Atomic::add_ptr((intptr_t)_chunk_size,
+                                              (volatile intptr_t*)&_cur_addr)
+                       - _chunk_size;
+    if (touch_addr >= _end_addr) {
+      break;
+    }
+    char* end_addr = touch_addr + MIN2(_chunk_size,
+                                       pointer_delta(_end_addr, touch_addr, sizeof(char)));
+    os::pretouch_memory(touch_addr, end_addr, _page_size);
+  }
+}
+
+bool PretouchTask::can_use_workers() {
+  Thread* thr = Thread::current();
+  if (thr->is_GC_task_thread() || thr->is_ConcurrentGC_thread()) {
+    return false;
+  }
+  if (thr->is_VM_thread()) {
+    return SafepointSynchronize::is_at_safepoint();
+  }
+  return !is_init_completed();
+}
+
+size_t PretouchTask::setup_range(char* start_address, char* end_address,
+                                 size_t page_size) {
+  if (UseTransparentHugePages) {
+    // Transparent huge pages are initially backed by small pages, so
+    // every one of those has to be touched.
+    os::realign_memory(start_address,
+                       pointer_delta(end_address, start_address, sizeof(char)),
+                       os::large_page_size());
+    return os::vm_page_size();
+  }
+  return page_size;
+}
+
+size_t PretouchTask::chunk_size(size_t page_size) {
+  return MAX2((size_t)align_size_up(PreTouchParallelChunkSize, page_size), page_size);
+}
+
+void PretouchTask::pretouch(const char* task_name, char* start_address,
+                            char* end_address, size_t page_size,
+                            FlexibleWorkGang* gang) {
+  if (start_address >= end_address) {
+    return;
+  }
+  page_size = setup_range(start_address, end_address, page_size);
+  size_t chunk = chunk_size(page_size);
+  size_t total = pointer_delta(end_address, start_address, sizeof(char));
+
+  if (gang == NULL || gang->total_workers() <= 1 || total <= chunk ||
+      !can_use_workers()) {
+    os::pretouch_memory(start_address, end_address, page_size);
+    return;
+  }
+
+  uint saved_active_workers = gang->active_workers();
+  if (UseDynamicNumberOfGCThreads) {
+    size_t num_chunks = (total + chunk - 1) / chunk;
+    gang->set_active_workers((uint)MIN2(num_chunks, (size_t)gang->total_workers()));
+  }
+  PretouchTask task(task_name, start_address, end_address, page_size, chunk);
+  gang->run_task(&task);
+  if (UseDynamicNumberOfGCThreads) {
+    gang->set_active_workers(saved_active_workers);
+  }
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#ifndef SHARE_VM_GC_IMPLEMENTATION_SHARED_PRETOUCHTASK_HPP
+#define SHARE_VM_GC_IMPLEMENTATION_SHARED_PRETOUCHTASK_HPP
+
+#include "utilities/workgroup.hpp"
+
+// Pre-touches a range of freshly committed memory (AlwaysPreTouch).  The
+// range is split into chunks of PreTouchParallelChunkSize bytes which are
+// claimed by the workers of a gang.
+class PretouchTask : public AbstractGangTask {
+  char* volatile _cur_addr;
+  char* const    _end_addr;
+  const size_t   _page_size;
+  const size_t   _chunk_size;
+
+ public:
+  PretouchTask(const char* task_name, char* start_address, char* end_address,
+               size_t page_size, size_t chunk_size);
+
+  virtual void work(uint worker_id);
+
+  // Whether the current thread may hand pre-touching to the GC worker
+  // threads and wait for them: only the VM thread at a safepoint, and
+  // the thread initializing the heap, can.  GC worker threads expanding
+  // the heap in the middle of a collection touch the memory themselves.
+  static bool can_use_workers();
+
+  // Advises the OS to back [start_address, end_address) with transparent
+  // huge pages if those are used, and returns the stride with which the
+  // range has to be touched.  "page_size" is the size of the pages the
+  // range is committed with.
+  static size_t setup_range(char* start_address, char* end_address,
+                            size_t page_size);
+
+  // The size of the chunks handed to each worker, a multiple of page_size.
+  static size_t chunk_size(size_t page_size);
+
+  // Touches [start_address, end_address), using the workers of "gang"
+  // if it is non-NULL, the range is large enough and can_use_workers().
+  static void pretouch(const char* task_name, char* start_address,
+                       char* end_address, size_t page_size,
+                       FlexibleWorkGang* gang);
+};
+
+#endif // SHARE_VM_GC_IMPLEMENTATION_SHARED_PRETOUCHTASK_HPP
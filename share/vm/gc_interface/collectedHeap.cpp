@@ -28,11 +28,13 @@
 #include "gc_implementation/shared/gcTrace.hpp"
 #include "gc_implementation/shared/gcTraceTime.hpp"
 #include "gc_implementation/shared/gcWhen.hpp"
+#include "gc_implementation/shared/pretouchTask.hpp"
 #include "gc_implementation/shared/vmGCOperations.hpp"
 #include "gc_interface/allocTracer.hpp"
 #include "gc_interface/collectedHeap.hpp"
 #include "gc_interface/collectedHeap.inline.hpp"
 #include "memory/barrierSet.inline.hpp"
+#include "memory/gcLocker.inline.hpp"
 #include "memory/metaspace.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/instanceMirrorKlass.hpp"
@@ -133,6 +135,10 @@ void CollectedHeap::print_on_error(outputStream* st) const {
   _barrier_set->print_on(st);
 }
 
+void CollectedHeap::pretouch_memory(char* start, char* end, size_t page_size) {
+  PretouchTask::pretouch("Pretouch", start, end, page_size, NULL /* gang */);
+}
+
 void CollectedHeap::register_nmethod(nmethod* nm) {
   assert_locked_or_safepoint(CodeCache_lock);
 }
@@ -198,6 +204,15 @@ CollectedHeap::CollectedHeap() : _n_par_threads(0)
 // vm thread. It collects the heap assuming that the
 // heap lock is already held and that we are executing in
 // the context of the vm thread.
+oop CollectedHeap::pin_object(JavaThread* thread, oop obj) {
+  GC_locker::lock_critical(thread);
+  return obj;
+}
+
+void CollectedHeap::unpin_object(JavaThread* thread, oop obj) {
+  GC_locker::unlock_critical(thread);
+}
+
 void CollectedHeap::collect_as_vm_thread(GCCause::Cause cause) {
   assert(Thread::current()->is_VM_thread(), "Precondition#1");
   assert(Heap_lock->is_locked(), "Precondition#2");
@@ -272,6 +287,18 @@ void CollectedHeap::check_for_valid_allocation_state() {
 
 HeapWord* CollectedHeap::allocate_from_tlab_slow(KlassHandle klass, Thread* thread, size_t size) {
 
+  // The end was lowered to a sample point: this allocation is sampled.
+  // Restore the end and allocate from the rest of the TLAB if it fits;
+  // the next sample point is set once the object is initialized.
+  if (thread->tlab().end_reached_sample_point()) {
+    thread->heap_sampler().set_sample_pending();
+    thread->tlab().set_back_allocation_end();
+    HeapWord* obj = thread->tlab().allocate(size);
+    if (obj != NULL) {
+      return obj;
+    }
+  }
+
   // Retain tlab and allocate object in shared space if
   // the amount free in the tlab is too large to discard.
   if (thread->tlab().free() > thread->tlab().refill_waste_limit()) {
@@ -154,6 +154,9 @@ class CollectedHeap : public CHeapObj<mtInternal> {
 
   inline static void post_allocation_setup_obj(KlassHandle klass, HeapWord* obj, int size);
 
+  // Takes a pending heap sample of the initialized object; may safepoint.
+  inline static oop post_allocation_sample(oop obj, int size, Thread* thread);
+
   inline static void post_allocation_setup_array(KlassHandle klass,
                                                  HeapWord* obj, int length);
 
@@ -189,7 +192,8 @@ class CollectedHeap : public CHeapObj<mtInternal> {
     SharedHeap,
     GenCollectedHeap,
     ParallelScavengeHeap,
-    G1CollectedHeap
+    G1CollectedHeap,
+    EpsilonHeap
   };
 
   static inline size_t filler_array_max_size() {
@@ -462,6 +466,13 @@ class CollectedHeap : public CHeapObj<mtInternal> {
   // Does this heap support heap inspection (+PrintClassHistogram?)
   virtual bool supports_heap_inspection() const = 0;
 
+  // Keep obj at its current address until the matching unpin_object()
+  // call; used by the JNI Get/Release*Critical functions. The default
+  // implementation enters the GC_locker, blocking all collections while
+  // any object is pinned. Returns the object to use.
+  virtual oop pin_object(JavaThread* thread, oop obj);
+  virtual void unpin_object(JavaThread* thread, oop obj);
+
   // Perform a collection of the heap; intended for use in implementing
   // "System.gc".  This probably implies as full a collection as the
   // "CollectedHeap" supports.
@@ -587,6 +598,12 @@ class CollectedHeap : public CHeapObj<mtInternal> {
   // Iterator for all GC threads (other than VM thread)
   virtual void gc_threads_do(ThreadClosure* tc) const = 0;
 
+  // Pre-touch the freshly committed memory [start, end), which is backed
+  // by pages of "page_size" bytes (AlwaysPreTouch).  Heaps with parallel
+  // GC threads split the work among them when the current thread can
+  // wait for them.  The default touches the memory serially.
+  virtual void pretouch_memory(char* start, char* end, size_t page_size);
+
   // Print any relevant tracing info that flags imply.
   // Default implementation does nothing.
   virtual void print_tracing_info() const = 0;
@@ -27,6 +27,7 @@
 
 #include "gc_interface/allocTracer.hpp"
 #include "gc_interface/collectedHeap.hpp"
+#include "memory/heapSampler.hpp"
 #include "memory/threadLocalAllocBuffer.inline.hpp"
 #include "memory/universe.hpp"
 #include "oops/arrayOop.hpp"
@@ -85,6 +86,14 @@ inline void post_allocation_notify(KlassHandle klass, oop obj, int size) {
   }
 }
 
+// Support for heap sampling
+oop CollectedHeap::post_allocation_sample(oop obj, int size, Thread* thread) {
+  if (thread->heap_sampler().sample_pending()) {
+    return HeapSampler::sample_allocation(obj, size, thread);
+  }
+  return obj;
+}
+
 void CollectedHeap::post_allocation_setup_obj(KlassHandle klass,
                                               HeapWord* obj,
                                               int size) {
@@ -139,6 +148,7 @@ HeapWord* CollectedHeap::common_mem_allocate_noinit(KlassHandle klass, size_t si
     assert(!HAS_PENDING_EXCEPTION,
            "Unexpected exception, will result in uninitialized storage");
     THREAD->incr_allocated_bytes(size * HeapWordSize);
+    THREAD->heap_sampler().check_outside_tlab(size * HeapWordSize);
 
     AllocTracer::send_allocation_outside_tlab_event(klass, size * HeapWordSize);
 
@@ -203,7 +213,7 @@ oop CollectedHeap::obj_allocate(KlassHandle klass, int size, TRAPS) {
   HeapWord* obj = common_mem_allocate_init(klass, size, CHECK_NULL);
   post_allocation_setup_obj(klass, obj, size);
   NOT_PRODUCT(Universe::heap()->check_for_bad_heap_word_value(obj, size));
-  return (oop)obj;
+  return post_allocation_sample((oop)obj, size, THREAD);
 }
 
 oop CollectedHeap::array_allocate(KlassHandle klass,
@@ -216,7 +226,7 @@ oop CollectedHeap::array_allocate(KlassHandle klass,
   HeapWord* obj = common_mem_allocate_init(klass, size, CHECK_NULL);
   post_allocation_setup_array(klass, obj, length);
   NOT_PRODUCT(Universe::heap()->check_for_bad_heap_word_value(obj, size));
-  return (oop)obj;
+  return post_allocation_sample((oop)obj, size, THREAD);
 }
 
 oop CollectedHeap::array_allocate_nozero(KlassHandle klass,
@@ -233,7 +243,7 @@ oop CollectedHeap::array_allocate_nozero(KlassHandle klass,
   const size_t hs = oopDesc::header_size()+1;
   Universe::heap()->check_for_non_bad_heap_word_value(obj+hs, size-hs);
 #endif
-  return (oop)obj;
+  return post_allocation_sample((oop)obj, size, THREAD);
 }
 
 inline void CollectedHeap::oop_iterate_no_header(OopClosure* cl) {
@@ -103,6 +103,9 @@ const char* GCCause::to_string(GCCause::Cause cause) {
     case _last_ditch_collection:
       return "Last ditch collection";
 
+    case _periodic_collection:
+      return "Periodic Collection";
+
     case _last_gc_cause:
       return "ILLEGAL VALUE - last gc cause - ILLEGAL VALUE";
 
@@ -0,0 +1,319 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#include "precompiled.hpp"
+#include "memory/heapSampler.hpp"
+#include "memory/resourceArea.hpp"
+#include "memory/threadLocalAllocBuffer.inline.hpp"
+#include "oops/oop.inline.hpp"
+#include "prims/jvmtiExport.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "runtime/thread.inline.hpp"
+#include "runtime/vframe.hpp"
+#include "utilities/preserveException.hpp"
+#include "utilities/quickSort.hpp"
+
+#include <math.h>
+
+ThreadHeapSampler::ThreadHeapSampler() :
+  _bytes_until_sample(0),
+  _rnd(0),
+  _sample_pending(false),
+  _in_sample(false),
+  _pending_post(NULL) {
+  // Seed every thread differently so that threads do not sample in lockstep.
+  _rnd = (julong)(uintptr_t)this ^ (julong)os::javaTimeNanos();
+  if (_rnd == 0) {
+    _rnd = 1;
+  }
+  pick_next_sample();
+}
+
+// xorshift64*
+julong ThreadHeapSampler::next_random() {
+  julong x = _rnd;
+  x ^= x >> 12;
+  x ^= x << 25;
+  x ^= x >> 27;
+  _rnd = x;
+  return x * CONST64(2685821657736338717);
+}
+
+void ThreadHeapSampler::pick_next_sample() {
+  size_t mean = HeapSampler::interval();
+  if (mean == 0) {
+    // Sample every allocation.
+    _bytes_until_sample = 0;
+    return;
+  }
+  // Inverse transform of a uniform value in (0, 1] drawn from the top 53
+  // bits of the generator; the result is at most ~37 times the mean.
+  double q = (double)((next_random() >> 11) + 1) / (double)(CONST64(1) << 53);
+  double distance = -log(q) * (double)mean;
+  _bytes_until_sample = MAX2((size_t)distance, (size_t)HeapWordSize);
+}
+
+void ThreadHeapSampler::oops_do(OopClosure* f) {
+  f->do_oop(&_pending_post);
+}
+
+void ThreadHeapSampler::check_outside_tlab(size_t bytes) {
+  if (!HeapSampler::enabled()) {
+    return;
+  }
+  if (bytes >= _bytes_until_sample) {
+    _bytes_until_sample = 0;
+    set_sample_pending();
+  } else {
+    _bytes_until_sample -= bytes;
+  }
+}
+
+// Allocation site table for GC.heap_samples. A site is the class of the
+// sampled object and the top frames of the allocating stack; symbols are
+// kept alive by reference counts until the table is reset.
+
+struct HeapSampleFrame {
+  Symbol* _holder;
+  Symbol* _name;
+  int     _line;
+};
+
+struct HeapSampleSite {
+  enum { max_frames = 8 };
+
+  unsigned        _hash;
+  Symbol*         _klass;
+  int             _depth;
+  HeapSampleFrame _frames[max_frames];
+  jlong           _samples;
+  jlong           _sampled_bytes;
+  jlong           _estimated_bytes;
+
+  bool same_site(const HeapSampleSite* other) const {
+    if (_hash != other->_hash || _klass != other->_klass || _depth != other->_depth) {
+      return false;
+    }
+    for (int i = 0; i < _depth; i++) {
+      if (_frames[i]._holder != other->_frames[i]._holder ||
+          _frames[i]._name   != other->_frames[i]._name   ||
+          _frames[i]._line   != other->_frames[i]._line) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+static const int       heap_sample_table_size = 2048;  // power of two
+static const int       heap_sample_max_sites  = heap_sample_table_size / 2;
+static HeapSampleSite* _heap_sample_table     = NULL;
+static int             _heap_sample_sites     = 0;
+static jlong           _heap_samples          = 0;
+static jlong           _heap_samples_dropped  = 0;
+
+void HeapSampler::record_sample(oop obj, size_t size_in_bytes, JavaThread* thread) {
+  ResourceMark rm(thread);
+  HeapSampleSite site;
+  site._klass = obj->klass()->name();
+  site._depth = 0;
+  unsigned hash = (unsigned)((uintptr_t)site._klass >> LogBytesPerWord);
+  if (thread->has_last_Java_frame()) {
+    for (vframeStream vfst(thread); !vfst.at_end() && site._depth < HeapSampleSite::max_frames; vfst.next()) {
+      Method* m = vfst.method();
+      HeapSampleFrame* f = &site._frames[site._depth++];
+      f->_holder = m->klass_name();
+      f->_name = m->name();
+      f->_line = m->line_number_from_bci(vfst.bci());
+      hash = 31 * hash + (unsigned)((uintptr_t)f->_name >> LogBytesPerWord);
+      hash = 31 * hash + (unsigned)f->_line;
+    }
+  }
+  site._hash = hash;
+
+  MutexLockerEx ml(HeapSampler_lock, Mutex::_no_safepoint_check_flag);
+  if (_heap_sample_table == NULL) {
+    _heap_sample_table = NEW_C_HEAP_ARRAY(HeapSampleSite, heap_sample_table_size, mtInternal);
+    memset(_heap_sample_table, 0, heap_sample_table_size * sizeof(HeapSampleSite));
+  }
+  _heap_samples++;
+
+  int index = hash & (heap_sample_table_size - 1);
+  HeapSampleSite* slot = &_heap_sample_table[index];
+  while (slot->_samples != 0 && !slot->same_site(&site)) {
+    index = (index + 1) & (heap_sample_table_size - 1);
+    slot = &_heap_sample_table[index];
+  }
+  if (slot->_samples == 0) {
+    if (_heap_sample_sites >= heap_sample_max_sites) {
+      _heap_samples_dropped++;
+      return;
+    }
+    _heap_sample_sites++;
+    *slot = site;
+    slot->_klass->increment_refcount();
+    for (int i = 0; i < slot->_depth; i++) {
+      slot->_frames[i]._holder->increment_refcount();
+      slot->_frames[i]._name->increment_refcount();
+    }
+  }
+  slot->_samples++;
+  slot->_sampled_bytes += size_in_bytes;
+  // Each sample stands for one sampling interval's worth of allocation.
+  slot->_estimated_bytes += MAX2(size_in_bytes, interval());
+}
+
+bool HeapSampler::is_available() {
+#ifdef COMPILER1
+  if (UseTLAB && FastTLABRefill) {
+    return false;
+  }
+#endif
+  return true;
+}
+
+bool HeapSampler::enabled() {
+  return (UseHeapSampling || JvmtiExport::should_post_sampled_object_alloc()) &&
+         is_available();
+}
+
+oop HeapSampler::sample_allocation(oop obj, size_t size_in_words, Thread* thread) {
+  ThreadHeapSampler& sampler = thread->heap_sampler();
+  sampler.clear_sample_pending();
+  sampler.pick_next_sample();
+  if (UseTLAB && thread->tlab().end() != NULL) {
+    thread->tlab().set_sample_end();
+  }
+
+  if (!enabled() || !thread->is_Java_thread() || thread->is_Compiler_thread()) {
+    return obj;
+  }
+  JavaThread* jt = (JavaThread*)thread;
+  size_t size_in_bytes = size_in_words * HeapWordSize;
+
+  sampler.set_in_sample(true);
+  if (UseHeapSampling) {
+    record_sample(obj, size_in_bytes, jt);
+  }
+  // The allocation may be nested in arbitrary VM locks and the agent runs
+  // Java code, so only remember the object here. If an earlier sample of
+  // the same VM entry is still waiting, this one is not posted.
+  if (JvmtiExport::should_post_sampled_object_alloc() && !sampler.has_pending_post()) {
+    sampler.set_pending_post(obj);
+  }
+  sampler.set_in_sample(false);
+  return obj;
+}
+
+void HeapSampler::post_pending_sample(JavaThread* thread) {
+  ThreadHeapSampler& sampler = thread->heap_sampler();
+  assert(sampler.has_pending_post(), "no pending sample");
+  assert(thread->thread_state() == _thread_in_vm, "must be in vm state");
+  HandleMark hm(thread);
+  Handle h_obj(thread, sampler.pending_post());
+  sampler.clear_pending_post();
+  if (!JvmtiExport::should_post_sampled_object_alloc()) {
+    return;
+  }
+  // The entry may be returning with an exception pending.
+  WeakPreserveExceptionMark wem(thread);
+  sampler.set_in_sample(true);
+  JvmtiExport::post_sampled_object_alloc(thread, h_obj());
+  sampler.set_in_sample(false);
+}
+
+static int compare_heap_sample_sites(HeapSampleSite* a, HeapSampleSite* b) {
+  if (a->_estimated_bytes > b->_estimated_bytes) {
+    return -1;
+  } else if (a->_estimated_bytes < b->_estimated_bytes) {
+    return 1;
+  }
+  return 0;
+}
+
+void HeapSampler::print_samples(outputStream* st) {
+  if (!UseHeapSampling) {
+    st->print_cr("Heap sampling is not enabled, use -XX:+UseHeapSampling");
+    return;
+  }
+  if (!is_available()) {
+    st->print_cr("Heap sampling is not available with -XX:+FastTLABRefill");
+    return;
+  }
+  ResourceMark rm;
+  MutexLockerEx ml(HeapSampler_lock, Mutex::_no_safepoint_check_flag);
+  st->print_cr("Heap samples (interval " SIZE_FORMAT " bytes): " JLONG_FORMAT " samples at %d sites, "
+               JLONG_FORMAT " dropped", interval(), _heap_samples, _heap_sample_sites,
+               _heap_samples_dropped);
+  if (_heap_sample_sites == 0) {
+    return;
+  }
+
+  HeapSampleSite** sites = NEW_RESOURCE_ARRAY(HeapSampleSite*, _heap_sample_sites);
+  int n = 0;
+  for (int i = 0; i < heap_sample_table_size; i++) {
+    if (_heap_sample_table[i]._samples != 0) {
+      sites[n++] = &_heap_sample_table[i];
+    }
+  }
+  assert(n == _heap_sample_sites, "site count mismatch");
+  QuickSort::sort<HeapSampleSite*>(sites, n, compare_heap_sample_sites, false);
+
+  st->print_cr("%10s %14s %14s  %s", "samples", "sampled bytes", "est. bytes", "class");
+  for (int i = 0; i < n; i++) {
+    HeapSampleSite* site = sites[i];
+    st->print_cr(INT64_FORMAT_W(10) " " INT64_FORMAT_W(14) " " INT64_FORMAT_W(14) "  %s",
+                 site->_samples, site->_sampled_bytes, site->_estimated_bytes,
+                 site->_klass->as_klass_external_name());
+    for (int j = 0; j < site->_depth; j++) {
+      HeapSampleFrame* f = &site->_frames[j];
+      st->print_cr("%42s at %s.%s(line %d)", "", f->_holder->as_klass_external_name(),
+                   f->_name->as_C_string(), f->_line);
+    }
+  }
+}
+
+void HeapSampler::reset_samples() {
+  MutexLockerEx ml(HeapSampler_lock, Mutex::_no_safepoint_check_flag);
+  if (_heap_sample_table == NULL) {
+    return;
+  }
+  for (int i = 0; i < heap_sample_table_size; i++) {
+    HeapSampleSite* site = &_heap_sample_table[i];
+    if (site->_samples != 0) {
+      site->_klass->decrement_refcount();
+      for (int j = 0; j < site->_depth; j++) {
+        site->_frames[j]._holder->decrement_refcount();
+        site->_frames[j]._name->decrement_refcount();
+      }
+    }
+  }
+  memset(_heap_sample_table, 0, heap_sample_table_size * sizeof(HeapSampleSite));
+  _heap_sample_sites = 0;
+  _heap_samples = 0;
+  _heap_samples_dropped = 0;
+}
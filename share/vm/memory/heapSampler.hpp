@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#ifndef SHARE_VM_MEMORY_HEAPSAMPLER_HPP
+#define SHARE_VM_MEMORY_HEAPSAMPLER_HPP
+
+#include "memory/allocation.hpp"
+#include "oops/oop.hpp"
+#include "runtime/globals.hpp"
+
+// Heap sampling: every thread samples one of its allocations every
+// HeapSamplingInterval bytes on average. The distance to the next sample
+// point is drawn from an exponential distribution so that the sample points
+// do not line up with allocation patterns. Within a TLAB the sample point is
+// folded into the TLAB end, so allocations that do not cross it keep taking
+// the inline fast paths; see ThreadLocalAllocBuffer::set_sample_end().
+//
+// A sample records the allocation site in a table reported by the
+// GC.heap_samples diagnostic command (-XX:+UseHeapSampling) and/or posts the
+// com.sun.hotspot.events.SampledObjectAlloc JVMTI extension event. The
+// event runs agent code, so it is not posted from inside the allocation;
+// the sampled object is kept in the thread and posted when the thread
+// leaves the VM entry it was allocated in (see ThreadInVMfromJava).
+
+class OopClosure;
+class outputStream;
+
+// Per thread sampling state, embedded in Thread.
+class ThreadHeapSampler VALUE_OBJ_CLASS_SPEC {
+ private:
+  size_t _bytes_until_sample;   // distance to the next sample point
+  julong _rnd;                  // xorshift state for pick_next_sample()
+  bool   _sample_pending;       // the current allocation crossed a sample point
+  bool   _in_sample;            // recording or posting a sample
+  oop    _pending_post;         // sampled object waiting for its JVMTI event
+
+  julong next_random();
+
+ public:
+  ThreadHeapSampler();
+
+  size_t bytes_until_sample() const { return _bytes_until_sample; }
+  void pick_next_sample();
+
+  // Account for bytes allocated without crossing a sample point.
+  void consume(size_t bytes) {
+    _bytes_until_sample = bytes < _bytes_until_sample ? _bytes_until_sample - bytes : 0;
+  }
+
+  // Account for an allocation outside of the TLAB.
+  void check_outside_tlab(size_t bytes);
+
+  bool sample_pending() const       { return _sample_pending; }
+  void set_sample_pending()         { _sample_pending = !_in_sample; }
+  void clear_sample_pending()       { _sample_pending = false; }
+
+  bool in_sample() const            { return _in_sample; }
+  void set_in_sample(bool value)    { _in_sample = value; }
+
+  bool has_pending_post() const     { return _pending_post != NULL; }
+  oop  pending_post() const         { return _pending_post; }
+  void set_pending_post(oop obj)    { _pending_post = obj; }
+  void clear_pending_post()         { _pending_post = NULL; }
+
+  // GC support for the pending object.
+  void oops_do(OopClosure* f);
+};
+
+class HeapSampler : AllStatic {
+ private:
+  static void record_sample(oop obj, size_t size_in_bytes, JavaThread* thread);
+
+ public:
+  // C1's generated TLAB refill code bypasses the runtime and cannot place
+  // sample points, so sampling is unavailable with -XX:+FastTLABRefill.
+  static bool is_available();
+  static bool enabled();
+
+  // HeapSamplingInterval is manageable; a new interval takes effect at
+  // each thread's next sample point.
+  static size_t interval()          { return HeapSamplingInterval; }
+  static void set_interval(size_t interval) { HeapSamplingInterval = interval; }
+
+  // Take the pending sample for the just allocated and initialized object.
+  // Does not safepoint or call out to agents; returns the object.
+  static oop sample_allocation(oop obj, size_t size_in_words, Thread* thread);
+
+  // Post the SampledObjectAlloc event for the thread's pending object.
+  // Called on the way out of a VM entry, with no VM locks held.
+  static void post_pending_sample(JavaThread* thread);
+
+  static void print_samples(outputStream* st);
+  static void reset_samples();
+};
+
+#endif // SHARE_VM_MEMORY_HEAPSAMPLER_HPP
@@ -213,6 +213,7 @@ ReferenceProcessorStats ReferenceProcessor::process_discovered_references(
 
   // Soft references
   size_t soft_count = 0;
+  double soft_start = os::elapsedTime();
   {
     GCTraceTime tt("SoftReference", trace_time, false, gc_timer, gc_id);
     soft_count =
@@ -224,6 +225,7 @@ ReferenceProcessorStats ReferenceProcessor::process_discovered_references(
 
   // Weak references
   size_t weak_count = 0;
+  double weak_start = os::elapsedTime();
   {
     GCTraceTime tt("WeakReference", trace_time, false, gc_timer, gc_id);
     weak_count =
@@ -233,6 +235,7 @@ ReferenceProcessorStats ReferenceProcessor::process_discovered_references(
 
   // Final references
   size_t final_count = 0;
+  double final_start = os::elapsedTime();
   {
     GCTraceTime tt("FinalReference", trace_time, false, gc_timer, gc_id);
     final_count =
@@ -242,6 +245,7 @@ ReferenceProcessorStats ReferenceProcessor::process_discovered_references(
 
   // Phantom references
   size_t phantom_count = 0;
+  double phantom_start = os::elapsedTime();
   {
     GCTraceTime tt("PhantomReference", trace_time, false, gc_timer, gc_id);
     phantom_count =
@@ -255,6 +259,7 @@ ReferenceProcessorStats ReferenceProcessor::process_discovered_references(
       process_discovered_reflist(_discoveredCleanerRefs, NULL, false,
                                  is_alive, keep_alive, complete_gc, task_executor);
   }
+  double phantom_end = os::elapsedTime();
 
   // Weak global JNI references. It would make more sense (semantically) to
   // traverse these simultaneously with the regular weak references above, but
@@ -269,7 +274,11 @@ ReferenceProcessorStats ReferenceProcessor::process_discovered_references(
     process_phaseJNI(is_alive, keep_alive, complete_gc);
   }
 
-  return ReferenceProcessorStats(soft_count, weak_count, final_count, phantom_count);
+  return ReferenceProcessorStats(soft_count, weak_count, final_count, phantom_count,
+                                 (weak_start - soft_start) * MILLIUNITS,
+                                 (final_start - weak_start) * MILLIUNITS,
+                                 (phantom_start - final_start) * MILLIUNITS,
+                                 (phantom_end - phantom_start) * MILLIUNITS);
 }
 
 #ifndef PRODUCT
@@ -915,15 +924,32 @@ ReferenceProcessor::process_discovered_reflist(
   // of the test.
   bool must_balance = _discovery_is_mt;
 
+  size_t total_list_count = total_count(refs_lists);
+
+  // Use as many queues as the discovered references warrant; the
+  // references are balanced into the queues that are used and the task
+  // executor only runs that many workers. Even a single queue is still
+  // processed through the task executor: callers set up their closures
+  // and per-thread state for MT processing only.
+  uint saved_num_q = _num_q;
+  if (mt_processing) {
+    uint degree = ergo_proc_thread_count(total_list_count);
+    if (degree < _num_q) {
+      set_active_mt_degree(degree);
+      must_balance = true;
+    }
+  }
+
   if ((mt_processing && ParallelRefProcBalancingEnabled) ||
       must_balance) {
     balance_queues(refs_lists);
   }
 
-  size_t total_list_count = total_count(refs_lists);
-
   if (PrintReferenceGC && PrintGCDetails) {
     gclog_or_tty->print(", %u refs", total_list_count);
+    if (mt_processing) {
+      gclog_or_tty->print(", %u threads", _num_q);
+    }
   }
 
   // Phase 1 (soft refs only):
@@ -934,7 +960,7 @@ ReferenceProcessor::process_discovered_reflist(
   if (policy != NULL) {
     if (mt_processing) {
       RefProcPhase1Task phase1(*this, refs_lists, policy, true /*marks_oops_alive*/);
-      task_executor->execute(phase1);
+      task_executor->execute(phase1, _num_q);
     } else {
       for (uint i = 0; i < _max_num_q; i++) {
         process_phase1(refs_lists[i], policy,
@@ -950,7 +976,7 @@ ReferenceProcessor::process_discovered_reflist(
   // . Traverse the list and remove any refs whose referents are alive.
   if (mt_processing) {
     RefProcPhase2Task phase2(*this, refs_lists, !discovery_is_atomic() /*marks_oops_alive*/);
-    task_executor->execute(phase2);
+    task_executor->execute(phase2, _num_q);
   } else {
     for (uint i = 0; i < _max_num_q; i++) {
       process_phase2(refs_lists[i], is_alive, keep_alive, complete_gc);
@@ -961,7 +987,7 @@ ReferenceProcessor::process_discovered_reflist(
   // . Traverse the list and process referents as appropriate.
   if (mt_processing) {
     RefProcPhase3Task phase3(*this, refs_lists, clear_referent, true /*marks_oops_alive*/);
-    task_executor->execute(phase3);
+    task_executor->execute(phase3, _num_q);
   } else {
     for (uint i = 0; i < _max_num_q; i++) {
       process_phase3(refs_lists[i], clear_referent,
@@ -969,9 +995,18 @@ ReferenceProcessor::process_discovered_reflist(
     }
   }
 
+  set_active_mt_degree(saved_num_q);
   return total_list_count;
 }
 
+uint ReferenceProcessor::ergo_proc_thread_count(size_t ref_count) const {
+  if (ReferencesPerThread == 0) {
+    return _num_q;
+  }
+  size_t thread_count = 1 + (ref_count / ReferencesPerThread);
+  return (uint)MIN2(thread_count, (size_t)_num_q);
+}
+
 inline DiscoveredList* ReferenceProcessor::get_discovered_list(ReferenceType rt) {
   uint id = 0;
   // Determine the queue index to use for this object.
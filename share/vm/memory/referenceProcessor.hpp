@@ -392,6 +392,10 @@ class ReferenceProcessor : public CHeapObj<mtGC> {
   // Balances reference queues.
   void balance_queues(DiscoveredList ref_lists[]);
 
+  // Number of queues to process ref_count discovered references with,
+  // at least one per ReferencesPerThread references.
+  uint ergo_proc_thread_count(size_t ref_count) const;
+
   // Update (advance) the soft ref master clock field.
   void update_soft_ref_master_clock();
 
@@ -627,8 +631,10 @@ public:
   class ProcessTask;
   class EnqueueTask;
 
-  // Executes a task using worker threads.
-  virtual void execute(ProcessTask& task) = 0;
+  // Executes a task using worker threads.  A ProcessTask runs on at most
+  // ergo_workers threads; the references have been balanced into that
+  // many queues.
+  virtual void execute(ProcessTask& task, uint ergo_workers) = 0;
   virtual void execute(EnqueueTask& task) = 0;
 
   // Switch to single threaded mode.
@@ -30,28 +30,46 @@
 class ReferenceProcessor;
 
 // ReferenceProcessorStats contains statistics about how many references that
-// have been traversed when processing references during garbage collection.
+// have been traversed when processing references during garbage collection,
+// and how long processing each kind of reference took.
 class ReferenceProcessorStats {
   size_t _soft_count;
   size_t _weak_count;
   size_t _final_count;
   size_t _phantom_count;
 
+  double _soft_time_ms;
+  double _weak_time_ms;
+  double _final_time_ms;
+  double _phantom_time_ms;
+
  public:
   ReferenceProcessorStats() :
     _soft_count(0),
     _weak_count(0),
     _final_count(0),
-    _phantom_count(0) {}
+    _phantom_count(0),
+    _soft_time_ms(0.0),
+    _weak_time_ms(0.0),
+    _final_time_ms(0.0),
+    _phantom_time_ms(0.0) {}
 
   ReferenceProcessorStats(size_t soft_count,
                           size_t weak_count,
                           size_t final_count,
-                          size_t phantom_count) :
+                          size_t phantom_count,
+                          double soft_time_ms,
+                          double weak_time_ms,
+                          double final_time_ms,
+                          double phantom_time_ms) :
     _soft_count(soft_count),
     _weak_count(weak_count),
     _final_count(final_count),
-    _phantom_count(phantom_count)
+    _phantom_count(phantom_count),
+    _soft_time_ms(soft_time_ms),
+    _weak_time_ms(weak_time_ms),
+    _final_time_ms(final_time_ms),
+    _phantom_time_ms(phantom_time_ms)
   {}
 
   size_t soft_count() const {
@@ -69,5 +87,22 @@ class ReferenceProcessorStats {
   size_t phantom_count() const {
     return _phantom_count;
   }
+
+  double soft_time_ms() const {
+    return _soft_time_ms;
+  }
+
+  double weak_time_ms() const {
+    return _weak_time_ms;
+  }
+
+  double final_time_ms() const {
+    return _final_time_ms;
+  }
+
+  // Includes the Cleaner references, like phantom_count().
+  double phantom_time_ms() const {
+    return _phantom_time_ms;
+  }
 };
 #endif
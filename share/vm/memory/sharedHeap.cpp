@@ -26,6 +26,7 @@
 #include "classfile/stringTable.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "code/codeCache.hpp"
+#include "gc_implementation/shared/pretouchTask.hpp"
 #include "gc_interface/collectedHeap.inline.hpp"
 #include "memory/sharedHeap.hpp"
 #include "oops/oop.inline.hpp"
@@ -79,6 +80,10 @@ SharedHeap::SharedHeap(CollectorPolicy* policy_) :
   }
 }
 
+void SharedHeap::pretouch_memory(char* start, char* end, size_t page_size) {
+  PretouchTask::pretouch("GC Pretouch", start, end, page_size, workers());
+}
+
 int SharedHeap::n_termination() {
   return _process_strong_tasks->n_threads();
 }
@@ -229,6 +229,9 @@ public:
 
   FlexibleWorkGang* workers() const { return _workers; }
 
+  // Pre-touches memory with the workers() gang.
+  virtual void pretouch_memory(char* start, char* end, size_t page_size);
+
   // Invoke the "do_oop" method the closure "roots" on all root locations.
   // The "so" argument determines which roots the closure is applied to:
   // "SO_None" does none;
@@ -330,6 +330,7 @@ public:
 // - scanned_block_size()
 // - adjust_obj_size()
 // - obj_size()
+// - begin_compaction_section()
 // These functions are to be used exclusively by the scan_and_* function templates,
 // and must be defined for all (non-abstract) subclasses of CompactibleSpace.
 //
@@ -347,6 +348,9 @@ public:
 // Similar dependencies exist between
 //  - adjust_obj_size  and adjust_pointers()
 //  - obj_size         and compact().
+// An override of begin_compaction_section() lets a space compact itself as a
+// number of independent sections; it requires overrides of all three of
+// prepare_for_compaction(), adjust_pointers() and compact().
 //
 // Additionally, this also means that changes to block_size() or block_is_obj() that
 // should be effective during the compaction operations must provide a corresponding
@@ -367,6 +371,12 @@ private:
     return oop(addr)->size();
   }
 
+  // Called by scan_and_forward() for each free region "q" that is not
+  // made deadspace; returns the address where compaction continues.
+  inline HeapWord* begin_compaction_section(HeapWord* q, HeapWord* compact_top) {
+    return compact_top;
+  }
+
 public:
   CompactibleSpace() :
    _compaction_top(NULL), _next_compaction_space(NULL) {}
@@ -484,6 +494,19 @@ protected:
   template <class SpaceType>
   static inline void scan_and_compact(SpaceType* space);
 
+  // As above, but restricted to the objects in [q, t), where "q" is either
+  // bottom() or the start of a compaction section, and "t" is the start of
+  // the next section or _end_of_live.  Neither resets the space.
+  template <class SpaceType>
+  static inline void scan_and_adjust_pointers_range(SpaceType* space, HeapWord* q, HeapWord* t);
+
+  template <class SpaceType>
+  static inline void scan_and_compact_range(SpaceType* space, HeapWord* q, HeapWord* t);
+
+  // The part of scan_and_compact() that follows the copying of the objects.
+  template <class SpaceType>
+  static inline void reset_after_scan_and_compact(SpaceType* space);
+
   // Frequently calls scanned_block_is_obj() and scanned_block_size().
   // Requires the scan_limit() function.
   template <class SpaceType>
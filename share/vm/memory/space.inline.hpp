@@ -154,6 +154,9 @@ inline void CompactibleSpace::scan_and_forward(SpaceType* space, CompactPoint* c
 
       // otherwise, it really is a free region.
 
+      // the space may choose to start a new compaction section here.
+      compact_top = space->begin_compaction_section(q, compact_top);
+
       // for the previous LiveRange, record the end of the live objects.
       if (liveRange) {
         liveRange->set_end(q);
@@ -193,11 +196,14 @@ template <class SpaceType>
 inline void CompactibleSpace::scan_and_adjust_pointers(SpaceType* space) {
   // adjust all the interior pointers to point at the new locations of objects
   // Used by MarkSweep::mark_sweep_phase3()
+  // _end_of_live is established by "prepare_for_compaction".
+  scan_and_adjust_pointers_range(space, space->bottom(), space->_end_of_live);
+}
 
-  HeapWord* q = space->bottom();
-  HeapWord* t = space->_end_of_live;  // Established by "prepare_for_compaction".
-
+template <class SpaceType>
+inline void CompactibleSpace::scan_and_adjust_pointers_range(SpaceType* space, HeapWord* q, HeapWord* t) {
   assert(space->_first_dead <= space->_end_of_live, "Stands to reason, no?");
+  assert(space->bottom() <= q && t <= space->_end_of_live, "range out of bounds");
 
   if (q < t && space->_first_dead > q && !oop(q)->is_gc_marked()) {
     // we have a chunk of the space which hasn't moved and we've
@@ -258,10 +264,15 @@ template <class SpaceType>
 inline void CompactibleSpace::scan_and_compact(SpaceType* space) {
   // Copy all live objects to their new location
   // Used by MarkSweep::mark_sweep_phase4()
-  HeapWord*       q = space->bottom();
-  HeapWord* const t = space->_end_of_live;
+  scan_and_compact_range(space, space->bottom(), space->_end_of_live);
+  reset_after_scan_and_compact(space);
+}
+
+template <class SpaceType>
+inline void CompactibleSpace::scan_and_compact_range(SpaceType* space, HeapWord* q, HeapWord* const t) {
+  assert(space->bottom() <= q && t <= space->_end_of_live, "range out of bounds");
   debug_only(HeapWord* prev_q = NULL);
-  
+
   if (q < t && space->_first_dead > q && !oop(q)->is_gc_marked()) {
     #ifdef ASSERT // Debug only
       // we have a chunk of the space which hasn't moved and we've reinitialized
@@ -314,7 +325,11 @@ inline void CompactibleSpace::scan_and_compact(SpaceType* space) {
       q += size;
     }
   }
+  assert(q == t, "just checking");
+}
 
+template <class SpaceType>
+inline void CompactibleSpace::reset_after_scan_and_compact(SpaceType* space) {
   // Let's remember if we were empty before we did the compaction.
   bool was_empty = space->used_region().is_empty();
   // Reset space after compaction is complete
@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "memory/genCollectedHeap.hpp"
+#include "memory/heapSampler.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/threadLocalAllocBuffer.inline.hpp"
 #include "memory/universe.inline.hpp"
@@ -121,14 +122,22 @@ void ThreadLocalAllocBuffer::make_parsable(bool retire) {
     CollectedHeap::fill_with_object(top(), hard_end(), retire);
 
     if (retire || ZeroTLAB) {  // "Reset" the TLAB
+      // Carry what was allocated towards the next sample point over
+      // to the next TLAB.
+      if (HeapSampler::enabled()) {
+        myThread()->heap_sampler().consume(bytes_since_sample_start());
+      }
       set_start(NULL);
       set_top(NULL);
       set_pf_top(NULL);
       set_end(NULL);
+      set_allocation_end(NULL);
+      _sample_start = NULL;
     }
   }
   assert(!(retire || ZeroTLAB)  ||
-         (start() == NULL && end() == NULL && top() == NULL),
+         (start() == NULL && end() == NULL && top() == NULL &&
+          allocation_end() == NULL),
          "TLAB must be reset");
 }
 
@@ -179,10 +188,29 @@ void ThreadLocalAllocBuffer::fill(HeapWord* start,
   assert(top <= start + new_size - alignment_reserve(), "size too small");
   initialize(start, top, start + new_size - alignment_reserve());
 
+  if (HeapSampler::enabled()) {
+    set_sample_end();
+  }
+
   // Reset amount of internal fragmentation
   set_refill_waste_limit(initial_refill_waste_limit());
 }
 
+void ThreadLocalAllocBuffer::set_sample_end() {
+  _sample_start = top();
+  if (!HeapSampler::enabled()) {
+    set_back_allocation_end();
+    return;
+  }
+  size_t words_until_sample = myThread()->heap_sampler().bytes_until_sample() / HeapWordSize;
+  if (words_until_sample < pointer_delta(allocation_end(), top())) {
+    set_end(top() + words_until_sample);
+  } else {
+    set_back_allocation_end();
+  }
+  invariants();
+}
+
 void ThreadLocalAllocBuffer::initialize(HeapWord* start,
                                         HeapWord* top,
                                         HeapWord* end) {
@@ -190,6 +218,8 @@ void ThreadLocalAllocBuffer::initialize(HeapWord* start,
   set_top(top);
   set_pf_top(top);
   set_end(end);
+  set_allocation_end(end);
+  _sample_start = top;
   invariants();
 }
 
@@ -43,7 +43,9 @@ private:
   HeapWord* _start;                              // address of TLAB
   HeapWord* _top;                                // address after last allocation
   HeapWord* _pf_top;                             // allocation prefetch watermark
-  HeapWord* _end;                                // allocation end (excluding alignment_reserve)
+  HeapWord* _end;                                // allocation end, or the next sample point (excluding alignment_reserve)
+  HeapWord* _allocation_end;                     // end for allocations (excluding alignment_reserve)
+  HeapWord* _sample_start;                       // top when the current sampling distance was set
   size_t    _desired_size;                       // desired size   (including alignment_reserve)
   size_t    _refill_waste_limit;                 // hold onto tlab if free() is larger than this
   size_t    _allocated_before_last_gc;           // total bytes allocated up until the last gc
@@ -64,6 +66,7 @@ private:
 
   void set_start(HeapWord* start)                { _start = start; }
   void set_end(HeapWord* end)                    { _end = end; }
+  void set_allocation_end(HeapWord* ptr)         { _allocation_end = ptr; }
   void set_top(HeapWord* top)                    { _top = top; }
   void set_pf_top(HeapWord* pf_top)              { _pf_top = pf_top; }
   void set_desired_size(size_t desired_size)     { _desired_size = desired_size; }
@@ -82,7 +85,9 @@ private:
   // Resize based on amount of allocation, etc.
   void resize();
 
-  void invariants() const { assert(top() >= start() && top() <= end(), "invalid tlab"); }
+  void invariants() const {
+    assert(top() >= start() && top() <= end() && end() <= allocation_end(), "invalid tlab");
+  }
 
   void initialize(HeapWord* start, HeapWord* top, HeapWord* end);
 
@@ -112,13 +117,14 @@ public:
 
   HeapWord* start() const                        { return _start; }
   HeapWord* end() const                          { return _end; }
-  HeapWord* hard_end() const                     { return _end + alignment_reserve(); }
+  HeapWord* allocation_end() const               { return _allocation_end; }
+  HeapWord* hard_end() const                     { return _allocation_end + alignment_reserve(); }
   HeapWord* top() const                          { return _top; }
   HeapWord* pf_top() const                       { return _pf_top; }
   size_t desired_size() const                    { return _desired_size; }
   size_t used() const                            { return pointer_delta(top(), start()); }
   size_t used_bytes() const                      { return pointer_delta(top(), start(), 1); }
-  size_t free() const                            { return pointer_delta(end(), top()); }
+  size_t free() const                            { return pointer_delta(allocation_end(), top()); }
   // Don't discard tlab if remaining space is larger than this.
   size_t refill_waste_limit() const              { return _refill_waste_limit; }
 
@@ -159,11 +165,19 @@ public:
   void fill(HeapWord* start, HeapWord* top, size_t new_size);
   void initialize();
 
+  // Heap sampling support. The end is lowered to the thread's next
+  // sample point so that the allocation crossing it takes the slow path.
+  bool end_reached_sample_point() const          { return end() < allocation_end(); }
+  void set_sample_end();
+  void set_back_allocation_end()                 { _end = _allocation_end; }
+  size_t bytes_since_sample_start() const        { return pointer_delta(top(), _sample_start, 1); }
+
   static size_t refill_waste_limit_increment()   { return TLABWasteIncrement; }
 
   // Code generation support
   static ByteSize start_offset()                 { return byte_offset_of(ThreadLocalAllocBuffer, _start); }
   static ByteSize end_offset()                   { return byte_offset_of(ThreadLocalAllocBuffer, _end  ); }
+  static ByteSize allocation_end_offset()        { return byte_offset_of(ThreadLocalAllocBuffer, _allocation_end ); }
   static ByteSize top_offset()                   { return byte_offset_of(ThreadLocalAllocBuffer, _top  ); }
   static ByteSize pf_top_offset()                { return byte_offset_of(ThreadLocalAllocBuffer, _pf_top  ); }
   static ByteSize size_offset()                  { return byte_offset_of(ThreadLocalAllocBuffer, _desired_size ); }
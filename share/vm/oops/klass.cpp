@@ -188,6 +188,7 @@ Klass::Klass() {
 
   set_prototype_header(markOopDesc::prototype());
   set_biased_lock_revocation_count(0);
+  set_biased_lock_handoff_count(0);
   set_last_biased_lock_bulk_revocation_time(0);
 
   // The klass doesn't have any references at this point.
@@ -603,6 +604,10 @@ int Klass::atomic_incr_biased_lock_revocation_count() {
   return (int) Atomic::add(1, &_biased_lock_revocation_count);
 }
 
+int Klass::atomic_incr_biased_lock_handoff_count() {
+  return (int) Atomic::add(1, &_biased_lock_handoff_count);
+}
+
 // Unless overridden, jvmti_class_status has no flags set.
 jint Klass::jvmti_class_status() const {
   return 0;
@@ -141,6 +141,7 @@ class Klass : public Metadata {
   jlong    _last_biased_lock_bulk_revocation_time;
   markOop  _prototype_header;   // Used when biased locking is both enabled and disabled for this type
   jint     _biased_lock_revocation_count;
+  jint     _biased_lock_handoff_count;  // Revocations for other threads since the last bulk rebias
 
   TRACE_DEFINE_KLASS_TRACE_ID;
 
@@ -563,6 +564,10 @@ protected:
   // Atomically increments biased_lock_revocation_count and returns updated value
   int atomic_incr_biased_lock_revocation_count();
   void set_biased_lock_revocation_count(int val) { _biased_lock_revocation_count = (jint) val; }
+  int  biased_lock_handoff_count() const { return (int) _biased_lock_handoff_count; }
+  // Atomically increments biased_lock_handoff_count and returns updated value
+  int atomic_incr_biased_lock_handoff_count();
+  void set_biased_lock_handoff_count(int val) { _biased_lock_handoff_count = (jint) val; }
   jlong last_biased_lock_bulk_revocation_time() { return _last_biased_lock_bulk_revocation_time; }
   void  set_last_biased_lock_bulk_revocation_time(jlong cur_time) { _last_biased_lock_bulk_revocation_time = cur_time; }
 
@@ -318,6 +318,14 @@
   notproduct(bool, TraceLoopUnswitching, false,                             \
           "Trace loop unswitching")                                         \
                                                                             \
+  product(bool, UseCountedLoopSafepoints, false,                            \
+          "Keep a safepoint poll in counted loops by running them in "      \
+          "strips of LoopStripMiningIter iterations")                       \
+                                                                            \
+  product(uintx, LoopStripMiningIter, 1000,                                 \
+          "Number of iterations of a strip mined counted loop between "     \
+          "safepoint polls; 1 polls on every iteration")                    \
+                                                                            \
   product(bool, UseSuperWord, true,                                         \
           "Transform scalar operations into superword operations")          \
                                                                             \
@@ -2400,6 +2400,8 @@ bool IdealLoopTree::iteration_split( PhaseIdealLoop *phase, Node_List &old_new )
   // Gate unrolling, RCE and peeling efforts.
   if (!_child &&                // If not an inner loop, do not split
       !_irreducible &&
+      // Do not peel or unswitch the outer loop of a strip mined loop
+      !(_head->is_Loop() && _head->as_Loop()->is_strip_mined_outer()) &&
       _allow_optimizations &&
       !tail()->is_top()) {     // Also ignore the occasional dead backedge
     if (!_has_call) {
@@ -34,6 +34,7 @@
 #include "opto/divnode.hpp"
 #include "opto/idealGraphPrinter.hpp"
 #include "opto/loopnode.hpp"
+#include "opto/movenode.hpp"
 #include "opto/mulnode.hpp"
 #include "opto/rootnode.hpp"
 #include "opto/superword.hpp"
@@ -60,6 +61,7 @@ void LoopNode::dump_spec(outputStream *st) const {
   if (is_inner_loop()) st->print( "inner " );
   if (is_partial_peel_loop()) st->print( "partial_peel " );
   if (partial_peel_has_failed()) st->print( "partial_peel_failed " );
+  if (is_strip_mined_outer()) st->print( "strip_mined_outer " );
 }
 #endif
 
@@ -453,6 +455,31 @@ bool PhaseIdealLoop::is_counted_loop( Node *x, IdealLoopTree *loop ) {
   // ---- SUCCESS!   Found A Trip-Counted Loop!  -----
   //
   assert(x->Opcode() == Op_Loop, "regular loops only");
+
+  // Removing the poll from a loop that may run for long delays safepoints.
+  // With UseCountedLoopSafepoints the poll is moved to an outer loop that
+  // runs the counted loop in strips instead. Where strip mining does not
+  // apply the loop stays uncounted and keeps polling on every iteration;
+  // only loops that run at most LoopStripMiningIter iterations lose the poll.
+  Node* strip_sfpt = NULL;
+  if (UseCountedLoopSafepoints) {
+    Node* sfpt = x->in(LoopNode::LoopBackControl);
+    if (sfpt->Opcode() != Op_SafePoint) {
+      sfpt = iff->in(0);
+    }
+    jlong max_iters = (stride_con > 0) ?
+      ((jlong)limit_t->_hi - init_t->_lo) / stride_con :
+      ((jlong)limit_t->_lo - init_t->_hi) / stride_con;
+    if (sfpt->Opcode() == Op_SafePoint && is_deleteable_safept(sfpt) &&
+        max_iters > (jlong)LoopStripMiningIter) {
+      if (LoopStripMiningIter == 0 || bt == BoolTest::ne ||
+          !can_strip_mine_loop(x, iff, sfpt)) {
+        return false; // Keep polling on every iteration
+      }
+      strip_sfpt = sfpt;
+    }
+  }
+
   C->print_method(PHASE_BEFORE_CLOOPS, 3);
 
   Node *hook = new Node(6);
@@ -684,6 +711,12 @@ bool PhaseIdealLoop::is_counted_loop( Node *x, IdealLoopTree *loop ) {
 
   } // LoopLimitCheck
 
+  // The poll of a strip mined loop goes to the outer loop's backedge.
+  if (strip_sfpt != NULL) {
+    strip_sfpt = strip_sfpt->clone();
+    strip_sfpt->set_req(TypeFunc::Control, NULL);
+  }
+
   // Check for SafePoint on backedge and remove
   Node *sfpt = x->in(LoopNode::LoopBackControl);
   if (sfpt->Opcode() == Op_SafePoint && is_deleteable_safept(sfpt)) {
@@ -792,6 +825,10 @@ bool PhaseIdealLoop::is_counted_loop( Node *x, IdealLoopTree *loop ) {
   // Free up intermediate goo
   _igvn.remove_dead_node(hook);
 
+  if (strip_sfpt != NULL) {
+    strip_mine_counted_loop(loop, strip_sfpt->as_SafePoint());
+  }
+
 #ifdef ASSERT
   assert(l->is_valid_counted_loop(), "counted loop shape is messed up");
   assert(l == loop->_head && l->phi() == phi && l->loopexit() == lex, "" );
@@ -808,6 +845,174 @@ bool PhaseIdealLoop::is_counted_loop( Node *x, IdealLoopTree *loop ) {
   return true;
 }
 
+//------------------------------can_strip_mine_loop----------------------------
+// The poll and the loop carried values are moved past the exit test of the
+// counted loop, so everything they use must be computed before that test.
+bool PhaseIdealLoop::can_strip_mine_loop( Node *x, Node *iff, Node *sfpt ) {
+  for (uint i = TypeFunc::Control + 1; i < sfpt->req(); i++) {
+    Node* in = sfpt->in(i);
+    if (in != NULL && !in->is_top() && !is_dominator(ctrl_or_self(in), iff)) {
+      return false;
+    }
+  }
+  for (DUIterator_Fast imax, i = x->fast_outs(imax); i < imax; i++) {
+    Node* phi = x->fast_out(i);
+    if (!phi->is_Phi() || phi->in(0) != x) continue;
+    Node* be = phi->in(LoopNode::LoopBackControl);
+    if (be == NULL || be->is_top() || !is_dominator(ctrl_or_self(be), iff)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+//------------------------------strip_mine_counted_loop------------------------
+// Wrap the counted loop in an outer loop that runs it in strips of at most
+// LoopStripMiningIter iterations and polls for safepoints between strips:
+//
+//   for (j = init; ; j = i) {                      // outer loop
+//     strip_limit = MIN2(limit, j + LoopStripMiningIter*stride);
+//     for (i = j; i < strip_limit; i += stride) {  // counted loop, no poll
+//       body;
+//     }
+//     if (!(i < limit)) break;
+//     safepoint;
+//   }
+//
+// The counted loop keeps its shape, so range check elimination, unrolling
+// and SuperWord still apply to it.  The outer loop gets its own loop tree
+// node between the counted loop and its parent; iteration splitting leaves
+// it alone so that the counted loop is never peeled or unswitched with it.
+void PhaseIdealLoop::strip_mine_counted_loop( IdealLoopTree *loop, SafePointNode *sfpt ) {
+  CountedLoopNode* cl = loop->_head->as_CountedLoop();
+  CountedLoopEndNode* cle = cl->loopexit();
+  Node* entry = cl->in(LoopNode::EntryControl);
+  Node* phi = cl->phi();
+  Node* incr = cle->incr();
+  Node* limit = cle->limit();
+  int stride_con = cle->stride_con();
+  Node* exit = cle->proj_out(false);
+  uint dd = dom_depth(exit);
+
+  Node_List exit_users;
+  for (DUIterator_Fast imax, i = exit->fast_outs(imax); i < imax; i++) {
+    exit_users.push(exit->fast_out(i));
+  }
+
+  LoopNode* outer = new LoopNode(entry, sfpt);
+  outer->set_strip_mined_outer();
+
+  // Insert the outer loop in the loop tree in place of the counted loop,
+  // with the counted loop as its only child.
+  IdealLoopTree* outer_loop = new IdealLoopTree(this, outer, sfpt);
+  IdealLoopTree* parent = loop->_parent;
+  IdealLoopTree** pp = &parent->_child;
+  while (*pp != loop) {
+    pp = &(*pp)->_next;
+  }
+  *pp = outer_loop;
+  outer_loop->_next = loop->_next;
+  outer_loop->_parent = parent;
+  outer_loop->_child = loop;
+  outer_loop->_has_sfpt = 1;
+  loop->_next = NULL;
+  loop->_parent = outer_loop;
+  outer_loop->_nest = loop->_nest;
+  outer_loop->_has_call = loop->set_nest(loop->_nest + 1);
+  set_loop(exit, outer_loop);
+
+  // The original trip test now decides, once per strip, whether to go around
+  // the outer loop again.
+  IfNode* outer_le = new IfNode(exit, cle->in(CountedLoopEndNode::TestValue), cle->_prob, cle->_fcnt);
+  _igvn.register_new_node_with_optimizer(outer_le);
+  set_loop(outer_le, outer_loop);
+  set_idom(outer_le, exit, dd+1);
+  Node* outer_back = _igvn.register_new_node_with_optimizer(new IfTrueNode(outer_le));
+  set_loop(outer_back, outer_loop);
+  set_idom(outer_back, outer_le, dd+2);
+  Node* outer_exit = _igvn.register_new_node_with_optimizer(new IfFalseNode(outer_le));
+  set_loop(outer_exit, outer_loop);
+  set_idom(outer_exit, outer_le, dd+2);
+
+  // Whatever followed the counted loop now follows the outer loop.
+  for (uint i = 0; i < exit_users.size(); i++) {
+    Node* use = exit_users.at(i);
+    for (uint j = 0; j < use->req(); j++) {
+      if (use->in(j) == exit) {
+        _igvn.replace_input_of(use, j, outer_exit);
+      }
+    }
+    if (use->is_CFG() && idom(use) == exit) {
+      set_idom(use, outer_exit, dom_depth(use));
+    }
+  }
+
+  sfpt->set_req(TypeFunc::Control, outer_back);
+  _igvn.register_new_node_with_optimizer(sfpt);
+  set_loop(sfpt, outer_loop);
+  set_idom(sfpt, outer_back, dd+3);
+
+  _igvn.register_new_node_with_optimizer(outer);
+  set_loop(outer, outer_loop);
+  set_idom(outer, entry, dom_depth(cl));
+  _igvn.replace_input_of(cl, LoopNode::EntryControl, outer);
+  set_idom(cl, outer, dom_depth(cl)+1);
+  recompute_dom_depth();
+
+  // Every loop carried value enters a strip through a phi of the outer loop.
+  Node_List phis;
+  for (DUIterator_Fast imax, i = cl->fast_outs(imax); i < imax; i++) {
+    Node* n = cl->fast_out(i);
+    if (n->is_Phi() && n->in(0) == cl) {
+      phis.push(n);
+    }
+  }
+  Node* outer_iv = NULL;
+  for (uint i = 0; i < phis.size(); i++) {
+    Node* inner_phi = phis.at(i);
+    Node* outer_phi = inner_phi->clone();
+    outer_phi->set_req(0, outer);
+    _igvn.register_new_node_with_optimizer(outer_phi);
+    set_ctrl(outer_phi, outer);
+    _igvn.replace_input_of(inner_phi, LoopNode::EntryControl, outer_phi);
+    if (inner_phi == phi) {
+      outer_iv = outer_phi;
+    }
+  }
+  assert(outer_iv != NULL, "trip counter must be a phi of the counted loop");
+
+  // Compute the strip limit in long so that it cannot overflow.
+  PhaseGVN *gvn = &_igvn;
+  Node* init_l = gvn->transform(new ConvI2LNode(outer_iv));
+  Node* limit_l = gvn->transform(new ConvI2LNode(limit));
+  Node* span = gvn->longcon((jlong)LoopStripMiningIter * stride_con);
+  Node* end_l = gvn->transform(new AddLNode(init_l, span));
+  Node* cmp_l = gvn->transform(new CmpLNode(end_l, limit_l));
+  Node* bol = gvn->transform(new BoolNode(cmp_l, stride_con > 0 ? BoolTest::lt : BoolTest::gt));
+  Node* strip_limit_l = gvn->transform(new CMoveLNode(bol, limit_l, end_l, TypeLong::LONG));
+  Node* strip_limit = gvn->transform(new ConvL2INode(strip_limit_l));
+  set_subtree_ctrl(strip_limit);
+
+  Node* cmp = cle->cmp_node()->clone();
+  cmp->set_req(1, incr);
+  cmp->set_req(2, strip_limit);
+  cmp = _igvn.register_new_node_with_optimizer(cmp);
+  set_ctrl(cmp, cle->in(0));
+
+  Node* test = cle->in(CountedLoopEndNode::TestValue)->clone();
+  test->set_req(1, cmp);
+  test = _igvn.register_new_node_with_optimizer(test);
+  set_ctrl(test, cle->in(0));
+  _igvn.replace_input_of(cle, CountedLoopEndNode::TestValue, test);
+
+#ifndef PRODUCT
+  if (TraceLoopOpts) {
+    tty->print("StripMined   ");
+    loop->dump_head();
+  }
+#endif
+}
+
 //----------------------exact_limit-------------------------------------------
 Node* PhaseIdealLoop::exact_limit( IdealLoopTree *loop ) {
   assert(loop->_head->is_CountedLoop(), "");
@@ -1709,6 +1914,14 @@ void IdealLoopTree::check_safepts(VectorSet &visited, Node_List &stack) {
 // Is safept not required by an outer loop?
 bool PhaseIdealLoop::is_deleteable_safept(Node* sfpt) {
   assert(sfpt->Opcode() == Op_SafePoint, "");
+  // The poll between the strips of a strip mined loop must stay.
+  for (DUIterator_Fast imax, i = sfpt->fast_outs(imax); i < imax; i++) {
+    Node* u = sfpt->fast_out(i);
+    if (u->is_Loop() && u->as_Loop()->is_strip_mined_outer() &&
+        u->in(LoopNode::LoopBackControl) == sfpt) {
+      return false;
+    }
+  }
   IdealLoopTree* lp = get_loop(sfpt)->_parent;
   while (lp != NULL) {
     Node_List* sfpts = lp->_required_safept;
@@ -1816,8 +2029,14 @@ void IdealLoopTree::counted_loop( PhaseIdealLoop *phase ) {
     if (_head->is_Loop()) _head->as_Loop()->set_inner_loop();
   }
 
-  if (_head->is_CountedLoop() ||
-      phase->is_counted_loop(_head, this)) {
+  // Strip mining may insert a loop between this loop and its siblings.
+  IdealLoopTree* next = _next;
+
+  // The outer loop of a strip mined loop keeps its poll.
+  bool strip_mined_outer = _head->is_Loop() && _head->as_Loop()->is_strip_mined_outer();
+
+  if (!strip_mined_outer &&
+      (_head->is_CountedLoop() || phase->is_counted_loop(_head, this))) {
     _has_sfpt = 1;              // Indicate we do not need a safepoint here
 
     // Look for safepoints to remove.
@@ -1858,7 +2077,7 @@ void IdealLoopTree::counted_loop( PhaseIdealLoop *phase ) {
 
   // Recursively
   if (_child) _child->counted_loop( phase );
-  if (_next)  _next ->counted_loop( phase );
+  if (next)   next  ->counted_loop( phase );
 }
 
 #ifndef PRODUCT
@@ -38,6 +38,7 @@ class IdealLoopTree;
 class LoopNode;
 class Node;
 class PhaseIdealLoop;
+class SafePointNode;
 class VectorSet;
 class Invariance;
 struct small_cache;
@@ -62,7 +63,8 @@ protected:
          HasExactTripCount=8,
          InnerLoop=16,
          PartialPeelLoop=32,
-         PartialPeelFailed=64 };
+         PartialPeelFailed=64,
+         StripMinedOuter=128 };
   char _unswitch_count;
   enum { _unswitch_max=3 };
 
@@ -78,6 +80,10 @@ public:
   int partial_peel_has_failed() const { return _loop_flags & PartialPeelFailed; }
   void mark_partial_peel_failed() { _loop_flags |= PartialPeelFailed; }
 
+  // Outer loop that runs a counted loop in strips and polls between them
+  int is_strip_mined_outer() const { return _loop_flags & StripMinedOuter; }
+  void set_strip_mined_outer() { _loop_flags |= StripMinedOuter; }
+
   int unswitch_max() { return _unswitch_max; }
   int unswitch_count() { return _unswitch_count; }
   void set_unswitch_count(int val) {
@@ -814,6 +820,10 @@ public:
   virtual Node *transform( Node *a_node ) { return 0; }
 
   bool is_counted_loop( Node *x, IdealLoopTree *loop );
+  // Can the poll of a loop about to become counted be moved to an outer loop?
+  bool can_strip_mine_loop( Node *x, Node *iff, Node *sfpt );
+  // Run a counted loop in strips with a safepoint poll between strips
+  void strip_mine_counted_loop( IdealLoopTree *loop, SafePointNode *sfpt );
 
   Node* exact_limit( IdealLoopTree *loop );
 
@@ -69,6 +69,7 @@
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/signature.hpp"
 #include "runtime/thread.inline.hpp"
+#include "runtime/threadSMR.hpp"
 #include "runtime/vm_operations.hpp"
 #include "services/memTracker.hpp"
 #include "services/runtimeService.hpp"
@@ -3155,11 +3156,10 @@ JNI_END
 JNI_ENTRY(void*, jni_GetPrimitiveArrayCritical(JNIEnv *env, jarray array, jboolean *isCopy))
   JNIWrapper("GetPrimitiveArrayCritical");
  HOTSPOT_JNI_GETPRIMITIVEARRAYCRITICAL_ENTRY(env, array, (uintptr_t *) isCopy);
-  GC_locker::lock_critical(thread);
   if (isCopy != NULL) {
     *isCopy = JNI_FALSE;
   }
-  oop a = JNIHandles::resolve_non_null(array);
+  oop a = Universe::heap()->pin_object(thread, JNIHandles::resolve_non_null(array));
   assert(a->is_array(), "just checking");
   BasicType type;
   if (a->is_objArray()) {
@@ -3176,8 +3176,8 @@ JNI_END
 JNI_ENTRY(void, jni_ReleasePrimitiveArrayCritical(JNIEnv *env, jarray array, void *carray, jint mode))
   JNIWrapper("ReleasePrimitiveArrayCritical");
   HOTSPOT_JNI_RELEASEPRIMITIVEARRAYCRITICAL_ENTRY(env, array, carray, mode);
-  // The array, carray and mode arguments are ignored
-  GC_locker::unlock_critical(thread);
+  // The carray and mode arguments are ignored
+  Universe::heap()->unpin_object(thread, JNIHandles::resolve_non_null(array));
 HOTSPOT_JNI_RELEASEPRIMITIVEARRAYCRITICAL_RETURN();
 JNI_END
 
@@ -3185,13 +3185,12 @@ JNI_END
 JNI_ENTRY(const jchar*, jni_GetStringCritical(JNIEnv *env, jstring string, jboolean *isCopy))
   JNIWrapper("GetStringCritical");
   HOTSPOT_JNI_GETSTRINGCRITICAL_ENTRY(env, string, (uintptr_t *) isCopy);
-  GC_locker::lock_critical(thread);
   if (isCopy != NULL) {
     *isCopy = JNI_FALSE;
   }
   oop s = JNIHandles::resolve_non_null(string);
   int s_len = java_lang_String::length(s);
-  typeArrayOop s_value = java_lang_String::value(s);
+  typeArrayOop s_value = typeArrayOop(Universe::heap()->pin_object(thread, java_lang_String::value(s)));
   int s_offset = java_lang_String::offset(s);
   const jchar* ret;
   if (s_len > 0) {
@@ -3207,8 +3206,12 @@ JNI_END
 JNI_ENTRY(void, jni_ReleaseStringCritical(JNIEnv *env, jstring str, const jchar *chars))
   JNIWrapper("ReleaseStringCritical");
   HOTSPOT_JNI_RELEASESTRINGCRITICAL_ENTRY(env, str, (uint16_t *) chars);
-  // The str and chars arguments are ignored
-  GC_locker::unlock_critical(thread);
+  // Find the pinned value array through chars rather than the string:
+  // string deduplication may have replaced the value array since.
+  oop s = JNIHandles::resolve_non_null(str);
+  int s_offset = java_lang_String::length(s) > 0 ? java_lang_String::offset(s) : 0;
+  oop s_value = oop((address)(chars - s_offset) - arrayOopDesc::base_offset_in_bytes(T_CHAR));
+  Universe::heap()->unpin_object(thread, s_value);
 HOTSPOT_JNI_RELEASESTRINGCRITICAL_RETURN();
 JNI_END
 
@@ -4268,7 +4271,7 @@ jint JNICALL jni_DetachCurrentThread(JavaVM *vm)  {
   // (platform-dependent) methods where we do alternate stack
   // maintenance work?)
   thread->exit(false, JavaThread::jni_detach);
-  delete thread;
+  ThreadsSMRSupport::smr_delete(thread);
 
   HOTSPOT_JNI_DETACHCURRENTTHREAD_RETURN(JNI_OK);
   return JNI_OK;
@@ -98,6 +98,7 @@ class JvmtiExport : public AllStatic {
   JVMTI_SUPPORT_FLAG(should_post_class_load)
   JVMTI_SUPPORT_FLAG(should_post_class_prepare)
   JVMTI_SUPPORT_FLAG(should_post_class_unload)
+  JVMTI_SUPPORT_FLAG(should_post_sampled_object_alloc)
   JVMTI_SUPPORT_FLAG(should_post_native_method_bind)
   JVMTI_SUPPORT_FLAG(should_post_compiled_method_load)
   JVMTI_SUPPORT_FLAG(should_post_compiled_method_unload)
@@ -308,6 +309,7 @@ class JvmtiExport : public AllStatic {
 
   static void post_class_load            (JavaThread *thread, Klass* klass) NOT_JVMTI_RETURN;
   static void post_class_unload          (Klass* klass) NOT_JVMTI_RETURN;
+  static void post_sampled_object_alloc  (JavaThread *thread, oop object) NOT_JVMTI_RETURN;
   static void post_class_prepare         (JavaThread *thread, Klass* klass) NOT_JVMTI_RETURN;
 
   static void post_thread_start          (JavaThread *thread) NOT_JVMTI_RETURN;
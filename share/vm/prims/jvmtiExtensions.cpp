@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "memory/heapSampler.hpp"
 #include "prims/jvmtiExport.hpp"
 #include "prims/jvmtiExtensions.hpp"
 
@@ -42,11 +43,26 @@ static jvmtiError JNICALL IsClassUnloadingEnabled(const jvmtiEnv* env, jboolean*
   return JVMTI_ERROR_NONE;
 }
 
+// extension function
+static jvmtiError JNICALL SetHeapSamplingInterval(const jvmtiEnv* env, jint interval, ...) {
+  if (interval < 0) {
+    return JVMTI_ERROR_ILLEGAL_ARGUMENT;
+  }
+  if (!HeapSampler::is_available()) {
+    return JVMTI_ERROR_NOT_AVAILABLE;
+  }
+  HeapSampler::set_interval((size_t)interval);
+  return JVMTI_ERROR_NONE;
+}
+
 // register extension functions and events. In this implementation we
-// have a single extension function (to prove the API) that tests if class
-// unloading is enabled or disabled. We also have a single extension event
+// have an extension function (to prove the API) that tests if class
+// unloading is enabled or disabled, and one that sets the mean interval
+// in bytes between sampled allocations. We also have the extension event
 // EXT_EVENT_CLASS_UNLOAD which is used to provide the JVMDI_EVENT_CLASS_UNLOAD
-// event. The function and the event are registered here.
+// event, and EXT_EVENT_SAMPLED_OBJECT_ALLOC which is posted for sampled
+// allocations (see heapSampler.hpp). The functions and the events are
+// registered here.
 //
 void JvmtiExtensions::register_extensions() {
   _ext_functions = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<jvmtiExtensionFunctionInfo*>(1,true);
@@ -67,6 +83,24 @@ void JvmtiExtensions::register_extensions() {
   };
   _ext_functions->append(&ext_func);
 
+  static jvmtiParamInfo sampling_func_params[] = {
+    { (char*)"Interval", JVMTI_KIND_IN,  JVMTI_TYPE_JINT, JNI_FALSE }
+  };
+  static jvmtiError sampling_func_errors[] = {
+    JVMTI_ERROR_ILLEGAL_ARGUMENT,
+    JVMTI_ERROR_NOT_AVAILABLE
+  };
+  static jvmtiExtensionFunctionInfo sampling_ext_func = {
+    (jvmtiExtensionFunction)SetHeapSamplingInterval,
+    (char*)"com.sun.hotspot.functions.SetHeapSamplingInterval",
+    (char*)"Set the mean number of bytes between sampled allocations (0 samples every allocation)",
+    sizeof(sampling_func_params)/sizeof(sampling_func_params[0]),
+    sampling_func_params,
+    sizeof(sampling_func_errors)/sizeof(sampling_func_errors[0]),
+    sampling_func_errors
+  };
+  _ext_functions->append(&sampling_ext_func);
+
   // register our extension event
 
   static jvmtiParamInfo event_params[] = {
@@ -82,6 +116,22 @@ void JvmtiExtensions::register_extensions() {
     event_params
   };
   _ext_events->append(&ext_event);
+
+  static jvmtiParamInfo sampling_event_params[] = {
+    { (char*)"JNI Environment", JVMTI_KIND_IN, JVMTI_TYPE_JNIENV, JNI_FALSE },
+    { (char*)"Thread", JVMTI_KIND_IN, JVMTI_TYPE_JTHREAD, JNI_FALSE },
+    { (char*)"Object", JVMTI_KIND_IN, JVMTI_TYPE_JOBJECT, JNI_FALSE },
+    { (char*)"Class", JVMTI_KIND_IN, JVMTI_TYPE_JCLASS, JNI_FALSE },
+    { (char*)"Size", JVMTI_KIND_IN, JVMTI_TYPE_JLONG, JNI_FALSE }
+  };
+  static jvmtiExtensionEventInfo sampling_ext_event = {
+    EXT_EVENT_SAMPLED_OBJECT_ALLOC,
+    (char*)"com.sun.hotspot.events.SampledObjectAlloc",
+    (char*)"SAMPLED_OBJECT_ALLOC event",
+    sizeof(sampling_event_params)/sizeof(sampling_event_params[0]),
+    sampling_event_params
+  };
+  _ext_events->append(&sampling_ext_event);
 }
 
 
@@ -49,6 +49,7 @@
 #include "utilities/taskqueue.hpp"
 #if INCLUDE_ALL_GCS
 #include "gc_implementation/concurrentMarkSweep/compactibleFreeListSpace.hpp"
+#include "gc_implementation/epsilon/epsilonHeap.hpp"
 #include "gc_implementation/g1/g1CollectedHeap.inline.hpp"
 #include "gc_implementation/parallelScavenge/parallelScavengeHeap.hpp"
 #endif // INCLUDE_ALL_GCS
@@ -1592,6 +1593,8 @@ void Arguments::set_conservative_max_heap_alignment() {
     heap_alignment = ParallelScavengeHeap::conservative_max_heap_alignment();
   } else if (UseG1GC) {
     heap_alignment = G1CollectedHeap::conservative_max_heap_alignment();
+  } else if (UseEpsilonGC) {
+    heap_alignment = EpsilonHeap::conservative_max_heap_alignment();
   }
 #endif // INCLUDE_ALL_GCS
   _conservative_max_heap_alignment = MAX4(heap_alignment,
@@ -2130,6 +2133,7 @@ bool Arguments::check_gc_consistency_user() {
   if (UseConcMarkSweepGC)                i++;
   if (UseParallelGC || UseParallelOldGC) i++;
   if (UseG1GC)                           i++;
+  if (UseEpsilonGC)                      i++;
   if (i > 1) {
     jio_fprintf(defaultStream::error_stream(),
                 "Conflicting collector combinations in option list; "
@@ -3647,6 +3651,7 @@ void Arguments::set_shared_spaces_flags() {
 static void force_serial_gc() {
   FLAG_SET_DEFAULT(UseSerialGC, true);
   UNSUPPORTED_GC_OPTION(UseG1GC);
+  UNSUPPORTED_GC_OPTION(UseEpsilonGC);
   UNSUPPORTED_GC_OPTION(UseParallelGC);
   UNSUPPORTED_GC_OPTION(UseParallelOldGC);
   UNSUPPORTED_GC_OPTION(UseConcMarkSweepGC);
@@ -3932,6 +3937,15 @@ jint Arguments::apply_ergo() {
 
   ArgumentsExt::set_gc_specific_flags();
 
+  // The reference processing phases only run as many workers as the number
+  // of discovered references warrants, so parallel reference processing is
+  // cheap when there are few of them.
+  if ((UseParallelGC || UseParNewGC || UseG1GC) &&
+      FLAG_IS_DEFAULT(ParallelRefProcEnabled) &&
+      ParallelGCThreads > 1 && ReferencesPerThread > 0) {
+    FLAG_SET_ERGO(bool, ParallelRefProcEnabled, true);
+  }
+
   // Initialize Metaspace flags and alignments
   Metaspace::ergo_initialize();
 
@@ -3958,6 +3972,26 @@ jint Arguments::apply_ergo() {
     UseBiasedLocking = false;
   }
 
+#ifdef COMPILER1
+  // The fast TLAB refill stub cannot place heap sample points.
+  if (UseHeapSampling && FastTLABRefill) {
+    if (!FLAG_IS_DEFAULT(FastTLABRefill)) {
+      warning("FastTLABRefill is not supported with heap sampling"
+              "; ignoring FastTLABRefill flag." );
+    }
+    FastTLABRefill = false;
+  }
+#endif // COMPILER1
+
+  // Concurrent deflation finds the monitors through the in-use lists.
+  if (AsyncDeflateIdleMonitors && !MonitorInUseLists) {
+    if (!FLAG_IS_DEFAULT(MonitorInUseLists)) {
+      warning("AsyncDeflateIdleMonitors requires MonitorInUseLists"
+              "; ignoring -XX:-MonitorInUseLists." );
+    }
+    FLAG_SET_ERGO(bool, MonitorInUseLists, true);
+  }
+
 #ifdef ZERO
   // Clear flags not supported on zero.
   FLAG_SET_DEFAULT(ProfileInterpreter, false);
@@ -4032,8 +4066,10 @@ jint Arguments::adjust_after_os() {
     // platforms when UseNUMA is set to ON. NUMA-aware collectors
     // such as the parallel collector for Linux and Solaris will
     // interleave old gen and survivor spaces on top of NUMA
-    // allocation policy for the eden space.
-    // Non NUMA-aware collectors such as CMS, G1 and Serial-GC on
+    // allocation policy for the eden space. G1 on Linux explicitly
+    // places every heap region on a node when it is committed (see
+    // G1NUMA), which overrides the interleaving.
+    // Non NUMA-aware collectors such as CMS and Serial-GC on
     // all platforms and ParallelGC on Windows will interleave all
     // of the heap spaces across NUMA nodes.
     if (FLAG_IS_DEFAULT(UseNUMAInterleaving)) {
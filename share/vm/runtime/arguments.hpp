@@ -615,7 +615,8 @@ class Arguments : AllStatic {
 };
 
 bool Arguments::gc_selected() {
-  return UseConcMarkSweepGC || UseG1GC || UseParallelGC || UseParallelOldGC || UseSerialGC;
+  return UseConcMarkSweepGC || UseG1GC || UseParallelGC || UseParallelOldGC || UseSerialGC ||
+         UseEpsilonGC;
 }
 
 bool Arguments::check_gc_consistency_ergo() {
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#include "precompiled.hpp"
+#include "runtime/asyncLogWriter.hpp"
+#include "runtime/atomic.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.inline.hpp"
+#include "runtime/os.hpp"
+#include "utilities/ostream.hpp"
+
+AsyncLogWriter* AsyncLogWriter::_instance = NULL;
+
+AsyncLogWriter::AsyncLogWriter(gcLogFileStream* stream) :
+  _stream(stream),
+  _active(0),
+  _dropped(0) {
+  set_name("Async GC Log Writer");
+  _file_lock = new Mutex(Mutex::leaf, "AsyncLogWriter_lock", true,
+                         Monitor::_safepoint_check_never);
+  _wakeup = ParkEvent::Allocate(this);
+  _capacity = MAX2(AsyncGCLogBufferSize / 2, (uintx)K);
+  for (int i = 0; i < 2; i++) {
+    _buffers[i] = NEW_C_HEAP_ARRAY(char, _capacity, mtInternal);
+    _reserved[i] = 0;
+    _committed[i] = 0;
+  }
+}
+
+void AsyncLogWriter::start(gcLogFileStream* stream) {
+  assert(_instance == NULL, "only one async log writer");
+  AsyncLogWriter* writer = new AsyncLogWriter(stream);
+  if (!os::create_thread(writer, os::cgc_thread)) {
+    warning("Cannot create the async GC log writer thread; "
+            "GC log output is written synchronously");
+    return;
+  }
+  _instance = writer;
+  stream->set_async_writer(writer);
+  os::start_thread(writer);
+}
+
+void AsyncLogWriter::enqueue(const char* s, size_t len) {
+  while (true) {
+    int idx = OrderAccess::load_acquire(&_active);
+    size_t cur = (size_t)OrderAccess::load_ptr_acquire((volatile intptr_t*)&_reserved[idx]);
+    if ((cur & closed_bit) != 0) {
+      // The writer is swapping the buffers, the active index has changed.
+      continue;
+    }
+    size_t used = cur >> 1;
+    if (used + len > _capacity) {
+      Atomic::add_ptr((intptr_t)len, (volatile intptr_t*)&_dropped);
+      wakeup();
+      return;
+    }
+    size_t next = (used + len) << 1;
+    if (Atomic::cmpxchg_ptr((intptr_t)next, (volatile intptr_t*)&_reserved[idx], (intptr_t)cur) == (intptr_t)cur) {
+      memcpy(_buffers[idx] + used, s, len);
+      Atomic::add_ptr((intptr_t)len, (volatile intptr_t*)&_committed[idx]);
+      if (used == 0) {
+        wakeup();
+      }
+      return;
+    }
+  }
+}
+
+void AsyncLogWriter::drain_locked(bool at_exit) {
+  assert(_file_lock->owned_by_self(), "must hold the file lock");
+  int old = _active;
+  OrderAccess::release_store(&_active, 1 - old);
+  OrderAccess::fence();
+
+  // Close the old buffer for new reservations.
+  size_t cur;
+  do {
+    cur = (size_t)OrderAccess::load_ptr_acquire((volatile intptr_t*)&_reserved[old]);
+  } while (Atomic::cmpxchg_ptr((intptr_t)(cur | closed_bit),
+                               (volatile intptr_t*)&_reserved[old],
+                               (intptr_t)cur) != (intptr_t)cur);
+  size_t used = cur >> 1;
+
+  // Wait for the copies into the reserved space to finish; after a fatal
+  // error a writer may never finish its copy.
+  int spins = 0;
+  while ((size_t)OrderAccess::load_ptr_acquire((volatile intptr_t*)&_committed[old]) != used) {
+    if (at_exit && ++spins > 1000) {
+      break;
+    }
+    os::naked_yield();
+  }
+
+  if (used > 0) {
+    _stream->write_to_file(_buffers[old], used);
+  }
+  write_dropped_message();
+  _stream->flush_file();
+
+  _committed[old] = 0;
+  OrderAccess::release_store_ptr((volatile intptr_t*)&_reserved[old], 0);
+}
+
+void AsyncLogWriter::write_dropped_message() {
+  size_t dropped = (size_t)Atomic::xchg_ptr(0, (volatile intptr_t*)&_dropped);
+  if (dropped > 0) {
+    char msg[128];
+    jio_snprintf(msg, sizeof(msg),
+                 "[Async GC log: " SIZE_FORMAT " bytes of output dropped, buffer full]\n",
+                 dropped);
+    _stream->write_to_file(msg, strlen(msg));
+  }
+}
+
+void AsyncLogWriter::drain() {
+  MutexLockerEx ml(_file_lock, Mutex::_no_safepoint_check_flag);
+  if (_stream != NULL) {
+    // Both buffers may hold output, see the class comment.
+    drain_locked(false);
+    drain_locked(false);
+  }
+}
+
+void AsyncLogWriter::stop() {
+  MutexLockerEx ml(_file_lock, Mutex::_no_safepoint_check_flag);
+  if (_stream != NULL) {
+    drain_locked(false);
+    drain_locked(false);
+    _stream->set_async_writer(NULL);
+    _stream = NULL;
+  }
+  wakeup();
+}
+
+void AsyncLogWriter::abort_flush() {
+  if (_file_lock->try_lock()) {
+    if (_stream != NULL) {
+      drain_locked(true);
+      drain_locked(true);
+    }
+    _file_lock->unlock();
+  }
+}
+
+void AsyncLogWriter::run() {
+  this->record_stack_base_and_size();
+  this->initialize_thread_local_storage();
+  this->initialize_named_thread();
+  assert(this == Thread::current(), "just checking");
+
+  while (true) {
+    // Writers wake us up when they start filling a buffer.
+    _wakeup->park(1000);
+    MutexLockerEx ml(_file_lock, Mutex::_no_safepoint_check_flag);
+    if (_stream == NULL) {
+      break;
+    }
+    drain_locked(false);
+  }
+
+  // Thread destructor usually does this.
+  ThreadLocalStorage::set_thread(NULL);
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#ifndef SHARE_VM_RUNTIME_ASYNCLOGWRITER_HPP
+#define SHARE_VM_RUNTIME_ASYNCLOGWRITER_HPP
+
+#include "runtime/thread.hpp"
+
+class gcLogFileStream;
+
+// AsyncLogWriter takes the file I/O of the -Xloggc log off the threads that
+// log (-XX:+UseAsyncGCLog). Writers only copy their output into the active
+// one of two buffers: a CAS reserves space, then the bytes are copied and
+// committed. Output that does not fit is dropped and counted. The writer
+// thread swaps the buffers, waits for the copies into the old buffer to be
+// committed, and writes it to the file.
+//
+// A writer that read the active index just before a swap may still reserve
+// in the old buffer after it has been written and reopened; its output is
+// then written with the next but one swap, so lines from such a race may be
+// reordered but are not lost.
+class AsyncLogWriter : public NamedThread {
+ private:
+  enum {
+    closed_bit = 1   // set in _reserved[i] while buffer i is being written
+  };
+
+  static AsyncLogWriter* _instance;
+
+  gcLogFileStream* _stream;           // NULL once stopped
+  Mutex*           _file_lock;        // serializes draining, file writes and rotation
+  ParkEvent*       _wakeup;
+  char*            _buffers[2];
+  size_t           _capacity;         // of each buffer
+  volatile int     _active;
+  volatile size_t  _reserved[2];      // bytes reserved, shifted left by one, plus closed_bit
+  volatile size_t  _committed[2];     // bytes copied
+  volatile size_t  _dropped;          // bytes that did not fit since the last drain
+
+  AsyncLogWriter(gcLogFileStream* stream);
+
+  void drain_locked(bool at_exit);
+  void write_dropped_message();
+
+ public:
+  // Start writing the output of stream in the background. Output written
+  // before is written synchronously.
+  static void start(gcLogFileStream* stream);
+
+  static AsyncLogWriter* instance()   { return _instance; }
+
+  void enqueue(const char* s, size_t len);
+  void wakeup()                       { _wakeup->unpark(); }
+
+  // Write all buffered output. Used when rotating the log and on exit.
+  void drain();
+  Mutex* file_lock() const            { return _file_lock; }
+
+  // Write the remaining output and detach from the stream before it is
+  // deleted.
+  void stop();
+
+  // After a fatal error: write what can be written without blocking.
+  void abort_flush();
+
+  virtual void run();
+};
+
+#endif // SHARE_VM_RUNTIME_ASYNCLOGWRITER_HPP
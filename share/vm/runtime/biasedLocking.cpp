@@ -29,6 +29,8 @@
 #include "runtime/atomic.inline.hpp"
 #include "runtime/basicLock.hpp"
 #include "runtime/biasedLocking.hpp"
+#include "runtime/handshake.hpp"
+#include "runtime/safepointMechanism.inline.hpp"
 #include "runtime/task.hpp"
 #include "runtime/vframe.hpp"
 #include "runtime/vmThread.hpp"
@@ -180,9 +182,10 @@ static BiasedLocking::Condition revoke_bias(oop obj, bool allow_rebias, bool is_
     return BiasedLocking::BIAS_REVOKED;
   }
 
-  // Handle case where the thread toward which the object was biased has exited
+  // Handle case where the thread toward which the object was biased has exited.
+  // A thread revoking in a handshake with itself is alive by definition.
   bool thread_is_alive = false;
-  if (requesting_thread == biased_thread) {
+  if (requesting_thread == biased_thread || Thread::current() == biased_thread) {
     thread_is_alive = true;
   } else {
     for (JavaThread* cur_thread = Threads::first(); cur_thread != NULL; cur_thread = cur_thread->next()) {
@@ -267,7 +270,7 @@ enum HeuristicsResult {
 };
 
 
-static HeuristicsResult update_heuristics(oop o, bool allow_rebias) {
+static HeuristicsResult update_heuristics(oop o, bool allow_rebias, JavaThread* requesting_thread) {
   markOop mark = o->mark();
   if (!mark->has_bias_pattern()) {
     return HR_NOT_BIASED;
@@ -300,9 +303,34 @@ static HeuristicsResult update_heuristics(oop o, bool allow_rebias) {
     // many more revocation operations in a short period of time we
     // will completely disable biasing for this type.
     k->set_biased_lock_revocation_count(0);
+    k->set_biased_lock_handoff_count(0);
     revocation_count = 0;
   }
 
+  // Objects of a type that keep being revoked on behalf of other threads
+  // after the bulk rebias are handed off between threads as a matter of
+  // course, e.g. through a producer/consumer queue. Rebiasing does not
+  // help them, so stop biasing the type instead of paying for revocations
+  // until BiasedLockingBulkRevokeThreshold is reached.
+  JavaThread* biased_thread = mark->biased_locker();
+  if (BiasedLockingHandoffRevokeThreshold > 0 &&
+      requesting_thread != NULL &&
+      biased_thread != NULL && biased_thread != requesting_thread &&
+      last_bulk_revocation_time != 0 &&
+      revocation_count < BiasedLockingBulkRevokeThreshold) {
+    int handoff_count = k->atomic_incr_biased_lock_handoff_count();
+    if (handoff_count == BiasedLockingHandoffRevokeThreshold) {
+      if (TraceBiasedLocking) {
+        ResourceMark rm;
+        tty->print_cr("* Type %s reached %d handoff revocations since its bulk rebias",
+                      k->external_name(), handoff_count);
+      }
+      // Saturate the revocation count as a bulk revocation would
+      k->set_biased_lock_revocation_count(BiasedLockingBulkRevokeThreshold);
+      return HR_BULK_REVOKE;
+    }
+  }
+
   // Make revocation count saturate just beyond BiasedLockingBulkRevokeThreshold
   if (revocation_count <= BiasedLockingBulkRevokeThreshold) {
     revocation_count = k->atomic_incr_biased_lock_revocation_count();
@@ -335,6 +363,7 @@ static BiasedLocking::Condition bulk_revoke_or_rebias_at_safepoint(oop o,
 
   jlong cur_time = os::javaTimeMillis();
   o->klass()->set_last_biased_lock_bulk_revocation_time(cur_time);
+  o->klass()->set_biased_lock_handoff_count(0);
 
 
   Klass* k_o = o->klass();
@@ -505,6 +534,56 @@ public:
 };
 
 
+// Revokes the bias of a single object in a handshake with the thread it
+// is biased toward, rather than stopping all threads. Only the stack of
+// that thread is walked, so nothing else needs to be stopped.
+class RevokeOneBias : public HandshakeClosure {
+ private:
+  Handle _obj;
+  JavaThread* _requesting_thread;
+  JavaThread* _biased_locker;
+  BiasedLocking::Condition _status_code;
+  bool _executed;
+
+ public:
+  RevokeOneBias(Handle obj, JavaThread* requesting_thread, JavaThread* biased_locker)
+    : HandshakeClosure("RevokeOneBias")
+    , _obj(obj)
+    , _requesting_thread(requesting_thread)
+    , _biased_locker(biased_locker)
+    , _status_code(BiasedLocking::NOT_BIASED)
+    , _executed(false) {}
+
+  void do_thread(Thread* target) {
+    assert(target == _biased_locker, "wrong thread");
+    oop o = _obj();
+    markOop mark = o->mark();
+    if (!mark->has_bias_pattern()) {
+      _executed = true;
+      return;
+    }
+    // Only revoke here if the object is still biased toward the target
+    // in the current epoch; otherwise the bias has moved on since the
+    // request was made and the caller falls back to a safepoint.
+    markOop prototype = o->klass()->prototype_header();
+    if (mark->biased_locker() == _biased_locker &&
+        prototype->has_bias_pattern() &&
+        prototype->bias_epoch() == mark->bias_epoch()) {
+      ResourceMark rm;
+      if (TraceBiasedLocking) {
+        tty->print_cr("Revoking bias in a handshake with the biased thread:");
+      }
+      _status_code = revoke_bias(o, false, false, _requesting_thread);
+      _biased_locker->set_cached_monitor_info(NULL);
+      _executed = true;
+    }
+  }
+
+  bool executed() const { return _executed; }
+  BiasedLocking::Condition status_code() const { return _status_code; }
+};
+
+
 class VM_BulkRevokeBias : public VM_RevokeBias {
 private:
   bool _bulk_rebias;
@@ -590,7 +669,7 @@ BiasedLocking::Condition BiasedLocking::revoke_and_rebias(Handle obj, bool attem
     }
   }
 
-  HeuristicsResult heuristics = update_heuristics(obj(), attempt_rebias);
+  HeuristicsResult heuristics = update_heuristics(obj(), attempt_rebias, (JavaThread*) THREAD);
   if (heuristics == HR_NOT_BIASED) {
     return NOT_BIASED;
   } else if (heuristics == HR_SINGLE_REVOKE) {
@@ -616,6 +695,17 @@ BiasedLocking::Condition BiasedLocking::revoke_and_rebias(Handle obj, bool attem
       assert(cond == BIAS_REVOKED, "why not?");
       return cond;
     } else {
+      JavaThread* biased_locker = mark->biased_locker();
+      // Without thread-local polls a handshake is itself a safepoint, so
+      // go straight to the safepoint operation.
+      if (biased_locker != NULL && SafepointMechanism::uses_thread_local_poll()) {
+        RevokeOneBias revoke(obj, (JavaThread*) THREAD, biased_locker);
+        if (Handshake::execute(&revoke, biased_locker) && revoke.executed()) {
+          return revoke.status_code();
+        }
+      }
+      // No thread-local polls, or the biased thread has exited or the
+      // bias has changed under us
       VM_RevokeBias revoke(&obj, (JavaThread*) THREAD);
       VMThread::execute(&revoke);
       return revoke.status_code();
@@ -645,7 +735,7 @@ void BiasedLocking::revoke(GrowableArray<Handle>* objs) {
 void BiasedLocking::revoke_at_safepoint(Handle h_obj) {
   assert(SafepointSynchronize::is_at_safepoint(), "must only be called while at safepoint");
   oop obj = h_obj();
-  HeuristicsResult heuristics = update_heuristics(obj, false);
+  HeuristicsResult heuristics = update_heuristics(obj, false, NULL);
   if (heuristics == HR_SINGLE_REVOKE) {
     revoke_bias(obj, false, false, NULL);
   } else if ((heuristics == HR_BULK_REBIAS) ||
@@ -661,7 +751,7 @@ void BiasedLocking::revoke_at_safepoint(GrowableArray<Handle>* objs) {
   int len = objs->length();
   for (int i = 0; i < len; i++) {
     oop obj = (objs->at(i))();
-    HeuristicsResult heuristics = update_heuristics(obj, false);
+    HeuristicsResult heuristics = update_heuristics(obj, false, NULL);
     if (heuristics == HR_SINGLE_REVOKE) {
       revoke_bias(obj, false, false, NULL);
     } else if ((heuristics == HR_BULK_REBIAS) ||
@@ -817,6 +817,11 @@ class CommandLineFlags {
   develop(bool, DieOnSafepointTimeout, false,                               \
           "Die upon failure to reach safepoint (see SafepointTimeout)")     \
                                                                             \
+  product(bool, ReportSafepointStragglers, false,                           \
+          "Record the threads that have not reached a safepoint after "     \
+          "SafepointStragglerDelay milliseconds, with a sample of their "   \
+          "pc, in the safepoint straggler event log")                       \
+                                                                            \
   /* 50 retries * (5 * current_retry_count) millis = ~6.375 seconds */      \
   /* typically, at most a few retries are needed */                         \
   product(intx, SuspendRetryCount, 50,                                      \
@@ -1186,6 +1191,19 @@ class CommandLineFlags {
                                                                             \
   product(bool, MonitorInUseLists, false, "Track Monitors for Deflation")   \
                                                                             \
+  product(bool, AsyncDeflateIdleMonitors, false,                            \
+          "Deflate idle monitors in the service thread instead of at "      \
+          "safepoints (implies MonitorInUseLists)")                         \
+                                                                            \
+  product(intx, AsyncDeflationInterval, 250,                                \
+          "Milliseconds between checks of the monitor population with "     \
+          "AsyncDeflateIdleMonitors (0 means only when MonitorBound is "    \
+          "exceeded)")                                                      \
+                                                                            \
+  product(intx, MonitorUsedDeflationThreshold, 90,                          \
+          "Percentage of the monitor population in use above which the "    \
+          "service thread deflates idle monitors")                          \
+                                                                            \
   experimental(intx, SyncFlags, 0, "(Unsafe, Unstable) "                    \
                "Experimental Sync flags")                                   \
                                                                             \
@@ -1323,6 +1341,11 @@ class CommandLineFlags {
           "Decay time (in milliseconds) to re-enable bulk rebiasing of a "  \
           "type after previous bulk rebias")                                \
                                                                             \
+  product(intx, BiasedLockingHandoffRevokeThreshold, 10,                    \
+          "Number of revocations on behalf of other threads after a bulk "  \
+          "rebias of a type at which to permanently revoke biases of "      \
+          "that type (0 to only use BiasedLockingBulkRevokeThreshold)")     \
+                                                                            \
   /* tracing */                                                             \
                                                                             \
   notproduct(bool, TraceRuntimeCalls, false,                                \
@@ -1439,6 +1462,17 @@ class CommandLineFlags {
   product(bool, UseG1GC, false,                                             \
           "Use the Garbage-First garbage collector")                        \
                                                                             \
+  experimental(bool, UseEpsilonGC, false,                                   \
+          "Use the Epsilon collector, which allocates memory but never "    \
+          "reclaims it")                                                    \
+                                                                            \
+  experimental(uintx, EpsilonMaxTLABSize, 4*M,                              \
+          "Maximum TLAB size in bytes for the Epsilon collector")           \
+                                                                            \
+  experimental(uintx, EpsilonMinHeapExpand, 128*M,                          \
+          "Minimum number of bytes to commit when the Epsilon heap "        \
+          "has to expand")                                                  \
+                                                                            \
   product(bool, UseParallelGC, false,                                       \
           "Use the Parallel Scavenge garbage collector")                    \
                                                                             \
@@ -1475,6 +1509,11 @@ class CommandLineFlags {
           "Force dynamic selection of the number of "                       \
           "parallel threads parallel gc will use to aid debugging")         \
                                                                             \
+  product(uintx, StackScanChunkFrames, 0,                                   \
+          "Let parallel GC workers share the root scanning of a thread "    \
+          "stack in chunks of this many frames (0 to scan each stack "      \
+          "with a single worker)")                                          \
+                                                                            \
   product(uintx, HeapSizePerGCThread, ScaleForWordSize(64*M),               \
           "Size of heap (bytes) per GC thread used in calculating the "     \
           "number of GC threads")                                           \
@@ -1641,6 +1680,10 @@ class CommandLineFlags {
   product(bool, AlwaysPreTouch, false,                                      \
           "Force all freshly committed pages to be pre-touched")            \
                                                                             \
+  product(uintx, PreTouchParallelChunkSize, 1 * G,                          \
+          "Size of the chunks of memory pre-touched by each of the "        \
+          "parallel GC threads with AlwaysPreTouch")                        \
+                                                                            \
   product_pd(uintx, CMSYoungGenPerWorker,                                   \
           "The maximum size of young gen chosen by default per GC worker "  \
           "thread available")                                               \
@@ -1794,6 +1837,15 @@ class CommandLineFlags {
           "Whether multi-threaded concurrent work enabled "                 \
           "(effective only if ParNewGC)")                                   \
                                                                             \
+  product(bool, CMSParallelSweepEnabled, false,                             \
+          "Whether the concurrent sweep is done by the concurrent GC "      \
+          "threads (effective only if CMSConcurrentMTEnabled)")             \
+                                                                            \
+  product(bool, CMSParallelFullGC, false,                                   \
+          "Whether the pointer adjustment and compaction phases of a "      \
+          "full collection of the CMS generation are done by the "          \
+          "parallel GC threads")                                            \
+                                                                            \
   product(bool, CMSPrecleaningEnabled, true,                                \
           "Whether concurrent precleaning enabled")                         \
                                                                             \
@@ -1912,6 +1964,11 @@ class CommandLineFlags {
   product(bool, ParallelRefProcBalancingEnabled, true,                      \
           "Enable balancing of reference processing queues")                \
                                                                             \
+  product(uintx, ReferencesPerThread, 1000,                                 \
+          "Use one more thread per this many discovered references in "     \
+          "each parallel reference processing phase; 0 always uses all "    \
+          "threads")                                                        \
+                                                                            \
   product(uintx, CMSTriggerRatio, 80,                                       \
           "Percentage of MinHeapFreeRatio in CMS generation that is "       \
           "allocated before a CMS collection cycle commences")              \
@@ -1977,6 +2034,16 @@ class CommandLineFlags {
   develop(uintx, PromotionFailureALotInterval, 5,                           \
           "Total collections between promotion failures a lot")             \
                                                                             \
+  product(bool, UseStealableTaskQueueOverflow, true,                        \
+          "Allow idle GC worker threads to steal from the overflow stacks " \
+          "of other workers' task queues, taking up to half of the "        \
+          "overflowed tasks at a time")                                     \
+                                                                            \
+  product(bool, UseOWSTTaskTerminator, true,                                \
+          "Use a termination protocol for parallel GC where one idle "      \
+          "thread polls the task queues and wakes the others when there "   \
+          "is work to steal")                                               \
+                                                                            \
   experimental(uintx, WorkStealingSleepMillis, 1,                           \
           "Sleep time when sleep is used for yields")                       \
                                                                             \
@@ -2027,6 +2094,15 @@ class CommandLineFlags {
   product(bool, FastTLABRefill, true,                                       \
           "Use fast TLAB refill code")                                      \
                                                                             \
+  product(bool, UseHeapSampling, false,                                     \
+          "Sample one allocation every HeapSamplingInterval bytes on "      \
+          "average and record its allocation site for GC.heap_samples. "    \
+          "Turns off FastTLABRefill")                                       \
+                                                                            \
+  manageable(uintx, HeapSamplingInterval, 512*K,                            \
+          "Mean number of bytes a thread allocates between two sampled "    \
+          "allocations; 0 samples every allocation")                        \
+                                                                            \
   product(bool, PrintTLAB, false,                                           \
           "Print various TLAB related information")                         \
                                                                             \
@@ -2096,6 +2172,15 @@ class CommandLineFlags {
   develop(intx, PSAdaptiveSizePolicyResizeVirtualSpaceAlot, -1,             \
           "Resize the virtual spaces of the young or old generations")      \
                                                                             \
+  product(uintx, PSPeriodicGCInterval, 0,                                   \
+          "Number of milliseconds without a collection after which the "    \
+          "parallel collector does a full collection and uncommits the "    \
+          "unused parts of the heap (0 means never)")                       \
+                                                                            \
+  product(uintx, PSPeriodicGCSystemLoadThreshold, 0,                        \
+          "Skip the periodic collection while the one-minute system load "  \
+          "average is above this value (0 means ignore the load)")          \
+                                                                            \
   product(uintx, AdaptiveSizeThroughPutPolicy, 0,                           \
           "Policy for changing generation size for throughput goals")       \
                                                                             \
@@ -2431,6 +2516,15 @@ class CommandLineFlags {
           "GC log file size, requires UseGCLogFileRotation. "               \
           "Set to 0 to only trigger rotation via jcmd")                     \
                                                                             \
+  product(bool, UseAsyncGCLog, false,                                       \
+          "Write the -Xloggc log from a background thread; logging "        \
+          "threads only copy the output into a buffer")                     \
+                                                                            \
+  product(uintx, AsyncGCLogBufferSize, 2*M,                                 \
+          "Memory for buffered asynchronous GC log output, requires "       \
+          "UseAsyncGCLog. Output that does not fit is dropped and "         \
+          "the loss is reported in the log")                                \
+                                                                            \
   /* JVMTI heap profiling */                                                \
                                                                             \
   diagnostic(bool, TraceJVMTIObjectTagging, false,                          \
@@ -2946,6 +3040,14 @@ class CommandLineFlags {
   product(intx, SafepointTimeoutDelay, 10000,                               \
           "Delay in milliseconds for option SafepointTimeout")              \
                                                                             \
+  product(intx, SafepointStragglerDelay, 100,                               \
+          "Delay in milliseconds for option ReportSafepointStragglers")     \
+                                                                            \
+  product(bool, ThreadLocalHandshakes, false,                               \
+          "Poll a per-thread word instead of the global polling page, "     \
+          "so that operations on single threads can use handshakes "        \
+          "instead of safepoints (x86_64 only)")                            \
+                                                                            \
   product(intx, NmethodSweepActivity, 10,                                   \
           "Removes cold nmethods from code cache if > 0. Higher values "    \
           "result in more aggressive sweeping")                             \
@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "runtime/atomic.inline.hpp"
+#include "runtime/handshake.hpp"
+#include "runtime/interfaceSupport.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.inline.hpp"
+#include "runtime/os.hpp"
+#include "runtime/safepointMechanism.inline.hpp"
+#include "runtime/thread.inline.hpp"
+#include "runtime/vm_operations.hpp"
+#include "runtime/vmThread.hpp"
+
+// A handshake closure shared by all the threads it targets.
+class HandshakeOperation : public StackObj {
+  HandshakeClosure* _handshake_cl;
+  volatile int      _pending_threads;
+
+ public:
+  HandshakeOperation(HandshakeClosure* cl) : _handshake_cl(cl), _pending_threads(0) {}
+
+  void add_target()             { Atomic::inc(&_pending_threads); }
+  void do_handshake(JavaThread* thread) { _handshake_cl->do_thread(thread); }
+  void target_done()            { Atomic::dec(&_pending_threads); }
+  bool is_completed()           { return OrderAccess::load_acquire(&_pending_threads) == 0; }
+  const char* name() const      { return _handshake_cl->name(); }
+};
+
+class VM_Handshake : public VM_Operation {
+ protected:
+  HandshakeOperation* const _op;
+  jlong _start_time;
+
+  VM_Handshake(HandshakeOperation* op) : _op(op), _start_time(0) {}
+
+  void arm(JavaThread* target) {
+    _op->add_target();
+    target->set_handshake_operation(_op);
+  }
+
+  // Let the targets see their armed polls and flush the targets' thread
+  // states before the VM thread examines them.
+  void serialize_thread_states() {
+    OrderAccess::fence();
+    if (!UseMembar) {
+      os::serialize_thread_states();
+    }
+  }
+
+  // Back off as the safepoint synchronization does while threads are
+  // running to their polls.
+  static void back_off(int steps) {
+    if (os::is_MP() && steps < SafepointSpinBeforeYield) {
+      SpinPause();
+    } else if (steps < DeferThrSuspendLoopCount) {
+      os::naked_yield();
+    } else {
+      os::naked_short_sleep(1);
+    }
+  }
+
+  void trace_begin() {
+    if (TraceSafepoint) {
+      _start_time = os::javaTimeNanos();
+      tty->print_cr("Handshake \"%s\" started", _op->name());
+    }
+  }
+
+  void trace_end(int targets) {
+    if (TraceSafepoint) {
+      tty->print_cr("Handshake \"%s\", targeted threads: %d, executed in " JLONG_FORMAT " us",
+                    _op->name(), targets, (os::javaTimeNanos() - _start_time) / (NANOUNITS / MICROUNITS));
+    }
+  }
+
+ public:
+  Mode evaluation_mode() const { return _no_safepoint; }
+};
+
+class VM_HandshakeOneThread : public VM_Handshake {
+  JavaThread* _target;
+  bool _thread_alive;
+
+ public:
+  VM_HandshakeOneThread(HandshakeOperation* op, JavaThread* target) :
+    VM_Handshake(op), _target(target), _thread_alive(false) {}
+
+  void doit() {
+    trace_begin();
+    // The Threads_lock keeps the target from exiting.
+    MutexLockerEx ml(Threads_lock->owned_by_self() ? NULL : Threads_lock);
+    for (JavaThread* thr = Threads::first(); thr != NULL; thr = thr->next()) {
+      if (thr == _target) {
+        _thread_alive = true;
+        break;
+      }
+    }
+    if (!_thread_alive) {
+      return;
+    }
+
+    arm(_target);
+    serialize_thread_states();
+    int steps = 0;
+    while (!_op->is_completed()) {
+      if (!_target->handshake_try_process_by_vmThread()) {
+        back_off(++steps);
+      }
+    }
+    trace_end(1);
+  }
+
+  VMOp_Type type() const { return VMOp_HandshakeOneThread; }
+  bool thread_alive() const { return _thread_alive; }
+};
+
+class VM_HandshakeAllThreads : public VM_Handshake {
+ public:
+  VM_HandshakeAllThreads(HandshakeOperation* op) : VM_Handshake(op) {}
+
+  void doit() {
+    trace_begin();
+    MutexLockerEx ml(Threads_lock->owned_by_self() ? NULL : Threads_lock);
+    int targets = 0;
+    for (JavaThread* thr = Threads::first(); thr != NULL; thr = thr->next()) {
+      arm(thr);
+      targets++;
+    }
+    serialize_thread_states();
+
+    int steps = 0;
+    while (!_op->is_completed()) {
+      bool progress = false;
+      for (JavaThread* thr = Threads::first(); thr != NULL; thr = thr->next()) {
+        // Threads that are running will process the operation themselves.
+        if (thr->handshake_try_process_by_vmThread()) {
+          progress = true;
+        }
+      }
+      if (!progress) {
+        back_off(++steps);
+      }
+    }
+    trace_end(targets);
+  }
+
+  VMOp_Type type() const { return VMOp_HandshakeAllThreads; }
+};
+
+// Without thread-local polls the closure is executed at a safepoint.
+class VM_HandshakeFallbackOperation : public VM_Operation {
+  HandshakeClosure* _thread_cl;
+  JavaThread*    _target_thread;
+  bool           _all_threads;
+  bool           _thread_alive;
+
+ public:
+  VM_HandshakeFallbackOperation(HandshakeClosure* cl) :
+    _thread_cl(cl), _target_thread(NULL), _all_threads(true), _thread_alive(true) {}
+  VM_HandshakeFallbackOperation(HandshakeClosure* cl, JavaThread* target) :
+    _thread_cl(cl), _target_thread(target), _all_threads(false), _thread_alive(false) {}
+
+  void doit() {
+    for (JavaThread* thr = Threads::first(); thr != NULL; thr = thr->next()) {
+      if (_all_threads || thr == _target_thread) {
+        if (thr == _target_thread) {
+          _thread_alive = true;
+        }
+        _thread_cl->do_thread(thr);
+      }
+    }
+  }
+
+  VMOp_Type type() const { return VMOp_HandshakeFallback; }
+  bool thread_alive() const { return _thread_alive; }
+};
+
+void Handshake::execute(HandshakeClosure* thread_cl) {
+  if (SafepointMechanism::uses_thread_local_poll()) {
+    HandshakeOperation op(thread_cl);
+    VM_HandshakeAllThreads handshake(&op);
+    VMThread::execute(&handshake);
+  } else {
+    VM_HandshakeFallbackOperation op(thread_cl);
+    VMThread::execute(&op);
+  }
+}
+
+bool Handshake::execute(HandshakeClosure* thread_cl, JavaThread* target) {
+  if (SafepointMechanism::uses_thread_local_poll()) {
+    HandshakeOperation op(thread_cl);
+    VM_HandshakeOneThread handshake(&op, target);
+    VMThread::execute(&handshake);
+    return handshake.thread_alive();
+  } else {
+    VM_HandshakeFallbackOperation op(thread_cl, target);
+    VMThread::execute(&op);
+    return op.thread_alive();
+  }
+}
+
+HandshakeState::HandshakeState() : _operation(NULL), _processor(NULL) {}
+
+void HandshakeState::set_operation(JavaThread* target, HandshakeOperation* op) {
+  assert(Thread::current()->is_VM_thread(), "should be the VM thread");
+  assert(_operation == NULL, "only one handshake at a time");
+  _operation = op;
+  // The operation must be visible before the armed poll.
+  OrderAccess::storestore();
+  SafepointMechanism::arm_local_poll(target);
+}
+
+bool HandshakeState::claim(Thread* processor) {
+  return Atomic::cmpxchg_ptr(processor, &_processor, NULL) == NULL;
+}
+
+void HandshakeState::release_claim() {
+  OrderAccess::release_store_ptr(&_processor, NULL);
+}
+
+// Called with the operation claimed.
+void HandshakeState::process(JavaThread* target) {
+  HandshakeOperation* op = _operation;
+  op->do_handshake(target);
+  // Clear the state before completing the operation: once it is completed
+  // the VM thread may start the next handshake.
+  OrderAccess::release_store_ptr(&_operation, NULL);
+  SafepointMechanism::disarm_local_poll(target);
+  op->target_done();
+}
+
+void HandshakeState::process_by_self(JavaThread* thread) {
+  assert(Thread::current() == thread, "should call from thread");
+  while (has_operation()) {
+    if (claim(thread)) {
+      if (has_operation()) {
+        // Keep the VM thread from also treating this thread as safe, and
+        // make our own stack walkable for the closure.
+        JavaThreadState state = thread->thread_state();
+        thread->frame_anchor()->make_walkable(thread);
+        thread->set_thread_state(_thread_in_vm);
+        process(thread);
+        thread->set_thread_state(state);
+      }
+      release_claim();
+      return;
+    }
+    // The VM thread is processing the operation on our behalf, we may
+    // not continue before it is done.
+    os::naked_yield();
+  }
+}
+
+bool HandshakeState::vmthread_can_process_handshake(JavaThread* target) {
+  JavaThreadState state = target->thread_state();
+  return state == _thread_new || SafepointSynchronize::safepoint_safe(target, state);
+}
+
+bool HandshakeState::try_process_by_vmThread(JavaThread* target) {
+  assert(Thread::current()->is_VM_thread(), "should call from vm thread");
+  if (!has_operation() || !vmthread_can_process_handshake(target)) {
+    return false;
+  }
+  if (!claim(Thread::current())) {
+    // The target is processing it.
+    return false;
+  }
+  bool processed = false;
+  // Check the state again now that the target cannot pass its poll
+  // without waiting for us.
+  if (has_operation() && vmthread_can_process_handshake(target)) {
+    process(target);
+    processed = true;
+  }
+  release_claim();
+  return processed;
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_RUNTIME_HANDSHAKE_HPP
+#define SHARE_VM_RUNTIME_HANDSHAKE_HPP
+
+#include "memory/allocation.hpp"
+
+class HandshakeOperation;
+class JavaThread;
+class Thread;
+
+// A handshake closure is executed for a Java thread while that thread is
+// stopped, without stopping any other thread: either by the thread itself
+// at its next poll or transition, or by the VM thread while the thread is
+// blocked or in native code. The closure must not block for a safepoint
+// and must not allocate in the Java heap. When several threads are
+// targeted the closure can run concurrently for different threads.
+class HandshakeClosure : public StackObj {
+  const char* const _name;
+ public:
+  HandshakeClosure(const char* name) : _name(name) {}
+  const char* name() const { return _name; }
+  virtual void do_thread(Thread* thread) = 0;
+};
+
+class Handshake : public AllStatic {
+ public:
+  // Execute the closure for all Java threads, or for one. Returns after
+  // the closure has been executed for every target. Without
+  // -XX:+ThreadLocalHandshakes this falls back to a safepoint.
+  static void execute(HandshakeClosure* hs_cl);
+  // Returns false if the target is no longer alive.
+  static bool execute(HandshakeClosure* hs_cl, JavaThread* target);
+};
+
+// The handshake state of a JavaThread. An operation is processed by
+// whichever of the thread itself and the VM thread claims it first.
+class HandshakeState VALUE_OBJ_CLASS_SPEC {
+  HandshakeOperation* volatile _operation;
+  Thread* volatile             _processor;
+
+  bool claim(Thread* processor);
+  void release_claim();
+  void process(JavaThread* target);
+  bool vmthread_can_process_handshake(JavaThread* target);
+
+ public:
+  HandshakeState();
+
+  void set_operation(JavaThread* target, HandshakeOperation* op);
+  bool has_operation() const { return _operation != NULL; }
+
+  void process_by_self(JavaThread* thread);
+  bool try_process_by_vmThread(JavaThread* target);
+
+  bool is_processed_by(Thread* thread) const { return _processor == thread; }
+};
+
+#endif // SHARE_VM_RUNTIME_HANDSHAKE_HPP
@@ -52,6 +52,7 @@ void classLoader_init();
 void compilationPolicy_init();
 void codeCache_init();
 void VM_Version_init();
+void ticks_init();             // depends on VM_Version_init
 void os_init_globals();        // depends on VM_Version_init, before universe_init
 void stubRoutines_init1();
 jint universe_init();          // depends on codeCache_init and stubRoutines_init
@@ -100,6 +101,7 @@ jint init_globals() {
   compilationPolicy_init();
   codeCache_init();
   VM_Version_init();
+  ticks_init();
   os_init_globals();
   stubRoutines_init1();
   jint status = universe_init();  // dependent on codeCache_init and
@@ -26,11 +26,13 @@
 #define SHARE_VM_RUNTIME_INTERFACESUPPORT_HPP
 
 #include "memory/gcLocker.hpp"
+#include "memory/heapSampler.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/orderAccess.hpp"
 #include "runtime/os.hpp"
 #include "runtime/safepoint.hpp"
+#include "runtime/safepointMechanism.inline.hpp"
 #include "runtime/thread.inline.hpp"
 #include "runtime/vmThread.hpp"
 #include "utilities/globalDefinitions.hpp"
@@ -149,8 +151,8 @@ class ThreadStateTransition : public StackObj {
       }
     }
 
-    if (SafepointSynchronize::do_call_back()) {
-      SafepointSynchronize::block(thread);
+    if (SafepointMechanism::should_block(thread)) {
+      SafepointMechanism::block_if_requested(thread);
     }
     thread->set_thread_state(to);
 
@@ -180,8 +182,8 @@ class ThreadStateTransition : public StackObj {
       }
     }
 
-    if (SafepointSynchronize::do_call_back()) {
-      SafepointSynchronize::block(thread);
+    if (SafepointMechanism::should_block(thread)) {
+      SafepointMechanism::block_if_requested(thread);
     }
     thread->set_thread_state(to);
 
@@ -216,7 +218,7 @@ class ThreadStateTransition : public StackObj {
     // We never install asynchronous exceptions when coming (back) in
     // to the runtime from native code because the runtime is not set
     // up to handle exceptions floating around at arbitrary points.
-    if (SafepointSynchronize::do_call_back() || thread->is_suspend_after_native()) {
+    if (SafepointMechanism::should_block(thread) || thread->is_suspend_after_native()) {
       JavaThread::check_safepoint_and_suspend_for_native_trans(thread);
 
       // Clear unhandled oops anywhere where we could block, even if we don't.
@@ -239,6 +241,8 @@ class ThreadInVMfromJava : public ThreadStateTransition {
     trans_from_java(_thread_in_vm);
   }
   ~ThreadInVMfromJava()  {
+    // Post a heap sample taken during the entry now that no VM locks are held.
+    if (_thread->heap_sampler().has_pending_post()) HeapSampler::post_pending_sample(_thread);
     trans(_thread_in_vm, _thread_in_Java);
     // Check for pending. async. exceptions or suspends.
     if (_thread->has_special_runtime_exit_condition()) _thread->handle_special_runtime_exit_condition();
@@ -278,6 +282,7 @@ class ThreadInVMfromNative : public ThreadStateTransition {
     trans_from_native(_thread_in_vm);
   }
   ~ThreadInVMfromNative() {
+    if (_thread->heap_sampler().has_pending_post()) HeapSampler::post_pending_sample(_thread);
     trans_and_fence(_thread_in_vm, _thread_in_native);
   }
 };
@@ -94,6 +94,7 @@ extern Monitor* Compilation_lock;                // a lock used to pause compila
 extern Mutex*   CompileTaskAlloc_lock;           // a lock held when CompileTasks are allocated
 extern Mutex*   CompileStatistics_lock;          // a lock held when updating compilation statistics
 extern Mutex*   MultiArray_lock;                 // a lock used to guard allocation of multi-dim arrays
+extern Mutex*   HeapSampler_lock;                // a lock used to guard the heap sample table
 extern Monitor* Terminator_lock;                 // a lock used to guard termination of the vm
 extern Monitor* BeforeExit_lock;                 // a lock used to guard cleanups and shutdown hooks
 extern Monitor* Notify_lock;                     // a lock used to synchronize the start-up of the vm
@@ -125,6 +126,7 @@ extern Mutex*   MMUTracker_lock;                 // protects the MMU
 
 extern Mutex*   Management_lock;                 // a lock used to serialize JVM management
 extern Monitor* Service_lock;                    // a lock used for service thread operation
+extern Monitor* ThreadsSMRDelete_lock;           // a lock used by exiting threads waiting for ThreadsList readers
 extern Monitor* PeriodicTask_lock;               // protects the periodic task structure
 
 #ifdef INCLUDE_TRACE
@@ -269,7 +269,7 @@ bool ObjectMonitor::try_enter(Thread* THREAD) {
   }
 }
 
-void NOINLINE ObjectMonitor::enter(TRAPS) {
+bool NOINLINE ObjectMonitor::enter(TRAPS) {
   // The following code is ordered to check the most common cases first
   // and to reduce RTS->RTO cache line upgrades on SPARC and IA32 processors.
   Thread * const Self = THREAD;
@@ -279,13 +279,13 @@ void NOINLINE ObjectMonitor::enter(TRAPS) {
     // Either ASSERT _recursions == 0 or explicitly set _recursions = 0.
     assert(_recursions == 0, "invariant");
     assert(_owner == Self, "invariant");
-    return;
+    return true;
   }
 
   if (cur == Self) {
     // TODO-FIXME: check for integer overflow!  BUGID 6557169.
     _recursions++;
-    return;
+    return true;
   }
 
   if (Self->is_lock_owned ((address)cur)) {
@@ -294,7 +294,7 @@ void NOINLINE ObjectMonitor::enter(TRAPS) {
     // Commute owner from a thread-specific on-stack BasicLockObject address to
     // a full-fledged "Thread *".
     _owner = Self;
-    return;
+    return true;
   }
 
   // We've encountered genuine contention.
@@ -311,7 +311,7 @@ void NOINLINE ObjectMonitor::enter(TRAPS) {
     assert(_recursions == 0, "invariant");
     assert(((oop)(object()))->mark() == markOopDesc::encode(this), "invariant");
     Self->_Stalled = 0;
-    return;
+    return true;
   }
 
   assert(_owner != Self, "invariant");
@@ -321,12 +321,21 @@ void NOINLINE ObjectMonitor::enter(TRAPS) {
   assert(!SafepointSynchronize::is_at_safepoint(), "invariant");
   assert(jt->thread_state() != _thread_blocked, "invariant");
   assert(this->object() != NULL, "invariant");
-  assert(_count >= 0, "invariant");
+  assert(_count >= 0 || is_being_async_deflated(), "invariant");
 
   // Prevent deflation at STW-time.  See deflate_idle_monitors() and is_busy().
   // Ensure the object-monitor relationship remains stable while there's contention.
   Atomic::inc(&_count);
 
+  if (AsyncDeflateIdleMonitors && is_being_async_deflated()) {
+    // The monitor was deflated after the caller read it from the object
+    // header. Finish restoring the header and let the caller retry.
+    Atomic::dec(&_count);
+    install_displaced_markword_in_object((oop) object());
+    Self->_Stalled = 0;
+    return false;
+  }
+
   EventJavaMonitorEnter event;
 
   { // Change java thread status to indicate blocked on monitor enter.
@@ -424,6 +433,7 @@ void NOINLINE ObjectMonitor::enter(TRAPS) {
   if (ObjectMonitor::_sync_ContendedLockAttempts != NULL) {
     ObjectMonitor::_sync_ContendedLockAttempts->inc();
   }
+  return true;
 }
 
 
@@ -451,6 +461,14 @@ void NOINLINE ObjectMonitor::EnterI(TRAPS) {
   assert(Self->is_Java_thread(), "invariant");
   assert(((JavaThread *) Self)->thread_state() == _thread_blocked, "invariant");
 
+  // Our _count increment already makes a concurrent deflation of this
+  // monitor fail, so we can take the lock over from the deflating thread.
+  if (AsyncDeflateIdleMonitors &&
+      Atomic::cmpxchg_ptr(Self, &_owner, DEFLATER_MARKER) == DEFLATER_MARKER) {
+    assert(_recursions == 0, "invariant");
+    return;
+  }
+
   // Try the lock - TATAS
   if (TryLock (Self) > 0) {
     assert(_succ != Self, "invariant");
@@ -1352,18 +1370,26 @@ intptr_t ObjectMonitor::complete_exit(TRAPS) {
   return save;
 }
 
+void ObjectMonitor::install_displaced_markword_in_object(oop obj) {
+  markOop dmw = header();
+  assert(dmw->is_neutral(), "invariant");
+  Atomic::cmpxchg_ptr(dmw, obj->mark_addr(), markOopDesc::encode(this));
+}
+
 // reenter() enters a lock and sets recursion count
 // complete_exit/reenter operate as a wait without waiting
-void ObjectMonitor::reenter(intptr_t recursions, TRAPS) {
+bool ObjectMonitor::reenter(intptr_t recursions, TRAPS) {
   Thread * const Self = THREAD;
   assert(Self->is_Java_thread(), "Must be Java thread!");
   JavaThread *jt = (JavaThread *)THREAD;
 
   guarantee(_owner != Self, "reenter already owner");
-  enter(THREAD);       // enter the monitor
+  if (!enter(THREAD)) {       // enter the monitor
+    return false;
+  }
   guarantee(_recursions == 0, "reenter recursion");
   _recursions = recursions;
-  return;
+  return true;
 }
 
 
@@ -1601,7 +1627,9 @@ void ObjectMonitor::wait(jlong millis, bool interruptible, TRAPS) {
     assert(_owner != Self, "invariant");
     ObjectWaiter::TStates v = node.TState;
     if (v == ObjectWaiter::TS_RUN) {
-      enter(Self);
+      // _waiters keeps the monitor from being deflated
+      bool entered = enter(Self);
+      guarantee(entered, "invariant");
     } else {
       guarantee(v == ObjectWaiter::TS_ENTER || v == ObjectWaiter::TS_CXQ, "invariant");
       ReenterI(Self, &node);
@@ -2224,7 +2252,7 @@ int ObjectMonitor::TrySpin_VaryDuration(Thread * Self) {
 
 int ObjectMonitor::NotRunnable(Thread * Self, Thread * ox) {
   // Check ox->TypeTag == 2BAD.
-  if (ox == NULL) return 0;
+  if (ox == NULL || ox == DEFLATER_MARKER) return 0;
 
   // Avoid transitive spinning ...
   // Say T1 spins or blocks trying to acquire L.  T1._Stalled is set to L.
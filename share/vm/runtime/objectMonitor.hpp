@@ -59,6 +59,13 @@ class ObjectWaiter : public StackObj {
 // forward declaration to avoid include tracing.hpp
 class EventJavaMonitorWait;
 
+// With -XX:+AsyncDeflateIdleMonitors a deflating thread claims an idle
+// monitor by setting _owner to DEFLATER_MARKER, and commits the deflation
+// by making a zero _count negative. Entering threads that increment _count
+// first keep the monitor alive; those that come later see the negative
+// count and retry on the restored object header.
+#define DEFLATER_MARKER reinterpret_cast<void*>(-1)
+
 // The ObjectMonitor class implements the heavyweight version of a
 // JavaMonitor. The lightweight BasicLock/stack lock version has been
 // inflated into an ObjectMonitor. This inflation is typically due to
@@ -169,6 +176,7 @@ class ObjectMonitor {
   volatile jint  _count;            // reference count to prevent reclamation/deflation
                                     // at stop-the-world time.  See deflate_idle_monitors().
                                     // _count is approximately |_WaitSet| + |_EntryList|
+                                    // Negative once a concurrent deflation has committed.
  protected:
   ObjectWaiter * volatile _WaitSet; // LL of threads wait()ing on the monitor
   volatile jint  _waiters;          // number of waiting threads
@@ -259,6 +267,16 @@ class ObjectMonitor {
 
   intptr_t  is_entered(Thread* current) const;
 
+  // Concurrent deflation (AsyncDeflateIdleMonitors)
+  bool      is_being_async_deflated() const {
+    return _owner == DEFLATER_MARKER && _count < 0;
+  }
+  // Restore the displaced header into obj if its mark still refers to
+  // this monitor.  Racing callers are harmless: only one CAS succeeds.
+  void      install_displaced_markword_in_object(oop obj);
+  // Reset a deflated monitor before it goes back on the free list
+  void      clear_deflated();
+
   void*     owner() const;
   void      set_owner(void* owner);
 
@@ -318,7 +336,9 @@ class ObjectMonitor {
 #endif
 
   bool      try_enter(TRAPS);
-  void      enter(TRAPS);
+  // Returns false if the monitor was deflated concurrently; the caller
+  // must then re-inflate the object and retry.
+  bool      enter(TRAPS);
   void      exit(bool not_suspended, TRAPS);
   void      wait(jlong millis, bool interruptable, TRAPS);
   void      notify(TRAPS);
@@ -326,7 +346,7 @@ class ObjectMonitor {
 
 // Use the following at your own risk
   intptr_t  complete_exit(TRAPS);
-  void      reenter(intptr_t recursions, TRAPS);
+  bool      reenter(intptr_t recursions, TRAPS);
 
  private:
   void      AddWaiter(ObjectWaiter * waiter);
@@ -48,8 +48,10 @@ inline jint ObjectMonitor::waiters() const {
   return _waiters;
 }
 
+// A deflating thread is not an owner.
 inline void* ObjectMonitor::owner() const {
-  return _owner;
+  void* owner = _owner;
+  return owner != DEFLATER_MARKER ? owner : NULL;
 }
 
 inline void ObjectMonitor::clear() {
@@ -64,6 +66,18 @@ inline void ObjectMonitor::clear() {
   _object = NULL;
 }
 
+inline void ObjectMonitor::clear_deflated() {
+  assert(is_being_async_deflated(), "Fatal logic error in ObjectMonitor deflation!");
+  assert(_waiters == 0, "Fatal logic error in ObjectMonitor waiters!");
+  assert(_recursions == 0, "Fatal logic error in ObjectMonitor recursions!");
+  assert(_cxq == NULL && _EntryList == NULL, "Fatal logic error in ObjectMonitor queues!");
+
+  _count  = 0;
+  _owner  = NULL;
+  _header = NULL;
+  _object = NULL;
+}
+
 
 inline void* ObjectMonitor::object() const {
   return _object;
@@ -93,7 +107,8 @@ inline bool ObjectMonitor::check(TRAPS) {
 
 // return number of threads contending for this monitor
 inline jint ObjectMonitor::contentions() const {
-  return _count;
+  jint count = _count;
+  return count > 0 ? count : 0;
 }
 
 // Do NOT set _count = 0. There is a race such that _count could
@@ -60,6 +60,9 @@
 #include "utilities/events.hpp"
 
 # include <signal.h>
+#ifdef TARGET_OS_FAMILY_linux
+# include "osContainer_linux.hpp"
+#endif
 
 PRAGMA_FORMAT_MUTE_WARNINGS_FOR_GCC
 
@@ -313,6 +316,11 @@ static void signal_thread_entry(JavaThread* thread, TRAPS) {
 }
 
 void os::init_before_ergo() {
+#ifdef TARGET_OS_FAMILY_linux
+  // The container limits bound the memory and processor counts that
+  // ergonomics sizes the heap and the GC and compiler threads from.
+  OSContainer::init();
+#endif
   // We need to initialize large page support here because ergonomics takes some
   // decisions depending on large page support and the calculated large page size.
   large_page_init();
@@ -1571,10 +1579,16 @@ bool os::release_memory(char* addr, size_t bytes) {
   return res;
 }
 
-void os::pretouch_memory(char* start, char* end) {
-  for (volatile char *p = start; p < end; p += os::vm_page_size()) {
+void os::pretouch_memory(char* start, char* end, size_t page_size) {
+  assert(page_size > 0 && is_size_aligned(page_size, os::vm_page_size()),
+         err_msg("bad page size " SIZE_FORMAT, page_size));
+  for (volatile char *p = start; p < end; p += page_size) {
     *p = 0;
   }
+  // If start is not page aligned the last page may have been skipped.
+  if (start < end && page_size > (size_t)os::vm_page_size()) {
+    *(volatile char*)(end - 1) = 0;
+  }
 }
 
 char* os::map_memory(int fd, const char* file_name, size_t file_offset,
@@ -321,7 +321,10 @@ class os: AllStatic {
   // to make the OS back the memory range with actual memory.
   // Current implementation may not touch the last page if unaligned addresses
   // are passed.
-  static void   pretouch_memory(char* start, char* end);
+  // Touch [start, end) once every page_size bytes; page_size is the
+  // size of the pages backing the range.
+  static void   pretouch_memory(char* start, char* end,
+                                size_t page_size = os::vm_page_size());
 
   enum ProtType { MEM_PROT_NONE, MEM_PROT_READ, MEM_PROT_RW, MEM_PROT_RWX };
   static bool   protect_memory(char* addr, size_t bytes, ProtType prot,
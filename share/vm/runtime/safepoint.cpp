@@ -46,6 +46,7 @@
 #include "runtime/orderAccess.inline.hpp"
 #include "runtime/osThread.hpp"
 #include "runtime/safepoint.hpp"
+#include "runtime/safepointMechanism.inline.hpp"
 #include "runtime/signature.hpp"
 #include "runtime/stubCodeGenerator.hpp"
 #include "runtime/stubRoutines.hpp"
@@ -76,6 +77,7 @@ long  SafepointSynchronize::_end_of_last_safepoint = 0;
 static volatile int PageArmed = 0 ;        // safepoint polling page is RO|RW vs PROT_NONE
 static volatile int TryingToBlock = 0 ;    // proximate value -- for advisory use only
 static bool timeout_error_printed = false;
+static bool stragglers_recorded = false;
 
 // Roll all threads forward to a safepoint and suspend them all
 void SafepointSynchronize::begin() {
@@ -125,7 +127,10 @@ void SafepointSynchronize::begin() {
   // Save the starting time, so that it can be compared to see if this has taken
   // too long to complete.
   jlong safepoint_limit_time;
+  jlong straggler_limit_time;
+  jlong sync_start = os::javaTimeNanos();
   timeout_error_printed = false;
+  stragglers_recorded = false;
 
   // PrintSafepointStatisticsTimeout can be specified separately. When
   // specified, PrintSafepointStatistics will be set to true in
@@ -162,7 +167,9 @@ void SafepointSynchronize::begin() {
   //     on every call to native code.
   //  3. Running compiled Code
   //     Compiled code reads a global (Safepoint Polling) page that
-  //     is set to fault if we are trying to get to a safepoint.
+  //     is set to fault if we are trying to get to a safepoint. With
+  //     thread-local polls every thread's poll word is armed instead,
+  //     see SafepointMechanism.
   //  4. Blocked
   //     A thread which is blocked will not be allowed to return from the
   //     block condition until the safepoint operation is complete.
@@ -182,7 +189,14 @@ void SafepointSynchronize::begin() {
   // Make interpreter safepoint aware
   Interpreter::notice_safepoints();
 
-  if (DeferPollingPageLoopCount < 0) {
+  if (SafepointMechanism::uses_thread_local_poll()) {
+    // Arm the local polls of all threads. No handshake can be in
+    // progress since the VM thread is here.
+    for (JavaThread *cur = Threads::first(); cur != NULL; cur = cur->next()) {
+      SafepointMechanism::arm_local_poll(cur);
+    }
+    OrderAccess::fence();
+  } else if (DeferPollingPageLoopCount < 0) {
     // Make polling safepoint aware
     guarantee (PageArmed == 0, "invariant") ;
     PageArmed = 1 ;
@@ -203,6 +217,9 @@ void SafepointSynchronize::begin() {
   if (SafepointTimeout)
     safepoint_limit_time = os::javaTimeNanos() + (jlong)SafepointTimeoutDelay * MICROUNITS;
 
+  if (ReportSafepointStragglers)
+    straggler_limit_time = sync_start + (jlong)SafepointStragglerDelay * MICROUNITS;
+
   // Iterate through all threads until it have been determined how to stop them all at a safepoint
   unsigned int iterations = 0;
   int steps = 0 ;
@@ -235,6 +252,11 @@ void SafepointSynchronize::begin() {
         print_safepoint_timeout(_spinning_timeout);
       }
 
+      if (ReportSafepointStragglers && !stragglers_recorded &&
+          straggler_limit_time < os::javaTimeNanos()) {
+        record_safepoint_stragglers(_spinning_timeout, sync_start);
+      }
+
       // Spin to avoid context switching.
       // There's a tension between allowing the mutators to run (and rendezvous)
       // vs spinning.  As the VM thread spins, wasting cycles, it consumes CPU that
@@ -288,7 +310,8 @@ void SafepointSynchronize::begin() {
       // 9. On windows consider using the return value from SwitchThreadTo()
       //    to drive subsequent spin/SwitchThreadTo()/Sleep(N) decisions.
 
-      if (int(iterations) == DeferPollingPageLoopCount) {
+      if (int(iterations) == DeferPollingPageLoopCount &&
+          !SafepointMechanism::uses_thread_local_poll()) {
          guarantee (PageArmed == 0, "invariant") ;
          PageArmed = 1 ;
          os::make_polling_page_unreadable();
@@ -319,20 +342,39 @@ void SafepointSynchronize::begin() {
   // wait until all threads are stopped
   while (_waiting_to_block > 0) {
     if (TraceSafepoint) tty->print_cr("Waiting for %d thread(s) to block", _waiting_to_block);
-    if (!SafepointTimeout || timeout_error_printed) {
+    bool check_timeout = SafepointTimeout && !timeout_error_printed;
+    bool check_stragglers = ReportSafepointStragglers && !stragglers_recorded;
+    if (!check_timeout && !check_stragglers) {
       Safepoint_lock->wait(true);  // true, means with no safepoint checks
     } else {
-      // Compute remaining time
-      jlong remaining_time = safepoint_limit_time - os::javaTimeNanos();
+      // Wake up at whichever limit comes first
+      jlong limit_time = check_timeout ? safepoint_limit_time : straggler_limit_time;
+      if (check_timeout && check_stragglers) {
+        limit_time = MIN2(safepoint_limit_time, straggler_limit_time);
+      }
+
+      // Compute remaining time; a wait of 0 ms would never time out
+      jlong remaining_time = limit_time - os::javaTimeNanos();
 
-      // If there is no remaining time, then there is an error
-      if (remaining_time < 0 || Safepoint_lock->wait(true, remaining_time / MICROUNITS)) {
-        print_safepoint_timeout(_blocking_timeout);
+      if (remaining_time < MICROUNITS || Safepoint_lock->wait(true, remaining_time / MICROUNITS)) {
+        jlong current_time = os::javaTimeNanos();
+        if (check_stragglers && straggler_limit_time <= current_time) {
+          record_safepoint_stragglers(_blocking_timeout, sync_start);
+        }
+        // If there is no remaining time, then there is an error
+        if (check_timeout && safepoint_limit_time <= current_time) {
+          print_safepoint_timeout(_blocking_timeout);
+        }
       }
     }
   }
   assert(_waiting_to_block == 0, "sanity check");
 
+  if (stragglers_recorded) {
+    Events::log_safepoint_straggler(NULL, "Safepoint synchronization done after " INT64_FORMAT " ms",
+                                    (os::javaTimeNanos() - sync_start) / MICROUNITS);
+  }
+
 #ifndef PRODUCT
   if (SafepointTimeout) {
     jlong current_time = os::javaTimeNanos();
@@ -417,6 +459,12 @@ void SafepointSynchronize::end() {
     PageArmed = 0 ;
   }
 
+  if (SafepointMechanism::uses_thread_local_poll()) {
+    for (JavaThread *cur = Threads::first(); cur != NULL; cur = cur->next()) {
+      SafepointMechanism::disarm_local_poll(cur);
+    }
+  }
+
   // Remove safepoint check from interpreter
   Interpreter::ignore_safepoints();
 
@@ -486,7 +534,8 @@ bool SafepointSynchronize::is_cleanup_needed() {
 
 // Various cleaning tasks that should be done periodically at safepoints
 void SafepointSynchronize::do_cleanup_tasks() {
-  {
+  if (!AsyncDeflateIdleMonitors) {
+    // Otherwise the service thread deflates them concurrently
     TraceTime t1("deflating idle monitors", TraceSafepointCleanupTime);
     ObjectSynchronizer::deflate_idle_monitors();
   }
@@ -723,7 +772,8 @@ void SafepointSynchronize::block(JavaThread *thread) {
 void SafepointSynchronize::handle_polling_page_exception(JavaThread *thread) {
   assert(thread->is_Java_thread(), "polling reference encountered by VM thread");
   assert(thread->thread_state() == _thread_in_Java, "should come from Java code");
-  assert(SafepointSynchronize::is_synchronizing(), "polling encountered outside safepoint synchronization");
+  assert(SafepointSynchronize::is_synchronizing() || SafepointMechanism::uses_thread_local_poll(),
+         "polling encountered outside safepoint synchronization");
 
   if (ShowSafepointMsgs) {
     tty->print("handle_polling_page_exception: ");
@@ -783,6 +833,109 @@ void SafepointSynchronize::print_safepoint_timeout(SafepointTimeoutReason reason
 }
 
 
+// Samples the pc and stack top of a thread that is late to reach the
+// safepoint.  do_task() runs while the thread is suspended, so it only
+// reads the context; the pc is resolved after the thread is resumed.
+class SafepointStragglerSampler : public os::SuspendedThreadTask {
+ public:
+  SafepointStragglerSampler(Thread* thread) : os::SuspendedThreadTask(thread), _pc(NULL), _sp(NULL) {}
+  address pc() const    { return _pc; }
+  intptr_t* sp() const  { return _sp; }
+ protected:
+  void do_task(const os::SuspendedThreadTaskContext& context) {
+    intptr_t* fp;
+    _pc = os::fetch_frame_from_context(context.ucontext(), &_sp, &fp).pc();
+  }
+ private:
+  address   _pc;
+  intptr_t* _sp;
+};
+
+extern const char* _get_thread_state_name(JavaThreadState _thread_state);
+
+// Describe what is executing at pc: the nearest scope of an nmethod, the
+// interpreter, a stub or a native function.
+static void describe_straggler_pc(address pc, char* buf, int buflen) {
+  if (pc == NULL) {
+    jio_snprintf(buf, buflen, "no pc");
+    return;
+  }
+  if (Interpreter::contains(pc)) {
+    jio_snprintf(buf, buflen, "interpreter");
+    return;
+  }
+  // The sweeper flushes nmethods under the CodeCache_lock. Do not wait for
+  // it here, the straggler may be the thread holding it.
+  if (!CodeCache_lock->try_lock()) {
+    jio_snprintf(buf, buflen, "code cache busy");
+    return;
+  }
+  CodeBlob* cb = CodeCache::find_blob_unsafe(pc);
+  if (cb != NULL && cb->is_nmethod()) {
+    nmethod* nm = (nmethod*)cb;
+    PcDesc* pd = nm->is_alive() ? nm->pc_desc_near(pc) : NULL;
+    if (pd != NULL) {
+      ScopeDesc* sd = nm->scope_desc_at(pd->real_pc(nm));
+      jio_snprintf(buf, buflen, "%s @ bci %d (nmethod " INTPTR_FORMAT " level %d)",
+                   sd->method()->name_and_sig_as_C_string(), sd->bci(),
+                   p2i(nm), nm->comp_level());
+    } else {
+      jio_snprintf(buf, buflen, "nmethod " INTPTR_FORMAT ", not alive", p2i(nm));
+    }
+  } else if (cb != NULL) {
+    StubCodeDesc* desc = StubCodeDesc::desc_for(pc);
+    jio_snprintf(buf, buflen, "stub %s", desc != NULL ? desc->name() : cb->name());
+  }
+  CodeCache_lock->unlock();
+  if (cb == NULL) {
+    char name[128];
+    int offset;
+    if (os::dll_address_to_function_name(pc, name, sizeof(name), &offset)) {
+      jio_snprintf(buf, buflen, "%s+%d", name, offset);
+    } else {
+      jio_snprintf(buf, buflen, "unknown");
+    }
+  }
+}
+
+void SafepointSynchronize::record_safepoint_stragglers(SafepointTimeoutReason phase, jlong sync_start) {
+  assert(Threads_lock->owned_by_self(), "must hold Threads_lock");
+  stragglers_recorded = true;
+
+  VM_Operation *op = VMThread::vm_operation();
+  Events::log_safepoint_straggler(NULL, "Safepoint %d (%s) not reached after " INT64_FORMAT " ms, "
+                                  "threads still %s:", _safepoint_counter,
+                                  op != NULL ? op->name() : "no vm operation",
+                                  (os::javaTimeNanos() - sync_start) / MICROUNITS,
+                                  phase == _spinning_timeout ? "running" : "not blocked");
+
+  // Same selection as print_safepoint_timeout
+  for (JavaThread *cur_thread = Threads::first(); cur_thread != NULL;
+       cur_thread = cur_thread->next()) {
+    ThreadSafepointState *cur_state = cur_thread->safepoint_state();
+    if (cur_thread->thread_state() != _thread_blocked &&
+        ((phase == _spinning_timeout && cur_state->is_running()) ||
+         (phase == _blocking_timeout && !cur_state->has_called_back()))) {
+      record_safepoint_straggler(cur_thread);
+    }
+  }
+}
+
+void SafepointSynchronize::record_safepoint_straggler(JavaThread* thread) {
+  ResourceMark rm;
+  JavaThreadState state = thread->thread_state();
+
+  SafepointStragglerSampler sampler(thread);
+  sampler.run();
+
+  char where[256];
+  describe_straggler_pc(sampler.pc(), where, sizeof(where));
+  Events::log_safepoint_straggler(thread, "  \"%s\" %s sp=" INTPTR_FORMAT " pc=" INTPTR_FORMAT " %s",
+                                  thread->get_thread_name(), _get_thread_state_name(state),
+                                  p2i(sampler.sp()), p2i(sampler.pc()), where);
+}
+
+
 // -------------------------------------------------------------------------------------------------------
 // Implementation of ThreadSafepointState
 
@@ -973,8 +1126,8 @@ void ThreadSafepointState::handle_polling_page_exception() {
       assert(Universe::heap()->is_in_or_null(result), "must be heap pointer");
     }
 
-    // Block the thread
-    SafepointSynchronize::block(thread());
+    // Block the thread, or process its handshake
+    SafepointMechanism::block_if_requested(thread());
 
     // restore oop result, if any
     if (return_oop) {
@@ -989,8 +1142,8 @@ void ThreadSafepointState::handle_polling_page_exception() {
     // verify the blob built the "return address" correctly
     assert(real_return_addr == caller_fr.pc(), "must match");
 
-    // Block the thread
-    SafepointSynchronize::block(thread());
+    // Block the thread, or process its handshake
+    SafepointMechanism::block_if_requested(thread());
     set_at_poll_safepoint(false);
 
     // If we have a pending async exception deoptimize the frame
@@ -129,6 +129,10 @@ private:
   // For debug long safepoint
   static void print_safepoint_timeout(SafepointTimeoutReason timeout_reason);
 
+  // Record the threads that are late to reach the safepoint (ReportSafepointStragglers)
+  static void record_safepoint_stragglers(SafepointTimeoutReason phase, jlong sync_start);
+  static void record_safepoint_straggler(JavaThread* thread);
+
 public:
 
   // Main entry points
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "runtime/globals_extension.hpp"
+#include "runtime/handshake.hpp"
+#include "runtime/os.hpp"
+#include "runtime/safepointMechanism.inline.hpp"
+
+void* SafepointMechanism::_poll_armed_value = NULL;
+void* SafepointMechanism::_poll_disarmed_value = NULL;
+
+void SafepointMechanism::default_initialize() {
+  if (!uses_thread_local_poll()) {
+    return;
+  }
+
+  // The page the poll word points to between requests. The armed value
+  // points into the global polling page, which is protected once and for
+  // all here and recognized by the signal handlers as before.
+  const size_t page_size = os::vm_page_size();
+  char* good_page = os::reserve_memory(page_size, NULL, page_size);
+  if (good_page == NULL) {
+    vm_exit_during_initialization("Unable to reserve the thread-local polling page");
+  }
+  os::commit_memory_or_exit(good_page, page_size, false,
+                            "Unable to commit the thread-local polling page");
+  os::protect_memory(good_page, page_size, os::MEM_PROT_READ);
+  os::make_polling_page_unreadable();
+
+  _poll_armed_value    = reinterpret_cast<void*>(reinterpret_cast<intptr_t>(os::get_polling_page()) | poll_bit());
+  _poll_disarmed_value = reinterpret_cast<void*>(good_page);
+
+  if (PrintSafepointStatistics || TraceSafepoint) {
+    tty->print_cr("Thread-local polling: armed " PTR_FORMAT ", disarmed " PTR_FORMAT,
+                  p2i(_poll_armed_value), p2i(_poll_disarmed_value));
+  }
+}
+
+void SafepointMechanism::initialize() {
+#ifndef THREAD_LOCAL_POLL
+  if (ThreadLocalHandshakes) {
+    if (!FLAG_IS_DEFAULT(ThreadLocalHandshakes)) {
+      warning("ThreadLocalHandshakes is not supported on this platform");
+    }
+    FLAG_SET_DEFAULT(ThreadLocalHandshakes, false);
+  }
+#endif
+  default_initialize();
+}
+
+void SafepointMechanism::block_if_requested(JavaThread* thread) {
+  // Read the global state and the handshake operation after the poll.
+  OrderAccess::loadload();
+  if (global_poll()) {
+    SafepointSynchronize::block(thread);
+  }
+  if (uses_thread_local_poll()) {
+    OrderAccess::loadload();
+    if (thread->has_handshake()) {
+      thread->handshake_process_by_self();
+    }
+  }
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_RUNTIME_SAFEPOINTMECHANISM_HPP
+#define SHARE_VM_RUNTIME_SAFEPOINTMECHANISM_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/globals.hpp"
+#include "utilities/globalDefinitions.hpp"
+
+class JavaThread;
+class Thread;
+
+// Selects how Java threads are asked to stop: by the global polling page
+// and safepoint state, or, with -XX:+ThreadLocalHandshakes, by a poll word
+// in each JavaThread that the VM thread can arm for a single thread.
+//
+// With thread-local polls, JavaThread::_polling_page normally points to a
+// readable page. Arming it makes it point into the (permanently protected)
+// global polling page with the low poll bit set, so compiled code traps at
+// its next poll and the interpreter and the native transitions, which test
+// the bit, call into the VM. Global safepoints arm every thread.
+class SafepointMechanism : public AllStatic {
+  static void* _poll_armed_value;
+  static void* _poll_disarmed_value;
+
+  static void default_initialize();
+
+ public:
+  static inline bool uses_thread_local_poll() {
+#ifdef THREAD_LOCAL_POLL
+    return ThreadLocalHandshakes;
+#else
+    return false;
+#endif
+  }
+
+  static intptr_t poll_bit()           { return 1; }
+  static void* poll_armed_value()      { return _poll_armed_value; }
+  static void* poll_disarmed_value()   { return _poll_disarmed_value; }
+
+  // Is a global safepoint in progress
+  static inline bool global_poll();
+  // Is the thread's poll armed, for a safepoint or a handshake
+  static inline bool local_poll_armed(JavaThread* thread);
+
+  // Should the thread call block_if_requested() at its next transition
+  static inline bool should_block(JavaThread* thread);
+  // Block for a safepoint and/or process a pending handshake
+  static void block_if_requested(JavaThread* thread);
+
+  static inline void arm_local_poll(JavaThread* thread);
+  static inline void disarm_local_poll(JavaThread* thread);
+
+  // Called after os::init_2(), before the first JavaThread is created
+  static void initialize();
+};
+
+#endif // SHARE_VM_RUNTIME_SAFEPOINTMECHANISM_HPP
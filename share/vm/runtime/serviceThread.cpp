@@ -28,12 +28,17 @@
 #include "runtime/serviceThread.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
+#include "runtime/synchronizer.hpp"
 #include "prims/jvmtiImpl.hpp"
 #include "services/allocationContextService.hpp"
 #include "services/diagnosticArgument.hpp"
 #include "services/diagnosticFramework.hpp"
 #include "services/gcNotifier.hpp"
 #include "services/lowMemoryDetector.hpp"
+#include "utilities/macros.hpp"
+#if INCLUDE_ALL_GCS
+#include "gc_implementation/parallelScavenge/psPeriodicGC.hpp"
+#endif // INCLUDE_ALL_GCS
 
 ServiceThread* ServiceThread::_instance = NULL;
 
@@ -82,6 +87,14 @@ void ServiceThread::initialize() {
   }
 }
 
+static bool has_periodic_gc_request_pending() {
+#if INCLUDE_ALL_GCS
+  return PSPeriodicGC::has_pending_request();
+#else
+  return false;
+#endif // INCLUDE_ALL_GCS
+}
+
 void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
   while (true) {
     bool sensors_changed = false;
@@ -89,6 +102,8 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
     bool has_gc_notification_event = false;
     bool has_dcmd_notification_event = false;
     bool acs_notify = false;
+    bool has_periodic_gc_request = false;
+    bool deflate_idle_monitors = false;
     JvmtiDeferredEvent jvmti_event;
     {
       // Need state transition ThreadBlockInVM so that this thread
@@ -106,10 +121,15 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
              !(has_jvmti_events = JvmtiDeferredEventQueue::has_events()) &&
               !(has_gc_notification_event = GCNotifier::has_event()) &&
               !(has_dcmd_notification_event = DCmdFactory::has_pending_jmx_notification()) &&
-             !(acs_notify = AllocationContextService::should_notify())) {
+             !(acs_notify = AllocationContextService::should_notify()) &&
+             !(has_periodic_gc_request = has_periodic_gc_request_pending()) &&
+             !(deflate_idle_monitors = ObjectSynchronizer::is_async_deflation_needed())) {
         // wait until one of the sensors has pending requests, or there is a
-        // pending JVMTI event or JMX GC notification to post
-        Service_lock->wait(Mutex::_no_safepoint_check_flag);
+        // pending JVMTI event or JMX GC notification to post; with
+        // AsyncDeflateIdleMonitors wake up periodically to check the
+        // monitor population
+        Service_lock->wait(Mutex::_no_safepoint_check_flag,
+                           AsyncDeflateIdleMonitors ? AsyncDeflationInterval : 0);
       }
 
       if (has_jvmti_events) {
@@ -136,6 +156,16 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
     if (acs_notify) {
       AllocationContextService::notify(CHECK);
     }
+
+#if INCLUDE_ALL_GCS
+    if (has_periodic_gc_request) {
+      PSPeriodicGC::do_periodic_gc();
+    }
+#endif // INCLUDE_ALL_GCS
+
+    if (deflate_idle_monitors) {
+      ObjectSynchronizer::deflate_idle_monitors_concurrently(jt);
+    }
   }
 }
 
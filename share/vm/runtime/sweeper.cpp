@@ -32,9 +32,11 @@
 #include "oops/method.hpp"
 #include "runtime/atomic.inline.hpp"
 #include "runtime/compilationPolicy.hpp"
+#include "runtime/handshake.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/orderAccess.inline.hpp"
 #include "runtime/os.hpp"
+#include "runtime/safepointMechanism.hpp"
 #include "runtime/sweeper.hpp"
 #include "runtime/thread.inline.hpp"
 #include "runtime/vm_operations.hpp"
@@ -202,10 +204,25 @@ bool NMethodSweeper::wait_for_stack_scanning() {
   */
 void NMethodSweeper::mark_active_nmethods() {
   assert(SafepointSynchronize::is_at_safepoint(), "must be executed at a safepoint");
+  CodeBlobClosure* cl = prepare_mark_active_nmethods();
+  if (cl != NULL) {
+    Threads::nmethods_do(cl);
+  }
+  OrderAccess::storestore();
+}
+
+/**
+  * Updates the sweeper state for a stack scan and returns the closure to apply
+  * to the nmethods on the stacks, or NULL if no scan is needed. Called at a
+  * safepoint or with the CodeCache_lock held.
+  */
+CodeBlobClosure* NMethodSweeper::prepare_mark_active_nmethods() {
+  assert(SafepointSynchronize::is_at_safepoint() || CodeCache_lock->owned_by_self(),
+         "must be executed at a safepoint or under the CodeCache_lock");
   // If we do not want to reclaim not-entrant or zombie methods there is no need
   // to scan stacks
   if (!MethodFlushing) {
-    return;
+    return NULL;
   }
 
   // Increase time so that we can estimate when to invoke the sweeper again.
@@ -224,25 +241,48 @@ void NMethodSweeper::mark_active_nmethods() {
     if (PrintMethodFlushing) {
       tty->print_cr("### Sweep: stack traversal %d", _traversals);
     }
-    Threads::nmethods_do(&mark_activation_closure);
+    return &mark_activation_closure;
 
   } else {
     // Only set hotness counter
-    Threads::nmethods_do(&set_hotness_closure);
+    return &set_hotness_closure;
   }
-
-  OrderAccess::storestore();
 }
 
+class NMethodMarkingClosure : public HandshakeClosure {
+  CodeBlobClosure* _cl;
+ public:
+  NMethodMarkingClosure(CodeBlobClosure* cl) : HandshakeClosure("NMethodMarking"), _cl(cl) {}
+  void do_thread(Thread* thread) {
+    if (thread->is_Java_thread()) {
+      ((JavaThread*)thread)->nmethods_do(_cl);
+    }
+  }
+};
+
 /**
   * This function triggers a VM operation that does stack scanning of active
   * methods. Stack scanning is mandatory for the sweeper to make progress.
+  * With thread-local polls the stacks are scanned in a handshake, so the
+  * Java threads are not stopped all at once.
   */
 void NMethodSweeper::do_stack_scanning() {
   assert(!CodeCache_lock->owned_by_self(), "just checking");
   if (wait_for_stack_scanning()) {
-    VM_MarkActiveNMethods op;
-    VMThread::execute(&op);
+    if (SafepointMechanism::uses_thread_local_poll()) {
+      CodeBlobClosure* code_cl;
+      {
+        MutexLockerEx ccl(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+        code_cl = prepare_mark_active_nmethods();
+      }
+      if (code_cl != NULL) {
+        NMethodMarkingClosure hs_cl(code_cl);
+        Handshake::execute(&hs_cl);
+      }
+    } else {
+      VM_MarkActiveNMethods op;
+      VMThread::execute(&op);
+    }
     _should_sweep = true;
   }
 }
@@ -30,12 +30,14 @@
 #include "oops/oop.inline.hpp"
 #include "runtime/atomic.inline.hpp"
 #include "runtime/biasedLocking.hpp"
+#include "runtime/handshake.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/interfaceSupport.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/objectMonitor.hpp"
 #include "runtime/objectMonitor.inline.hpp"
 #include "runtime/osThread.hpp"
+#include "runtime/safepointMechanism.inline.hpp"
 #include "runtime/stubRoutines.hpp"
 #include "runtime/synchronizer.hpp"
 #include "runtime/thread.inline.hpp"
@@ -278,7 +280,9 @@ void ObjectSynchronizer::slow_enter(Handle obj, BasicLock* lock, TRAPS) {
   // must be non-zero to avoid looking like a re-entrant lock,
   // and must not look locked either.
   lock->set_displaced_header(markOopDesc::unused_mark());
-  ObjectSynchronizer::inflate(THREAD, obj())->enter(THREAD);
+  while (!ObjectSynchronizer::inflate(THREAD, obj())->enter(THREAD)) {
+    // The monitor was deflated concurrently, inflate again
+  }
 }
 
 // This routine is used to handle interpreter/compiler slow case
@@ -321,9 +325,9 @@ void ObjectSynchronizer::reenter(Handle obj, intptr_t recursion, TRAPS) {
     assert(!obj->mark()->has_bias_pattern(), "biases should be revoked by now");
   }
 
-  ObjectMonitor* monitor = ObjectSynchronizer::inflate(THREAD, obj());
-
-  monitor->reenter(recursion, THREAD);
+  while (!ObjectSynchronizer::inflate(THREAD, obj())->reenter(recursion, THREAD)) {
+    // The monitor was deflated concurrently, inflate again
+  }
 }
 // -----------------------------------------------------------------------------
 // JNI locks on java objects
@@ -336,7 +340,9 @@ void ObjectSynchronizer::jni_enter(Handle obj, TRAPS) {
     assert(!obj->mark()->has_bias_pattern(), "biases should be revoked by now");
   }
   THREAD->set_current_pending_monitor_is_from_java(false);
-  ObjectSynchronizer::inflate(THREAD, obj())->enter(THREAD);
+  while (!ObjectSynchronizer::inflate(THREAD, obj())->enter(THREAD)) {
+    // The monitor was deflated concurrently, inflate again
+  }
   THREAD->set_current_pending_monitor_is_from_java(true);
 }
 
@@ -641,75 +647,91 @@ intptr_t ObjectSynchronizer::FastHashCode(Thread * Self, oop obj) {
   ObjectMonitor* monitor = NULL;
   markOop temp, test;
   intptr_t hash;
-  markOop mark = ReadStableMark(obj);
 
-  // object should remain ineligible for biased locking
-  assert(!mark->has_bias_pattern(), "invariant");
+  for (;;) {
+    markOop mark = ReadStableMark(obj);
 
-  if (mark->is_neutral()) {
-    hash = mark->hash();              // this is a normal header
-    if (hash) {                       // if it has hash, just return it
-      return hash;
-    }
-    hash = get_next_hash(Self, obj);  // allocate a new hash code
-    temp = mark->copy_set_hash(hash); // merge the hash code into header
-    // use (machine word version) atomic operation to install the hash
-    test = (markOop) Atomic::cmpxchg_ptr(temp, obj->mark_addr(), mark);
-    if (test == mark) {
-      return hash;
-    }
-    // If atomic operation failed, we must inflate the header
-    // into heavy weight monitor. We could add more code here
-    // for fast path, but it does not worth the complexity.
-  } else if (mark->has_monitor()) {
-    monitor = mark->monitor();
-    temp = monitor->header();
-    assert(temp->is_neutral(), "invariant");
-    hash = temp->hash();
-    if (hash) {
-      return hash;
+    // object should remain ineligible for biased locking
+    assert(!mark->has_bias_pattern(), "invariant");
+
+    if (mark->is_neutral()) {
+      hash = mark->hash();              // this is a normal header
+      if (hash) {                       // if it has hash, just return it
+        return hash;
+      }
+      hash = get_next_hash(Self, obj);  // allocate a new hash code
+      temp = mark->copy_set_hash(hash); // merge the hash code into header
+      // use (machine word version) atomic operation to install the hash
+      test = (markOop) Atomic::cmpxchg_ptr(temp, obj->mark_addr(), mark);
+      if (test == mark) {
+        return hash;
+      }
+      // If atomic operation failed, we must inflate the header
+      // into heavy weight monitor. We could add more code here
+      // for fast path, but it does not worth the complexity.
+    } else if (mark->has_monitor()) {
+      monitor = mark->monitor();
+      temp = monitor->header();
+      assert(temp->is_neutral(), "invariant");
+      hash = temp->hash();
+      if (hash) {
+        // A hash read from a monitor that is being deflated concurrently
+        // may not make it back into the object header.
+        OrderAccess::loadload();
+        if (!(AsyncDeflateIdleMonitors && monitor->is_being_async_deflated())) {
+          return hash;
+        }
+        monitor->install_displaced_markword_in_object(obj);
+        continue;
+      }
+      // Skip to the following code to reduce code size
+    } else if (Self->is_lock_owned((address)mark->locker())) {
+      temp = mark->displaced_mark_helper(); // this is a lightweight monitor owned
+      assert(temp->is_neutral(), "invariant");
+      hash = temp->hash();              // by current thread, check if the displaced
+      if (hash) {                       // header contains hash code
+        return hash;
+      }
+      // WARNING:
+      //   The displaced header is strictly immutable.
+      // It can NOT be changed in ANY cases. So we have
+      // to inflate the header into heavyweight monitor
+      // even the current thread owns the lock. The reason
+      // is the BasicLock (stack slot) will be asynchronously
+      // read by other threads during the inflate() function.
+      // Any change to stack may not propagate to other threads
+      // correctly.
     }
-    // Skip to the following code to reduce code size
-  } else if (Self->is_lock_owned((address)mark->locker())) {
-    temp = mark->displaced_mark_helper(); // this is a lightweight monitor owned
-    assert(temp->is_neutral(), "invariant");
-    hash = temp->hash();              // by current thread, check if the displaced
-    if (hash) {                       // header contains hash code
-      return hash;
+
+    // Inflate the monitor to set hash code
+    monitor = ObjectSynchronizer::inflate(Self, obj);
+    // Load displaced header and check it has hash code
+    mark = monitor->header();
+    assert(mark->is_neutral(), "invariant");
+    hash = mark->hash();
+    if (hash == 0) {
+      hash = get_next_hash(Self, obj);
+      temp = mark->copy_set_hash(hash); // merge hash code into header
+      assert(temp->is_neutral(), "invariant");
+      test = (markOop) Atomic::cmpxchg_ptr(temp, monitor, mark);
+      if (test != mark) {
+        // The only update to the header in the monitor (outside GC)
+        // is install the hash code. If someone add new usage of
+        // displaced header, please update this code
+        hash = test->hash();
+        assert(test->is_neutral(), "invariant");
+        assert(hash != 0, "Trivial unexpected object/monitor header usage.");
+      }
     }
-    // WARNING:
-    //   The displaced header is strictly immutable.
-    // It can NOT be changed in ANY cases. So we have
-    // to inflate the header into heavyweight monitor
-    // even the current thread owns the lock. The reason
-    // is the BasicLock (stack slot) will be asynchronously
-    // read by other threads during the inflate() function.
-    // Any change to stack may not propagate to other threads
-    // correctly.
-  }
-
-  // Inflate the monitor to set hash code
-  monitor = ObjectSynchronizer::inflate(Self, obj);
-  // Load displaced header and check it has hash code
-  mark = monitor->header();
-  assert(mark->is_neutral(), "invariant");
-  hash = mark->hash();
-  if (hash == 0) {
-    hash = get_next_hash(Self, obj);
-    temp = mark->copy_set_hash(hash); // merge hash code into header
-    assert(temp->is_neutral(), "invariant");
-    test = (markOop) Atomic::cmpxchg_ptr(temp, monitor, mark);
-    if (test != mark) {
-      // The only update to the header in the monitor (outside GC)
-      // is install the hash code. If someone add new usage of
-      // displaced header, please update this code
-      hash = test->hash();
-      assert(test->is_neutral(), "invariant");
-      assert(hash != 0, "Trivial unexpected object/monitor header usage.");
+    OrderAccess::loadload();
+    if (AsyncDeflateIdleMonitors && monitor->is_being_async_deflated()) {
+      // The deflating thread may have restored the header without the hash.
+      monitor->install_displaced_markword_in_object(obj);
+      continue;
     }
+    // We finally get the hash
+    return hash;
   }
-  // We finally get the hash
-  return hash;
 }
 
 // Deprecated -- use FastHashCode() instead.
@@ -780,7 +802,7 @@ ObjectSynchronizer::LockOwnership ObjectSynchronizer::query_lock_ownership
   // The Object:ObjectMonitor relationship is stable as long as we're
   // not at a safepoint.
   if (mark->has_monitor()) {
-    void * owner = mark->monitor()->_owner;
+    void * owner = mark->monitor()->owner();
     if (owner == NULL) return owner_none;
     return (owner == self ||
             self->is_lock_owned((address)owner)) ? owner_self : owner_other;
@@ -918,6 +940,12 @@ static void InduceScavenge(Thread * Self, const char * Whence) {
   // TODO: assert thread state is reasonable
 
   if (ForceMonitorScavenge == 0 && Atomic::xchg (1, &ForceMonitorScavenge) == 0) {
+    if (AsyncDeflateIdleMonitors) {
+      // No safepoint needed, the service thread deflates the idle monitors
+      MutexLockerEx ml(Service_lock, Mutex::_no_safepoint_check_flag);
+      Service_lock->notify_all();
+      return;
+    }
     if (ObjectMonitor::Knob_Verbose) {
       ::printf ("Monitor scavenge - Induced STW @%s (%d)\n", Whence, ForceMonitorScavenge) ;
       ::fflush(stdout);
@@ -1231,6 +1259,11 @@ ObjectMonitor * NOINLINE ObjectSynchronizer::inflate(Thread * Self,
     // CASE: inflated
     if (mark->has_monitor()) {
       ObjectMonitor * inf = mark->monitor();
+      if (AsyncDeflateIdleMonitors && inf->is_being_async_deflated()) {
+        // Help the deflating thread restore the header, then inflate anew
+        inf->install_displaced_markword_in_object(object);
+        continue;
+      }
       assert(inf->header()->is_neutral(), "invariant");
       assert(inf->object() == object, "invariant");
       assert(ObjectSynchronizer::verify_objmon_isinpool(inf), "monitor is invalid");
@@ -1429,7 +1462,8 @@ ObjectMonitor * NOINLINE ObjectSynchronizer::inflate(Thread * Self,
 
 enum ManifestConstants {
   ClearResponsibleAtSTW   = 0,
-  MaximumRecheckInterval  = 1000
+  MaximumRecheckInterval  = 1000,
+  MonitorsPerSafepointCheck = 1024
 };
 
 // Deflate a single monitor if not in use
@@ -1611,6 +1645,201 @@ void ObjectSynchronizer::deflate_idle_monitors() {
   GVars.stwCycle++;
 }
 
+// Concurrent deflation (AsyncDeflateIdleMonitors)
+//
+// The service thread deflates idle monitors while the mutators run, so
+// the safepoint cleanup no longer has to walk the monitor population:
+//
+// 1. A handshake moves each thread's omInUseList to gOmInUseList, one
+//    thread at a time, without stopping the others.
+// 2. The service thread detaches gOmInUseList and walks it privately,
+//    letting safepoints through between batches.  An idle monitor is
+//    deflated with the DEFLATER_MARKER/_count protocol described in
+//    objectMonitor.hpp; busy monitors go back to gOmInUseList.
+// 3. A second handshake makes sure no thread still looks at a monitor it
+//    picked up from an object header before the header was restored.
+//    Only then are the deflated monitors put back on gFreeList.
+
+static jlong last_async_deflation_time = 0;   // os::javaTimeMillis()
+
+bool ObjectSynchronizer::is_async_deflation_needed() {
+  if (!AsyncDeflateIdleMonitors) {
+    return false;
+  }
+  if (ForceMonitorScavenge != 0) {
+    return true;    // MonitorBound exceeded, see InduceScavenge()
+  }
+  if (AsyncDeflationInterval > 0 &&
+      os::javaTimeMillis() - last_async_deflation_time > AsyncDeflationInterval) {
+    int population = MonitorPopulation;
+    if (population > 0) {
+      jlong in_use = population - MonitorFreeCount;
+      return in_use * 100 / population > MonitorUsedDeflationThreshold;
+    }
+  }
+  return false;
+}
+
+// Deflate a single monitor if not in use, without a safepoint.
+// Return true if deflated, false if in use
+bool ObjectSynchronizer::deflate_monitor_concurrently(ObjectMonitor* mid,
+                                                      JavaThread* self) {
+  if (mid->is_busy()) {
+    return false;
+  }
+
+  // Keep new owners out while we look at the queues
+  if (Atomic::cmpxchg_ptr(DEFLATER_MARKER, &mid->_owner, NULL) != NULL) {
+    return false;
+  }
+
+  // A positive _count means a thread is on its way into enter(); once
+  // it is negative, racing enter() calls restore the header and retry.
+  if (mid->_waiters != 0 || mid->_cxq != NULL || mid->_EntryList != NULL ||
+      Atomic::cmpxchg(-max_jint, &mid->_count, 0) != 0) {
+    // Lost the race.  Threads may have queued up while we held the
+    // marker, so take the lock and exit it properly to wake a successor.
+    // If an entering thread already took over the marker it does that.
+    if (Atomic::cmpxchg_ptr(self, &mid->_owner, DEFLATER_MARKER) == DEFLATER_MARKER) {
+      mid->exit(true, self);
+    }
+    return false;
+  }
+
+  oop obj = (oop) mid->object();
+  if (TraceMonitorInflation) {
+    if (obj->is_instance()) {
+      ResourceMark rm;
+      tty->print_cr("Deflating object " INTPTR_FORMAT " , mark " INTPTR_FORMAT " , type %s (concurrent)",
+                    (void *) obj, (intptr_t) obj->mark(), obj->klass()->external_name());
+    }
+  }
+  // Racing enter() and inflate() calls may have restored it already
+  mid->install_displaced_markword_in_object(obj);
+  assert(obj->mark() != markOopDesc::encode(mid), "header must be restored");
+  TEVENT(deflate_idle_monitors - concurrent);
+  return true;
+}
+
+// Move the thread's in-use list to gOmInUseList.  Runs in a handshake,
+// so the thread is not inflating or flushing concurrently.
+void ObjectSynchronizer::hand_off_in_use_list(Thread* thread) {
+  ObjectMonitor* list = thread->omInUseList;
+  if (list == NULL) {
+    return;
+  }
+  ObjectMonitor* tail = list;
+  int count = 1;
+  while (tail->FreeNext != NULL) {
+    tail = tail->FreeNext;
+    count++;
+  }
+  assert(count == thread->omInUseCount, "inuse count off");
+  thread->omInUseList = NULL;
+  thread->omInUseCount = 0;
+
+  Thread::muxAcquire(&ListLock, "hand_off_in_use_list");
+  tail->FreeNext = gOmInUseList;
+  gOmInUseList = list;
+  gOmInUseCount += count;
+  Thread::muxRelease(&ListLock);
+}
+
+class HandOffInUseListClosure : public HandshakeClosure {
+ public:
+  HandOffInUseListClosure() : HandshakeClosure("HandOffInUseList") {}
+  void do_thread(Thread* thread) {
+    ObjectSynchronizer::hand_off_in_use_list(thread);
+  }
+};
+
+// Returns once every thread has passed a handshake, i.e. dropped any
+// monitor pointer it read from an object header before deflation.
+class DeflationBarrierClosure : public HandshakeClosure {
+ public:
+  DeflationBarrierClosure() : HandshakeClosure("DeflationBarrier") {}
+  void do_thread(Thread* thread) {}
+};
+
+void ObjectSynchronizer::deflate_idle_monitors_concurrently(JavaThread* self) {
+  assert(AsyncDeflateIdleMonitors, "sanity");
+  assert(self->thread_state() == _thread_in_vm, "must update headers in VM");
+
+  ForceMonitorScavenge = 0;    // Reset
+  last_async_deflation_time = os::javaTimeMillis();
+
+  HandOffInUseListClosure hand_off;
+  Handshake::execute(&hand_off);
+
+  Thread::muxAcquire(&ListLock, "deflate_idle_monitors_concurrently");
+  ObjectMonitor* list = gOmInUseList;
+  gOmInUseList = NULL;
+  gOmInUseCount = 0;
+  Thread::muxRelease(&ListLock);
+
+  ObjectMonitor* InUseHead = NULL;
+  ObjectMonitor* InUseTail = NULL;
+  ObjectMonitor* FreeHead = NULL;
+  ObjectMonitor* FreeTail = NULL;
+  int nInuse = 0;
+  int nScavenged = 0;
+
+  ObjectMonitor* next;
+  for (ObjectMonitor* mid = list; mid != NULL; mid = next) {
+    next = mid->FreeNext;
+    mid->FreeNext = NULL;
+    if (deflate_monitor_concurrently(mid, self)) {
+      if (FreeHead == NULL) FreeHead = mid;
+      if (FreeTail != NULL) FreeTail->FreeNext = mid;
+      FreeTail = mid;
+      nScavenged++;
+    } else {
+      if (InUseHead == NULL) InUseHead = mid;
+      if (InUseTail != NULL) InUseTail->FreeNext = mid;
+      InUseTail = mid;
+      nInuse++;
+    }
+    if (((nInuse + nScavenged) % MonitorsPerSafepointCheck) == 0 &&
+        SafepointMechanism::should_block(self)) {
+      // The monitors on the private lists don't move; their objects
+      // are updated by oops_do() through the monitor blocks.
+      ThreadBlockInVM tbivm(self);
+    }
+  }
+
+  if (InUseHead != NULL) {
+    Thread::muxAcquire(&ListLock, "deflate_idle_monitors_concurrently");
+    InUseTail->FreeNext = gOmInUseList;
+    gOmInUseList = InUseHead;
+    gOmInUseCount += nInuse;
+    Thread::muxRelease(&ListLock);
+  }
+
+  if (FreeHead != NULL) {
+    DeflationBarrierClosure barrier;
+    Handshake::execute(&barrier);
+
+    for (ObjectMonitor* mid = FreeHead; mid != NULL; mid = mid->FreeNext) {
+      mid->clear_deflated();
+    }
+    Thread::muxAcquire(&ListLock, "deflate_idle_monitors_concurrently");
+    FreeTail->FreeNext = gFreeList;
+    gFreeList = FreeHead;
+    MonitorFreeCount += nScavenged;
+    Thread::muxRelease(&ListLock);
+  }
+
+  if (ObjectMonitor::Knob_Verbose) {
+    ::printf("Deflate (concurrent): InCirc=%d InUse=%d Scavenged=%d : pop=%d free=%d\n",
+             nInuse + nScavenged, nInuse, nScavenged,
+             MonitorPopulation, MonitorFreeCount);
+    ::fflush(stdout);
+  }
+
+  if (ObjectMonitor::_sync_Deflations != NULL) ObjectMonitor::_sync_Deflations->inc(nScavenged);
+  if (ObjectMonitor::_sync_MonExtant  != NULL) ObjectMonitor::_sync_MonExtant ->set_value(nInuse + nScavenged);
+}
+
 // Monitor cleanup on JavaThread::exit
 
 // Iterate through monitor cache and attempt to release thread's monitors
@@ -124,6 +124,13 @@ class ObjectSynchronizer : AllStatic {
                               ObjectMonitor** freeTailp);
   static void oops_do(OopClosure* f);
 
+  // AsyncDeflateIdleMonitors: deflation by the service thread, outside
+  // of safepoints
+  static bool is_async_deflation_needed();
+  static void deflate_idle_monitors_concurrently(JavaThread* self);
+  static bool deflate_monitor_concurrently(ObjectMonitor* mid, JavaThread* self);
+  static void hand_off_in_use_list(Thread* thread);
+
   // debugging
   static void sanity_checks(const bool verbose,
                             const unsigned int cache_line_size,
@@ -64,6 +64,7 @@
 #include "runtime/orderAccess.inline.hpp"
 #include "runtime/osThread.hpp"
 #include "runtime/safepoint.hpp"
+#include "runtime/safepointMechanism.inline.hpp"
 #include "runtime/sharedRuntime.hpp"
 #include "runtime/statSampler.hpp"
 #include "runtime/stubRoutines.hpp"
@@ -72,6 +73,7 @@
 #include "runtime/thread.inline.hpp"
 #include "runtime/threadCritical.hpp"
 #include "runtime/threadLocalStorage.hpp"
+#include "runtime/threadSMR.hpp"
 #include "runtime/vframe.hpp"
 #include "runtime/vframeArray.hpp"
 #include "runtime/vframe_hp.hpp"
@@ -204,6 +206,7 @@ Thread::Thread() {
 
   // This initial value ==> never claimed.
   _oops_do_parity = 0;
+  _threads_hazard_ptr = NULL;
 
   _metadata_on_stack_buffer = NULL;
 
@@ -772,6 +775,7 @@ void Thread::oops_do(OopClosure* f, CLDClosure* cld_f, CodeBlobClosure* cf) {
   // Do oop for ThreadShadow
   f->do_oop((oop*)&_pending_exception);
   handle_area()->oops_do(f);
+  _heap_sampler.oops_do(f);
 }
 
 void Thread::nmethods_do(CodeBlobClosure* cf) {
@@ -1410,6 +1414,9 @@ void JavaThread::initialize() {
   _terminated = _not_terminated;
   _privileged_stack_top = NULL;
   _array_for_gc = NULL;
+  _stack_chunk_parity = 0;
+  _stack_chunk_next = 0;
+  _stack_chunks_done = 1;
   _suspend_equivalent = false;
   _in_deopt_handler = 0;
   _doing_unsafe_access = false;
@@ -1452,6 +1459,7 @@ void JavaThread::initialize() {
 
   // Setup safepoint state info for this thread
   ThreadSafepointState::create(this);
+  SafepointMechanism::disarm_local_poll(this);
 
   debug_only(_java_call_counter = 0);
 
@@ -1660,7 +1668,7 @@ void JavaThread::thread_main_inner() {
   DTRACE_THREAD_PROBE(stop, this);
 
   this->exit(false);
-  delete this;
+  ThreadsSMRSupport::smr_delete(this);
 }
 
 
@@ -1921,7 +1929,7 @@ void JavaThread::cleanup_failed_attach_current_thread() {
 #endif // INCLUDE_ALL_GCS
 
   Threads::remove(this);
-  delete this;
+  ThreadsSMRSupport::smr_delete(this);
 }
 
 
@@ -2328,10 +2336,11 @@ void JavaThread::check_safepoint_and_suspend_for_native_trans(JavaThread *thread
     }
   }
 
-  if (SafepointSynchronize::do_call_back()) {
+  if (SafepointMechanism::should_block(curJT)) {
     // If we are safepointing, then block the caller which may not be
-    // the same as the target thread (see above).
-    SafepointSynchronize::block(curJT);
+    // the same as the target thread (see above). Also process a pending
+    // handshake for the caller.
+    SafepointMechanism::block_if_requested(curJT);
   }
 
   if (thread->is_deopt_suspend()) {
@@ -2633,6 +2642,52 @@ class RememberProcessedThread: public StackObj {
   }
 };
 
+// Called by the worker that claimed the thread, before its oops_do().
+void JavaThread::start_chunked_stack_scan(int strong_roots_parity) {
+  if (!has_last_Java_frame()) {
+    return;
+  }
+  // Helpers may only see _stack_chunks_done clear once the counter is reset
+  _stack_chunk_next = 0;
+  OrderAccess::storestore();
+  _stack_chunks_done = 0;
+  OrderAccess::release_store(&_stack_chunk_parity, strong_roots_parity);
+}
+
+void JavaThread::help_chunked_stack_scan(OopClosure* f, CLDClosure* cld_f, CodeBlobClosure* cf,
+                                         int strong_roots_parity) {
+  if (OrderAccess::load_acquire(&_stack_chunk_parity) != strong_roots_parity ||
+      OrderAccess::load_acquire(&_stack_chunks_done) != 0) {
+    return;
+  }
+  RememberProcessedThread rpt(this);
+  frames_oops_do_chunked(f, cld_f, cf);
+}
+
+// Every participant walks the stack from the top, since finding a frame
+// needs its callee, but only visits the oops of the chunks it claims.
+// The walk is much cheaper than the oop map lookups and the closures,
+// so the pause for a deep stack shrinks with the number of workers.
+void JavaThread::frames_oops_do_chunked(OopClosure* f, CLDClosure* cld_f, CodeBlobClosure* cf) {
+  jint claimed = Atomic::add(1, &_stack_chunk_next) - 1;
+  jint chunk = 0;
+  uintx frames = 0;
+  for (StackFrameStream fst(this); !fst.is_done(); fst.next()) {
+    if (chunk == claimed) {
+      fst.current()->oops_do(f, cld_f, cf, fst.register_map());
+    }
+    if (++frames == StackScanChunkFrames) {
+      frames = 0;
+      if (chunk == claimed) {
+        claimed = Atomic::add(1, &_stack_chunk_next) - 1;
+      }
+      chunk++;
+    }
+  }
+  // Chunks claimed from here on are past the end; keep new helpers away
+  OrderAccess::release_store(&_stack_chunks_done, 1);
+}
+
 void JavaThread::oops_do(OopClosure* f, CLDClosure* cld_f, CodeBlobClosure* cf) {
   // Verify that the deferred card marks have been flushed.
   assert(deferred_card_mark().is_empty(), "Should be empty during GC");
@@ -2668,8 +2723,12 @@ void JavaThread::oops_do(OopClosure* f, CLDClosure* cld_f, CodeBlobClosure* cf)
     }
 
     // Traverse the execution stack
-    for (StackFrameStream fst(this); !fst.is_done(); fst.next()) {
-      fst.current()->oops_do(f, cld_f, cf, fst.register_map());
+    if (_stack_chunks_done == 0) {
+      frames_oops_do_chunked(f, cld_f, cf);
+    } else {
+      for (StackFrameStream fst(this); !fst.is_done(); fst.next()) {
+        fst.current()->oops_do(f, cld_f, cf, fst.register_map());
+      }
     }
   }
 
@@ -3325,6 +3384,9 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
   jint adjust_after_os_result = Arguments::adjust_after_os();
   if (adjust_after_os_result != JNI_OK) return adjust_after_os_result;
 
+  // Set up the polls before the first JavaThread is created
+  SafepointMechanism::initialize();
+
   // initialize TLS
   ThreadLocalStorage::init();
 
@@ -3420,6 +3482,9 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
     }
   }
 
+  // Hand the GC log over to its writer thread, -XX:+UseAsyncGCLog
+  ostream_init_async_log();
+
   assert(Universe::is_fully_initialized(), "not initialized");
   if (VerifyDuringStartup) {
     // Make sure we're starting with a clean slate.
@@ -3969,6 +4034,7 @@ void Threads::add(JavaThread* p, bool force_daemon) {
   p->initialize_queues();
   p->set_next(_thread_list);
   _thread_list = p;
+  ThreadsSMRSupport::add_thread(p);
   _number_of_threads++;
   oop threadObj = p->threadObj();
   bool daemon = true;
@@ -4005,6 +4071,7 @@ void Threads::remove(JavaThread* p) {
     } else {
       _thread_list = p->next();
     }
+    ThreadsSMRSupport::remove_thread(p);
     _number_of_threads--;
     oop threadObj = p->threadObj();
     bool daemon = true;
@@ -4071,11 +4138,22 @@ void Threads::possibly_parallel_oops_do(OopClosure* f, CLDClosure* cld_f, CodeBl
          (SharedHeap::heap()->n_par_threads() ==
          SharedHeap::heap()->workers()->active_workers()), "Mismatch");
   int cp = SharedHeap::heap()->strong_roots_parity();
+  bool chunked = is_par && StackScanChunkFrames > 0;
   ALL_JAVA_THREADS(p) {
     if (p->claim_oops_do(is_par, cp)) {
+      if (chunked) {
+        p->start_chunked_stack_scan(cp);
+      }
       p->oops_do(f, cld_f, cf);
     }
   }
+  if (chunked) {
+    // No thread is left to claim; help with the deep stacks that other
+    // workers are still scanning.
+    ALL_JAVA_THREADS(p) {
+      p->help_chunked_stack_scan(f, cld_f, cf, cp);
+    }
+  }
   VMThread* vmt = VMThread::vm_thread();
   if (vmt->claim_oops_do(is_par, cp)) {
     vmt->oops_do(f, cld_f, cf);
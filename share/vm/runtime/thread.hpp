@@ -26,11 +26,13 @@
 #define SHARE_VM_RUNTIME_THREAD_HPP
 
 #include "memory/allocation.hpp"
+#include "memory/heapSampler.hpp"
 #include "memory/threadLocalAllocBuffer.hpp"
 #include "oops/oop.hpp"
 #include "prims/jni.h"
 #include "prims/jvmtiExport.hpp"
 #include "runtime/frame.hpp"
+#include "runtime/handshake.hpp"
 #include "runtime/javaFrameAnchor.hpp"
 #include "runtime/jniHandles.hpp"
 #include "runtime/mutexLocker.hpp"
@@ -80,6 +82,7 @@ class jvmtiDeferredLocalVariableSet;
 
 class GCTaskQueue;
 class ThreadClosure;
+class ThreadsList;
 class IdealGraphPrinter;
 
 class Metadata;
@@ -225,9 +228,15 @@ class Thread: public ThreadShadow {
   // claimed as a task.
   jint _oops_do_parity;
 
+  // The ThreadsList this thread is iterating, see threadSMR.hpp
+  ThreadsList* volatile _threads_hazard_ptr;
+
  public:
   void set_last_handle_mark(HandleMark* mark)   { _last_handle_mark = mark; }
   HandleMark* last_handle_mark() const          { return _last_handle_mark; }
+
+  ThreadsList* threads_hazard_ptr() const       { return _threads_hazard_ptr; }
+  void set_threads_hazard_ptr(ThreadsList* list) { _threads_hazard_ptr = list; }
  private:
 
   // debug support for checking if code does allow safepoints or not
@@ -252,6 +261,7 @@ class Thread: public ThreadShadow {
   friend class GC_locker;
 
   ThreadLocalAllocBuffer _tlab;                 // Thread-local eden
+  ThreadHeapSampler _heap_sampler;              // For sampling allocations
   jlong _allocated_bytes;                       // Cumulative number of bytes allocated on
                                                 // the Java heap
 
@@ -409,6 +419,8 @@ class Thread: public ThreadShadow {
     }
   }
 
+  ThreadHeapSampler& heap_sampler()              { return _heap_sampler; }
+
   jlong allocated_bytes()               { return _allocated_bytes; }
   void set_allocated_bytes(jlong value) { _allocated_bytes = value; }
   void incr_allocated_bytes(jlong size) { _allocated_bytes += size; }
@@ -587,6 +599,7 @@ protected:
 
   TLAB_FIELD_OFFSET(start)
   TLAB_FIELD_OFFSET(end)
+  TLAB_FIELD_OFFSET(allocation_end)
   TLAB_FIELD_OFFSET(top)
   TLAB_FIELD_OFFSET(pf_top)
   TLAB_FIELD_OFFSET(size)                   // desired_size
@@ -836,6 +849,8 @@ class JavaThread: public Thread {
  private:
   ThreadSafepointState *_safepoint_state;        // Holds information about a thread during a safepoint
   address               _saved_exception_pc;     // Saved pc of instruction where last implicit exception happened
+  void* volatile        _polling_page;           // Thread-local poll word, see SafepointMechanism
+  HandshakeState        _handshake;              // Pending handshake operation, if any
 
   // JavaThread termination support
   enum TerminatedTypes {
@@ -1037,6 +1052,17 @@ class JavaThread: public Thread {
   void set_safepoint_state(ThreadSafepointState *state) { _safepoint_state = state; }
   bool is_at_poll_safepoint()                    { return _safepoint_state->is_at_poll_safepoint(); }
 
+  void* polling_page() const                     { return _polling_page; }
+  inline void set_polling_page(void* poll_value);
+
+  // Handshake support
+  void set_handshake_operation(HandshakeOperation* op) { _handshake.set_operation(this, op); }
+  bool has_handshake() const                     { return _handshake.has_operation(); }
+  void handshake_process_by_self()               { _handshake.process_by_self(this); }
+  bool handshake_try_process_by_vmThread()       { return _handshake.try_process_by_vmThread(this); }
+  // Is the current handshake operation for this thread being processed by the given thread
+  bool is_handshake_processed_by(Thread* thread) const { return _handshake.is_processed_by(thread); }
+
   // thread has called JavaThread::exit() or is terminated
   bool is_exiting()                              { return _terminated == _thread_exiting || is_terminated(); }
   // thread is terminated (no longer on the threads list); we compare
@@ -1341,6 +1367,7 @@ class JavaThread: public Thread {
   static ByteSize vm_result_2_offset()           { return byte_offset_of(JavaThread, _vm_result_2); }
   static ByteSize thread_state_offset()          { return byte_offset_of(JavaThread, _thread_state); }
   static ByteSize saved_exception_pc_offset()    { return byte_offset_of(JavaThread, _saved_exception_pc); }
+  static ByteSize polling_page_offset()          { return byte_offset_of(JavaThread, _polling_page); }
   static ByteSize osthread_offset()              { return byte_offset_of(JavaThread, _osthread); }
   static ByteSize exception_oop_offset()         { return byte_offset_of(JavaThread, _exception_oop); }
   static ByteSize exception_pc_offset()          { return byte_offset_of(JavaThread, _exception_pc); }
@@ -1428,6 +1455,22 @@ class JavaThread: public Thread {
   // Memory operations
   void oops_do(OopClosure* f, CLDClosure* cld_f, CodeBlobClosure* cf);
 
+  // Parallel GC workers share the scanning of a deep stack in chunks of
+  // StackScanChunkFrames frames, see Threads::possibly_parallel_oops_do.
+  // The worker that claims the thread starts the scan; others may help
+  // until it has walked past the last frame.
+ private:
+  volatile jint _stack_chunk_parity;   // strong roots parity of the last chunked scan
+  volatile jint _stack_chunk_next;     // next chunk to claim
+  volatile jint _stack_chunks_done;    // the scan has walked past the last frame
+
+  void frames_oops_do_chunked(OopClosure* f, CLDClosure* cld_f, CodeBlobClosure* cf);
+
+ public:
+  void start_chunked_stack_scan(int strong_roots_parity);
+  void help_chunked_stack_scan(OopClosure* f, CLDClosure* cld_f, CodeBlobClosure* cf,
+                               int strong_roots_parity);
+
   // Sweeper operations
   void nmethods_do(CodeBlobClosure* cf);
 
@@ -28,6 +28,7 @@
 #define SHARE_VM_RUNTIME_THREAD_INLINE_HPP_SCOPE
 
 #include "runtime/atomic.inline.hpp"
+#include "runtime/orderAccess.inline.hpp"
 #include "runtime/os.inline.hpp"
 #include "runtime/thread.hpp"
 #ifdef TARGET_OS_FAMILY_linux
@@ -132,6 +133,10 @@ inline void JavaThread::set_thread_state(JavaThreadState s) {
 }
 #endif
 
+inline void JavaThread::set_polling_page(void* poll_value) {
+  OrderAccess::release_store_ptr(&_polling_page, poll_value);
+}
+
 inline void JavaThread::set_done_attaching_via_jni() {
   _jni_attach_state = _attached_via_jni;
   OrderAccess::fence();
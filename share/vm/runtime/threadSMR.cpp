@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#include "precompiled.hpp"
+#include "classfile/javaClasses.hpp"
+#include "runtime/atomic.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.inline.hpp"
+#include "runtime/thread.inline.hpp"
+#include "runtime/threadSMR.hpp"
+#include "runtime/vmThread.hpp"
+
+ThreadsList                  ThreadsSMRSupport::_bootstrap_list(0);
+ThreadsList* volatile        ThreadsSMRSupport::_java_thread_list = &ThreadsSMRSupport::_bootstrap_list;
+ThreadsList*                 ThreadsSMRSupport::_to_delete_list = NULL;
+volatile jint                ThreadsSMRSupport::_delete_waiters = 0;
+volatile jint                ThreadsSMRSupport::_delete_notify_gen = 0;
+
+ThreadsList::ThreadsList(uint entries) :
+  _length(entries),
+  _next_list(NULL),
+  _threads(entries > 0 ? NEW_C_HEAP_ARRAY(JavaThread*, entries, mtThread) : NULL) {}
+
+ThreadsList::~ThreadsList() {
+  if (_threads != NULL) {
+    FREE_C_HEAP_ARRAY(JavaThread*, _threads);
+  }
+}
+
+ThreadsList* ThreadsList::add_thread(ThreadsList* list, JavaThread* java_thread) {
+  const uint index = list->_length;
+  ThreadsList* const new_list = new ThreadsList(index + 1);
+  if (index > 0) {
+    memcpy(new_list->_threads, list->_threads, index * sizeof(JavaThread*));
+  }
+  new_list->_threads[index] = java_thread;
+  return new_list;
+}
+
+ThreadsList* ThreadsList::remove_thread(ThreadsList* list, JavaThread* java_thread) {
+  assert(list->_length > 0, "sanity");
+  ThreadsList* const new_list = new ThreadsList(list->_length - 1);
+  uint j = 0;
+  for (uint i = 0; i < list->_length; i++) {
+    JavaThread* current = list->_threads[i];
+    if (current != java_thread) {
+      assert(j < new_list->_length, "java_thread not in list");
+      new_list->_threads[j++] = current;
+    }
+  }
+  assert(j == new_list->_length, "java_thread not in list");
+  return new_list;
+}
+
+bool ThreadsList::includes(const JavaThread* p) const {
+  for (uint i = 0; i < _length; i++) {
+    if (_threads[i] == p) {
+      return true;
+    }
+  }
+  return false;
+}
+
+JavaThread* ThreadsList::find_JavaThread_from_java_tid(jlong java_tid) const {
+  for (uint i = 0; i < _length; i++) {
+    JavaThread* thread = _threads[i];
+    oop tobj = thread->threadObj();
+    if (!thread->is_exiting() &&
+        tobj != NULL &&
+        java_tid == java_lang_Thread::thread_id(tobj)) {
+      return thread;
+    }
+  }
+  return NULL;
+}
+
+// The hazard pointer is published before the list is checked to still be
+// current. A writer that replaces the list after our check will see our
+// hazard pointer when it scans for it, so the list is stable once the
+// check succeeds.
+ThreadsList* ThreadsSMRSupport::acquire_stable_list(Thread* self) {
+  assert(self->is_Java_thread() || self->is_VM_thread(),
+         "hazard pointers of other threads are not scanned");
+  while (true) {
+    ThreadsList* list = (ThreadsList*) OrderAccess::load_ptr_acquire(&_java_thread_list);
+    self->set_threads_hazard_ptr(list);
+    OrderAccess::fence();
+    if (list == (ThreadsList*) OrderAccess::load_ptr_acquire(&_java_thread_list)) {
+      return list;
+    }
+  }
+}
+
+void ThreadsSMRSupport::release_stable_list(Thread* self) {
+  self->set_threads_hazard_ptr(NULL);
+  OrderAccess::fence();
+  if (OrderAccess::load_acquire(&_delete_waiters) > 0) {
+    // A thread in smr_delete() may be waiting for this list to be released
+    MonitorLockerEx ml(ThreadsSMRDelete_lock, Mutex::_no_safepoint_check_flag);
+    _delete_notify_gen++;
+    ml.notify_all();
+  }
+}
+
+// Only compares the hazard pointers: a reader may have stored a list that
+// was freed before it noticed that the list is no longer current.
+bool ThreadsSMRSupport::is_a_hazard(ThreadsList* list) {
+  assert_locked_or_safepoint(Threads_lock);
+  for (JavaThread* thread = Threads::first(); thread != NULL; thread = thread->next()) {
+    if (thread->threads_hazard_ptr() == list) {
+      return true;
+    }
+  }
+  VMThread* vmt = VMThread::vm_thread();
+  return vmt != NULL && vmt->threads_hazard_ptr() == list;
+}
+
+// Retires a replaced list and frees the retired lists no reader refers to.
+void ThreadsSMRSupport::free_list(ThreadsList* list) {
+  assert_locked_or_safepoint(Threads_lock);
+  if (list != NULL && list != &_bootstrap_list) {
+    list->_next_list = _to_delete_list;
+    _to_delete_list = list;
+  }
+  ThreadsList** prev = &_to_delete_list;
+  while (*prev != NULL) {
+    ThreadsList* current = *prev;
+    if (is_a_hazard(current)) {
+      prev = &current->_next_list;
+    } else {
+      *prev = current->_next_list;
+      delete current;
+    }
+  }
+}
+
+// A removed thread is only in retired lists, so it is protected as long
+// as one of those that contains it is still hazard pointed to.
+bool ThreadsSMRSupport::is_a_protected_JavaThread(JavaThread* thread) {
+  assert_locked_or_safepoint(Threads_lock);
+  free_list(NULL);
+  for (ThreadsList* list = _to_delete_list; list != NULL; list = list->_next_list) {
+    if (list->includes(thread)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadsSMRSupport::add_thread(JavaThread* thread) {
+  assert_locked_or_safepoint(Threads_lock);
+  ThreadsList* old_list = _java_thread_list;
+  ThreadsList* new_list = ThreadsList::add_thread(old_list, thread);
+  OrderAccess::release_store_ptr(&_java_thread_list, new_list);
+  // Publish the new list before looking for readers of the old one
+  OrderAccess::fence();
+  free_list(old_list);
+}
+
+void ThreadsSMRSupport::remove_thread(JavaThread* thread) {
+  assert_locked_or_safepoint(Threads_lock);
+  ThreadsList* old_list = _java_thread_list;
+  ThreadsList* new_list = ThreadsList::remove_thread(old_list, thread);
+  OrderAccess::release_store_ptr(&_java_thread_list, new_list);
+  OrderAccess::fence();
+  free_list(old_list);
+}
+
+void ThreadsSMRSupport::smr_delete(JavaThread* thread) {
+  assert(!Threads_lock->owned_by_self(), "sanity");
+  assert(thread->threads_hazard_ptr() == NULL, "exiting thread still holds a ThreadsList");
+
+  // Register as a waiter before scanning, so that a reader releasing its
+  // list after the scan sees us and notifies.
+  Atomic::inc(&_delete_waiters);
+  while (true) {
+    jint notify_gen;
+    {
+      MonitorLockerEx ml(ThreadsSMRDelete_lock, Mutex::_no_safepoint_check_flag);
+      notify_gen = _delete_notify_gen;
+    }
+    bool is_protected;
+    {
+      // The thread has been removed already and does not stop safepoints
+      MutexLockerEx ml(Threads_lock, Mutex::_no_safepoint_check_flag);
+      assert(!Threads::includes(thread), "thread must have been removed");
+      is_protected = is_a_protected_JavaThread(thread);
+    }
+    if (!is_protected) {
+      break;
+    }
+    MonitorLockerEx ml(ThreadsSMRDelete_lock, Mutex::_no_safepoint_check_flag);
+    while (_delete_notify_gen == notify_gen) {
+      ml.wait(Mutex::_no_safepoint_check_flag);
+    }
+  }
+  Atomic::dec(&_delete_waiters);
+
+  delete thread;
+}
+
+ThreadsListHandle::ThreadsListHandle(Thread* self) : _self(self) {
+  assert(self == Thread::current(), "sanity");
+  _list = self->threads_hazard_ptr();
+  _nested = _list != NULL;
+  if (!_nested) {
+    _list = ThreadsSMRSupport::acquire_stable_list(self);
+  }
+}
+
+ThreadsListHandle::~ThreadsListHandle() {
+  if (!_nested) {
+    ThreadsSMRSupport::release_stable_list(_self);
+  }
+}
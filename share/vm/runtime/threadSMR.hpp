@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2017, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+
+#ifndef SHARE_VM_RUNTIME_THREADSMR_HPP
+#define SHARE_VM_RUNTIME_THREADSMR_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/thread.hpp"
+
+// Thread Safe Memory Reclamation (Thread-SMR) support.
+//
+// Threads::add() and Threads::remove() publish an immutable ThreadsList
+// snapshot of the Java threads next to the Threads_lock protected thread
+// list. A reader protects the current snapshot with a ThreadsListHandle,
+// which stores it in the reader's hazard pointer, and may then iterate
+// it and use the JavaThreads in it without taking the Threads_lock:
+//
+//   ThreadsListHandle tlh;
+//   for (uint i = 0; i < tlh.length(); i++) {
+//     JavaThread* jt = tlh.thread_at(i);
+//     ...
+//   }
+//
+// A snapshot that is replaced is freed once no hazard pointer refers to
+// it, and an exited JavaThread is deleted once no hazard pointer refers
+// to a snapshot that contains it. The JavaThreads in a snapshot may
+// have exited since it was taken, so readers must still check
+// is_exiting() and threadObj() as they do under the Threads_lock.
+//
+// Hazard pointers are only scanned for Java threads and the VM thread,
+// so only those threads may use a ThreadsListHandle.
+
+class ThreadsList : public CHeapObj<mtThread> {
+  friend class ThreadsSMRSupport;
+
+  const uint _length;
+  ThreadsList* _next_list;   // Next replaced list waiting to be freed
+  JavaThread** const _threads;
+
+  ThreadsList(uint entries);
+  ~ThreadsList();
+
+  static ThreadsList* add_thread(ThreadsList* list, JavaThread* java_thread);
+  static ThreadsList* remove_thread(ThreadsList* list, JavaThread* java_thread);
+
+ public:
+  uint length() const                   { return _length; }
+  JavaThread* thread_at(uint i) const   { assert(i < _length, "index out of bounds"); return _threads[i]; }
+
+  bool includes(const JavaThread* p) const;
+  // Same as Threads::find_java_thread_from_java_tid()
+  JavaThread* find_JavaThread_from_java_tid(jlong java_tid) const;
+};
+
+class ThreadsSMRSupport : AllStatic {
+  friend class ThreadsListHandle;
+
+  static ThreadsList* volatile _java_thread_list;
+  // Replaced lists still protected by a hazard pointer
+  static ThreadsList*          _to_delete_list;
+  // Threads waiting in smr_delete() and the number of releases they
+  // may be waiting for
+  static volatile jint         _delete_waiters;
+  static volatile jint         _delete_notify_gen;
+  // The empty list the VM starts with; never freed
+  static ThreadsList           _bootstrap_list;
+
+  static ThreadsList* acquire_stable_list(Thread* self);
+  static void release_stable_list(Thread* self);
+
+  static bool is_a_hazard(ThreadsList* list);
+  static bool is_a_protected_JavaThread(JavaThread* thread);
+  static void free_list(ThreadsList* list);
+
+ public:
+  // Called by Threads::add() and Threads::remove() with the Threads_lock held
+  static void add_thread(JavaThread* thread);
+  static void remove_thread(JavaThread* thread);
+
+  // Deletes a JavaThread removed by Threads::remove(), once no reader
+  // can still reach it. Must not be called with the Threads_lock held.
+  static void smr_delete(JavaThread* thread);
+};
+
+// Protects the current ThreadsList for the lifetime of the handle.
+// Handles may nest; the inner ones share the outermost one's list.
+class ThreadsListHandle : public StackObj {
+  Thread* const _self;
+  ThreadsList*  _list;
+  bool          _nested;
+
+ public:
+  ThreadsListHandle(Thread* self = Thread::current());
+  ~ThreadsListHandle();
+
+  ThreadsList* list() const             { return _list; }
+  uint length() const                   { return _list->length(); }
+  JavaThread* thread_at(uint i) const   { return _list->thread_at(i); }
+};
+
+#endif // SHARE_VM_RUNTIME_THREADSMR_HPP
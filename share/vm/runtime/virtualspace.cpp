@@ -23,6 +23,8 @@
  */
 
 #include "precompiled.hpp"
+#include "gc_interface/collectedHeap.hpp"
+#include "memory/universe.hpp"
 #include "oops/markOop.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/virtualspace.hpp"
@@ -877,7 +879,14 @@ bool VirtualSpace::expand_by(size_t bytes, bool pre_touch) {
   }
 
   if (pre_touch || AlwaysPreTouch) {
-    os::pretouch_memory(previous_high, unaligned_new_high);
+    // The heap can spread the work over its GC threads; it may not have
+    // been created yet.
+    if (Universe::heap() != NULL) {
+      Universe::heap()->pretouch_memory(previous_high, unaligned_new_high,
+                                        os::vm_page_size());
+    } else {
+      os::pretouch_memory(previous_high, unaligned_new_high);
+    }
   }
 
   _high += bytes;
@@ -110,6 +110,9 @@
   template(HotMethodSampler)                      \
   template(HotFieldCollector)                     \
   template(PrintClassHierarchy)                   \
+  template(HandshakeOneThread)                    \
+  template(HandshakeAllThreads)                   \
+  template(HandshakeFallback)                     \
 
 class VM_Operation: public CHeapObj<mtInternal> {
  public:
@@ -410,6 +410,30 @@ public:
   virtual void execute(DCmdSource source, TRAPS);
 };
 
+class HeapSamplesDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<bool> _reset;
+public:
+  HeapSamplesDCmd(outputStream* output, bool heap);
+  static const char* name() {
+    return "GC.heap_samples";
+  }
+  static const char* description() {
+    return "Print the allocation sites of sampled allocations, by estimated "
+           "allocated bytes (requires -XX:+UseHeapSampling).";
+  }
+  static const char* impact() {
+    return "Low: Depends on the number of allocation sites.";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments();
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 class RotateGCLogDCmd : public DCmd {
 public:
   RotateGCLogDCmd(outputStream* output, bool heap) : DCmd(output, heap) {}
@@ -427,6 +451,24 @@ public:
   }
 };
 
+class SafepointStragglersDCmd : public DCmd {
+public:
+  SafepointStragglersDCmd(outputStream* output, bool heap) : DCmd(output, heap) {}
+  static const char* name() { return "VM.safepoint_stragglers"; }
+  static const char* description() {
+    return "Print the threads recorded as late to reach a safepoint "
+           "(requires -XX:+ReportSafepointStragglers).";
+  }
+  static const char* impact() { return "Low"; }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments() { return 0; }
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 class CompileQueueDCmd : public DCmd {
 public:
   CompileQueueDCmd(outputStream* output, bool heap) : DCmd(output, heap) {}
@@ -64,7 +64,8 @@ public:
     PSScavenge,
     PSMarkSweep,
     G1YoungGen,
-    G1OldGen
+    G1OldGen,
+    Epsilon
   };
 
   MemoryManager();
@@ -98,6 +99,7 @@ public:
   static GCMemoryManager* get_psMarkSweep_memory_manager();
   static GCMemoryManager* get_g1YoungGen_memory_manager();
   static GCMemoryManager* get_g1OldGen_memory_manager();
+  static GCMemoryManager* get_epsilon_memory_manager();
 
 };
 
@@ -284,4 +286,13 @@ public:
   const char* name()         { return "G1 Old Generation"; }
 };
 
+class EpsilonMemoryManager : public GCMemoryManager {
+private:
+public:
+  EpsilonMemoryManager() : GCMemoryManager() {}
+
+  MemoryManager::Name kind() { return MemoryManager::Epsilon; }
+  const char* name()         { return "Epsilon Heap"; }
+};
+
 #endif // SHARE_VM_SERVICES_MEMORYMANAGER_HPP
@@ -47,6 +47,7 @@
 #include "utilities/macros.hpp"
 #if INCLUDE_ALL_GCS
 #include "gc_implementation/concurrentMarkSweep/concurrentMarkSweepGeneration.hpp"
+#include "gc_implementation/epsilon/epsilonHeap.hpp"
 #include "gc_implementation/g1/g1CollectedHeap.inline.hpp"
 #include "gc_implementation/parNew/parNewGeneration.hpp"
 #include "gc_implementation/parallelScavenge/parallelScavengeHeap.hpp"
@@ -98,6 +99,10 @@ void MemoryService::set_universe_heap(CollectedHeap* heap) {
       add_g1_heap_info(G1CollectedHeap::heap());
       break;
     }
+    case CollectedHeap::EpsilonHeap : {
+      add_epsilon_heap_info(EpsilonHeap::heap());
+      break;
+    }
 #endif // INCLUDE_ALL_GCS
     default: {
       guarantee(false, "Unrecognized kind of heap");
@@ -116,7 +121,9 @@ void MemoryService::set_universe_heap(CollectedHeap* heap) {
   // All memory pools and memory managers are initialized.
   //
   _minor_gc_manager->initialize_gc_stat_info();
-  _major_gc_manager->initialize_gc_stat_info();
+  if (_major_gc_manager != _minor_gc_manager) {
+    _major_gc_manager->initialize_gc_stat_info();
+  }
 }
 
 // Add memory pools for GenCollectedHeap
@@ -190,6 +197,24 @@ void MemoryService::add_g1_heap_info(G1CollectedHeap* g1h) {
   add_g1YoungGen_memory_pool(g1h, _major_gc_manager, _minor_gc_manager);
   add_g1OldGen_memory_pool(g1h, _major_gc_manager);
 }
+
+void MemoryService::add_epsilon_heap_info(EpsilonHeap* heap) {
+  assert(UseEpsilonGC, "sanity");
+
+  // Epsilon never collects, so a single manager stands in for both the
+  // minor and the major collector.
+  _minor_gc_manager = MemoryManager::get_epsilon_memory_manager();
+  _major_gc_manager = _minor_gc_manager;
+  _managers_list->append(_minor_gc_manager);
+
+  ContiguousSpacePool* pool = new ContiguousSpacePool(heap->space(),
+                                                      "Epsilon Heap",
+                                                      MemoryPool::Heap,
+                                                      heap->max_capacity(),
+                                                      true /* support_usage_threshold */);
+  _minor_gc_manager->add_pool(pool);
+  _pools_list->append(pool);
+}
 #endif // INCLUDE_ALL_GCS
 
 MemoryPool* MemoryService::add_gen(Generation* gen,
@@ -35,6 +35,7 @@
 #include "runtime/thread.hpp"
 #include "runtime/vframe.hpp"
 #include "runtime/thread.inline.hpp"
+#include "runtime/threadSMR.hpp"
 #include "runtime/vmThread.hpp"
 #include "runtime/vm_operations.hpp"
 #include "services/threadService.hpp"
@@ -946,9 +947,12 @@ ThreadsListEnumerator::ThreadsListEnumerator(Thread* cur_thread,
   int init_size = ThreadService::get_live_thread_count();
   _threads_array = new GrowableArray<instanceHandle>(init_size);
 
-  MutexLockerEx ml(Threads_lock);
+  // Iterate a snapshot rather than hold the Threads_lock, so that
+  // frequent enumeration does not stall thread creation and exit.
+  ThreadsListHandle tlh(cur_thread);
 
-  for (JavaThread* jt = Threads::first(); jt != NULL; jt = jt->next()) {
+  for (uint i = 0; i < tlh.length(); i++) {
+    JavaThread* jt = tlh.thread_at(i);
     // skips JavaThreads in the process of exiting
     // and also skips VM internal JavaThreads
     // Threads in _thread_new or _thread_new_trans state are included.
@@ -28,6 +28,7 @@
 #if INCLUDE_TRACE
 #include "runtime/globals.hpp"
 #include "runtime/os.hpp"
+#include "utilities/ticks.hpp"
 #include "trace/traceTime.hpp"
 #include "tracefiles/traceEventIds.hpp"
 
@@ -41,8 +42,9 @@ public:
     return enabled();
   }
 
+  // Same time base as Ticks, which events are also stamped with
   static TracingTime time() {
-    return os::elapsed_counter();
+    return ElapsedCounterSource::now();
   }
 
   static void on_unloading_classes(void) {
@@ -38,6 +38,7 @@ EventLog* Events::_logs = NULL;
 StringEventLog* Events::_messages = NULL;
 StringEventLog* Events::_exceptions = NULL;
 StringEventLog* Events::_deopt_messages = NULL;
+StringEventLog* Events::_safepoint_stragglers = NULL;
 
 EventLog::EventLog() {
   // This normally done during bootstrap when we're only single
@@ -62,11 +63,20 @@ void Events::print() {
   print_all(tty);
 }
 
+void Events::print_safepoint_stragglers(outputStream* out) {
+  if (_safepoint_stragglers != NULL) {
+    _safepoint_stragglers->print_log_on(out);
+  } else {
+    out->print_cr("Safepoint straggler log is not available (-XX:-LogEvents)");
+  }
+}
+
 void Events::init() {
   if (LogEvents) {
     _messages = new StringEventLog("Events");
     _exceptions = new StringEventLog("Internal exceptions");
     _deopt_messages = new StringEventLog("Deoptimization events");
+    _safepoint_stragglers = new StringEventLog("Safepoint stragglers");
   }
 }
 
@@ -186,6 +186,9 @@ class Events : AllStatic {
   // Deoptization related messages
   static StringEventLog* _deopt_messages;
 
+  // Threads that were late to reach a safepoint (ReportSafepointStragglers)
+  static StringEventLog* _safepoint_stragglers;
+
  public:
   static void print_all(outputStream* out);
 
@@ -200,6 +203,11 @@ class Events : AllStatic {
 
   static void log_deopt_message(Thread* thread, const char* format, ...) ATTRIBUTE_PRINTF(2, 3);
 
+  static void log_safepoint_straggler(Thread* thread, const char* format, ...) ATTRIBUTE_PRINTF(2, 3);
+
+  // Dump the safepoint straggler log only
+  static void print_safepoint_stragglers(outputStream* out);
+
   // Register default loggers
   static void init();
 };
@@ -231,6 +239,15 @@ inline void Events::log_deopt_message(Thread* thread, const char* format, ...) {
   }
 }
 
+inline void Events::log_safepoint_straggler(Thread* thread, const char* format, ...) {
+  if (LogEvents) {
+    va_list ap;
+    va_start(ap, format);
+    _safepoint_stragglers->logv(thread, format, ap);
+    va_end(ap);
+  }
+}
+
 
 template <class T>
 inline void EventLogBase<T>::print_log_on(outputStream* out) {
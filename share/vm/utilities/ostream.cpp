@@ -27,6 +27,7 @@
 #include "gc_implementation/shared/gcId.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/arguments.hpp"
+#include "runtime/asyncLogWriter.hpp"
 #include "runtime/os.hpp"
 #include "runtime/vm_version.hpp"
 #include "utilities/defaultStream.hpp"
@@ -667,6 +668,9 @@ void gcLogFileStream::dump_loggc_header() {
 }
 
 gcLogFileStream::~gcLogFileStream() {
+  if (_async_writer != NULL) {
+    _async_writer->stop();
+  }
   if (_file != NULL) {
     if (_need_close) fclose(_file);
     _file = NULL;
@@ -680,6 +684,7 @@ gcLogFileStream::~gcLogFileStream() {
 gcLogFileStream::gcLogFileStream(const char* file_name) {
   _cur_file_num = 0;
   _bytes_written = 0L;
+  _async_writer = NULL;
   _file_name = make_log_name(file_name, NULL);
 
   if (_file_name == NULL) {
@@ -707,11 +712,30 @@ gcLogFileStream::gcLogFileStream(const char* file_name) {
 }
 
 void gcLogFileStream::write(const char* s, size_t len) {
+  AsyncLogWriter* writer = _async_writer;
+  if (writer != NULL) {
+    writer->enqueue(s, len);
+  } else {
+    write_to_file(s, len);
+  }
+  update_position(s, len);
+}
+
+void gcLogFileStream::write_to_file(const char* s, size_t len) {
   if (_file != NULL) {
     size_t count = fwrite(s, 1, len, _file);
     _bytes_written += count;
   }
-  update_position(s, len);
+}
+
+void gcLogFileStream::flush() {
+  AsyncLogWriter* writer = _async_writer;
+  if (writer != NULL) {
+    // The writer thread flushes the file after writing it.
+    writer->wakeup();
+  } else {
+    fileStream::flush();
+  }
 }
 
 // rotate_log must be called from VMThread at safepoint. In case need change parameters
@@ -723,6 +747,22 @@ void gcLogFileStream::write(const char* s, size_t len) {
 // concurrent GC threads to run parallel with VMThread at safepoint, write and rotate_log
 // must be synchronized.
 void gcLogFileStream::rotate_log(bool force, outputStream* out) {
+  AsyncLogWriter* writer = _async_writer;
+  if (writer != NULL) {
+    if (!should_rotate(force)) {
+      return;
+    }
+    // Write out what was logged so far to the file being rotated, and
+    // keep the writer thread off the file while it is switched.
+    writer->drain();
+    MutexLockerEx ml(writer->file_lock(), Mutex::_no_safepoint_check_flag);
+    rotate_log_locked(force, out);
+  } else {
+    rotate_log_locked(force, out);
+  }
+}
+
+void gcLogFileStream::rotate_log_locked(bool force, outputStream* out) {
   char time_msg[O_BUFLEN];
   char time_str[EXTRACHARLEN];
   char current_file_name[JVM_MAXPATHLEN];
@@ -744,7 +784,8 @@ void gcLogFileStream::rotate_log(bool force, outputStream* out) {
     _bytes_written = 0L;
     jio_snprintf(time_msg, sizeof(time_msg), "File  %s rotated at %s\n",
                  _file_name, os::local_time_string((char *)time_str, sizeof(time_str)));
-    write(time_msg, strlen(time_msg));
+    write_to_file(time_msg, strlen(time_msg));
+    update_position(time_msg, strlen(time_msg));
 
     if (out != NULL) {
       out->print("%s", time_msg);
@@ -780,7 +821,8 @@ void gcLogFileStream::rotate_log(bool force, outputStream* out) {
     jio_snprintf(time_msg, sizeof(time_msg), "%s %s Saved as %s\n",
                      os::local_time_string((char *)time_str, sizeof(time_str)),
                                                          msg, renamed_file_name);
-    write(time_msg, strlen(time_msg));
+    write_to_file(time_msg, strlen(time_msg));
+    update_position(time_msg, strlen(time_msg));
 
     if (out != NULL) {
       out->print("%s", time_msg);
@@ -1215,6 +1257,17 @@ void ostream_init_log() {
   defaultStream::instance->has_log_file();
 }
 
+// For -XX:+UseAsyncGCLog - called in runtime/thread.cpp once the VM thread
+// is running.
+void ostream_init_async_log() {
+  if (UseAsyncGCLog && gclog_or_tty != tty) {
+    gcLogFileStream* gclog = (gcLogFileStream*)gclog_or_tty;
+    if (gclog->is_open()) {
+      AsyncLogWriter::start(gclog);
+    }
+  }
+}
+
 // ostream_exit() is called during normal VM exit to finish log files, flush
 // output and free resource.
 void ostream_exit() {
@@ -1251,6 +1304,9 @@ void ostream_exit() {
 // ostream_abort() is called by os::abort() when VM is about to die.
 void ostream_abort() {
   // Here we can't delete gclog_or_tty and tty, just flush their output
+  if (AsyncLogWriter::instance() != NULL) {
+    AsyncLogWriter::instance()->abort_flush();
+  }
   if (gclog_or_tty) gclog_or_tty->flush();
   if (tty) tty->flush();
 
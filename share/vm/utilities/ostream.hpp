@@ -235,18 +235,30 @@ class fdStream : public outputStream {
   void flush() {};
 };
 
+class AsyncLogWriter;
+
 class gcLogFileStream : public fileStream {
  protected:
   const char*  _file_name;
   jlong  _bytes_written;
   uintx  _cur_file_num;             // current logfile rotation number, from 0 to NumberOfGCLogFiles-1
+  AsyncLogWriter* _async_writer;    // writes the file in the background, -XX:+UseAsyncGCLog
+
+  void rotate_log_locked(bool force, outputStream* out);
  public:
   gcLogFileStream(const char* file_name);
   ~gcLogFileStream();
   virtual void write(const char* c, size_t len);
+  virtual void flush();
   virtual void rotate_log(bool force, outputStream* out = NULL);
   void dump_loggc_header();
 
+  // File access, by the async log writer when there is one.
+  void write_to_file(const char* c, size_t len);
+  void flush_file()                 { fileStream::flush(); }
+  void set_async_writer(AsyncLogWriter* writer) { _async_writer = writer; }
+  AsyncLogWriter* async_writer() const          { return _async_writer; }
+
   /* If "force" sets true, force log file rotation from outside JVM */
   bool should_rotate(bool force) {
     return force ||
@@ -261,6 +273,7 @@ void test_loggc_filename();
 
 void ostream_init();
 void ostream_init_log();
+void ostream_init_async_log();
 void ostream_exit();
 void ostream_abort();
 
@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/atomic.inline.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
 #include "runtime/thread.inline.hpp"
 #include "utilities/debug.hpp"
@@ -41,7 +42,7 @@ uint ParallelTaskTerminator::_total_peeks = 0;
 
 #if TASKQUEUE_STATS
 const char * const TaskQueueStats::_names[last_stat_id] = {
-  "qpush", "qpop", "qpop-s", "qattempt", "qsteal", "opush", "omax"
+  "qpush", "qpop", "qpop-s", "qattempt", "qsteal", "osteal", "opush", "omax"
 };
 
 TaskQueueStats & TaskQueueStats::operator +=(const TaskQueueStats & addend)
@@ -93,12 +94,18 @@ void TaskQueueStats::print(outputStream* stream, unsigned int width) const
 // quiescent; they do not hold at arbitrary times.
 void TaskQueueStats::verify() const
 {
-  assert(get(push) == get(pop) + get(steal),
-         err_msg("push=" SIZE_FORMAT " pop=" SIZE_FORMAT " steal=" SIZE_FORMAT,
-                 get(push), get(pop), get(steal)));
+  // Steals from an overflow stack take elements that were never counted
+  // as taskqueue pushes.
+  assert(get(push) == get(pop) + get(steal) - get(steal_overflow),
+         err_msg("push=" SIZE_FORMAT " pop=" SIZE_FORMAT " steal=" SIZE_FORMAT
+                 " steal_overflow=" SIZE_FORMAT,
+                 get(push), get(pop), get(steal), get(steal_overflow)));
   assert(get(pop_slow) <= get(pop),
          err_msg("pop_slow=" SIZE_FORMAT " pop=" SIZE_FORMAT,
                  get(pop_slow), get(pop)));
+  assert(get(steal_overflow) <= get(steal),
+         err_msg("steal_overflow=" SIZE_FORMAT " steal=" SIZE_FORMAT,
+                 get(steal_overflow), get(steal)));
   assert(get(steal) <= get(steal_attempt),
          err_msg("steal=" SIZE_FORMAT " steal_attempt=" SIZE_FORMAT,
                  get(steal), get(steal_attempt)));
@@ -134,12 +141,33 @@ ParallelTaskTerminator::
 ParallelTaskTerminator(int n_threads, TaskQueueSetSuper* queue_set) :
   _n_threads(n_threads),
   _queue_set(queue_set),
-  _offered_termination(0) {}
+  _offered_termination(0),
+  _blocker(NULL),
+  _spin_master(NULL) {
+  if (UseOWSTTaskTerminator) {
+    _blocker = new Monitor(Mutex::leaf, "ParallelTaskTerminator", false,
+                           Monitor::_safepoint_check_never);
+  }
+  reset_stats();
+}
+
+ParallelTaskTerminator::~ParallelTaskTerminator() {
+  print_stats();
+  if (_blocker != NULL) {
+    delete _blocker;
+  }
+}
 
 bool ParallelTaskTerminator::peek_in_queue_set() {
   return _queue_set->peek();
 }
 
+bool ParallelTaskTerminator::exit_termination(uint tasks,
+                                              TerminatorTerminator* terminator) {
+  return tasks > 0 ||
+         (terminator != NULL && terminator->should_exit_termination());
+}
+
 void ParallelTaskTerminator::yield() {
   assert(_offered_termination <= _n_threads, "Invariant");
   os::naked_yield();
@@ -154,6 +182,170 @@ bool
 ParallelTaskTerminator::offer_termination(TerminatorTerminator* terminator) {
   assert(_n_threads > 0, "Initialization is incorrect");
   assert(_offered_termination < _n_threads, "Invariant");
+  if (!PrintTerminationStats) {
+    return offer_termination_work(terminator);
+  }
+  jlong start = os::elapsed_counter();
+  bool result = offer_termination_work(terminator);
+  Atomic::inc(&_stat_offers);
+  Atomic::add(os::elapsed_counter() - start, &_stat_ticks);
+  return result;
+}
+
+bool
+ParallelTaskTerminator::offer_termination_work(TerminatorTerminator* terminator) {
+  if (_blocker != NULL) {
+    return offer_termination_owst(terminator);
+  }
+  return offer_termination_spinning(terminator);
+}
+
+bool
+ParallelTaskTerminator::offer_termination_owst(TerminatorTerminator* terminator) {
+  // Single worker, done.
+  if (_n_threads == 1) {
+    _offered_termination = 1;
+    return true;
+  }
+
+  _blocker->lock_without_safepoint_check();
+  // All arrived, done.
+  _offered_termination++;
+  if (_offered_termination == _n_threads) {
+    _blocker->notify_all();
+    _blocker->unlock();
+    return true;
+  }
+
+  Thread* the_thread = Thread::current();
+  while (true) {
+    if (_spin_master == NULL) {
+      _spin_master = the_thread;
+      if (PrintTerminationStats) {
+        Atomic::inc(&_stat_spin_masters);
+      }
+      _blocker->unlock();
+
+      if (do_spin_master_work(terminator)) {
+        assert(_offered_termination == _n_threads, "termination condition");
+        return true;
+      }
+      _blocker->lock_without_safepoint_check();
+      // Termination may have been reached between giving up the lock in
+      // do_spin_master_work() and taking it again here.
+      if (_offered_termination == _n_threads) {
+        _blocker->unlock();
+        return true;
+      }
+    } else {
+      _blocker->wait(Mutex::_no_safepoint_check_flag, WorkStealingSleepMillis);
+      if (_offered_termination == _n_threads) {
+        _blocker->unlock();
+        return true;
+      }
+    }
+
+    if (exit_termination(_queue_set->tasks(), terminator)) {
+      _offered_termination--;
+      assert(_offered_termination < _n_threads, "Invariant");
+      _blocker->unlock();
+      return false;
+    }
+  }
+}
+
+bool
+ParallelTaskTerminator::do_spin_master_work(TerminatorTerminator* terminator) {
+  uint yield_count = 0;
+  // Number of hard spin loops done since last yield
+  uint hard_spin_count = 0;
+  // Number of iterations in the hard spin loop.
+  uint hard_spin_limit = WorkStealingHardSpins;
+
+  // See offer_termination_spinning() for the spin and yield policy.
+  if (WorkStealingSpinToYieldRatio > 0) {
+    hard_spin_limit = WorkStealingHardSpins >> WorkStealingSpinToYieldRatio;
+    hard_spin_limit = MAX2(hard_spin_limit, 1U);
+  }
+  // Remember the initial spin limit.
+  uint hard_spin_start = hard_spin_limit;
+
+  // Loop waiting for all threads to offer termination or
+  // more work.
+  while (true) {
+    if (yield_count <= WorkStealingYieldsBeforeSleep) {
+      yield_count++;
+      if (hard_spin_count > WorkStealingSpinToYieldRatio) {
+        yield();
+        hard_spin_count = 0;
+        hard_spin_limit = hard_spin_start;
+#ifdef TRACESPINNING
+        _total_yields++;
+#endif
+      } else {
+        hard_spin_limit = MIN2(2*hard_spin_limit,
+                               (uint) WorkStealingHardSpins);
+        for (uint j = 0; j < hard_spin_limit; j++) {
+          SpinPause();
+        }
+        hard_spin_count++;
+#ifdef TRACESPINNING
+        _total_spins++;
+#endif
+      }
+    } else {
+      if (PrintGCDetails && Verbose) {
+        gclog_or_tty->print_cr("ParallelTaskTerminator::do_spin_master_work() "
+          "thread " PTR_FORMAT " sleeps after %u yields",
+          p2i(Thread::current()), yield_count);
+      }
+      yield_count = 0;
+
+      // Give up the spin master role while sleeping, so that a thread
+      // woken by the timeout can take it over.
+      MonitorLockerEx locker(_blocker, Mutex::_no_safepoint_check_flag);
+      _spin_master = NULL;
+      if (PrintTerminationStats) {
+        Atomic::inc(&_stat_sleeps);
+      }
+      locker.wait(Mutex::_no_safepoint_check_flag, WorkStealingSleepMillis);
+      if (_spin_master == NULL) {
+        _spin_master = Thread::current();
+      } else {
+        return false;
+      }
+    }
+
+#ifdef TRACESPINNING
+    _total_peeks++;
+#endif
+    uint tasks = _queue_set->tasks();
+    if (exit_termination(tasks, terminator)) {
+      MonitorLockerEx locker(_blocker, Mutex::_no_safepoint_check_flag);
+      // Wake up as many of the blocked threads as there are tasks to
+      // steal; this thread takes one of the tasks itself.
+      uint waiters = (uint)_offered_termination - 1;
+      if (tasks >= waiters) {
+        locker.notify_all();
+      } else {
+        for (uint i = 1; i < tasks; i++) {
+          locker.notify();
+        }
+      }
+      if (PrintTerminationStats) {
+        Atomic::add((jint)MIN2(tasks, waiters), &_stat_wakeups);
+      }
+      _spin_master = NULL;
+      return false;
+    } else if (_offered_termination == _n_threads) {
+      _spin_master = NULL;
+      return true;
+    }
+  }
+}
+
+bool
+ParallelTaskTerminator::offer_termination_spinning(TerminatorTerminator* terminator) {
   Atomic::inc(&_offered_termination);
 
   uint yield_count = 0;
@@ -256,6 +448,27 @@ void ParallelTaskTerminator::reset_for_reuse() {
            "Terminator may still be in use");
     _offered_termination = 0;
   }
+  assert(_spin_master == NULL, "Terminator may still be in use");
+  print_stats();
+}
+
+void ParallelTaskTerminator::reset_stats() {
+  _stat_offers = 0;
+  _stat_spin_masters = 0;
+  _stat_wakeups = 0;
+  _stat_sleeps = 0;
+  _stat_ticks = 0;
+}
+
+void ParallelTaskTerminator::print_stats() {
+  if (PrintTerminationStats && _stat_offers > 0) {
+    gclog_or_tty->print_cr("Termination: %d threads, %d offers, %d spin masters, "
+                           "%d wakeups, %d sleeps, %.3f ms",
+                           _n_threads, _stat_offers, _stat_spin_masters,
+                           _stat_wakeups, _stat_sleeps,
+                           (double)_stat_ticks * MILLIUNITS / os::elapsed_frequency());
+    reset_stats();
+  }
 }
 
 #ifdef ASSERT
@@ -54,6 +54,7 @@ public:
     pop_slow,         // subset of taskqueue pops that were done slow-path
     steal_attempt,    // number of taskqueue steal attempts
     steal,            // number of taskqueue steals
+    steal_overflow,   // subset of steals taken from an overflow stack
     overflow,         // number of overflow pushes
     overflow_max_len, // max length of overflow stack
     last_stat_id
@@ -66,6 +67,7 @@ public:
   inline void record_pop()      { ++_stats[pop]; }
   inline void record_pop_slow() { record_pop(); ++_stats[pop_slow]; }
   inline void record_steal(bool success);
+  inline void record_steal_overflow() { ++_stats[steal_overflow]; }
   inline void record_overflow(size_t new_length);
 
   TaskQueueStats & operator +=(const TaskQueueStats & addend);
@@ -299,6 +301,12 @@ public:
   // recently pushed).
   bool pop_global(volatile E& t);
 
+  // A GenericTaskQueue has no overflow stack, so there is nothing to steal
+  // from it beyond what pop_global() finds.  See OverflowTaskQueue.
+  bool pop_overflow_global(GenericTaskQueue<E, F, N>* thief, E& t) {
+    return false;
+  }
+
   // Delete any resource associated with the queue.
   ~GenericTaskQueue();
 
@@ -433,14 +441,23 @@ GenericTaskQueue<E, F, N>::~GenericTaskQueue() {
 // OverflowTaskQueue is a TaskQueue that also includes an overflow stack for
 // elements that do not fit in the TaskQueue.
 //
-// This class hides two methods from super classes:
+// This class hides three methods from super classes:
 //
 // push() - push onto the task queue or, if that fails, onto the overflow stack
 // is_empty() - return true if both the TaskQueue and overflow stack are empty
+// peek() - like is_empty(), but only counts the overflow stack if it may be
+//          stolen from
 //
 // Note that size() is not hidden--it returns the number of elements in the
 // TaskQueue, and does not include the size of the overflow stack.  This
 // simplifies replacement of GenericTaskQueues with OverflowTaskQueues.
+//
+// With UseStealableTaskQueueOverflow the overflow stack is protected by a
+// spin lock, and other threads may take work from it with
+// pop_overflow_global().  The overflow stack grows without bound, so
+// together with the TaskQueue this behaves as a growable deque whose
+// elements are all visible to thieves.  The owner only pays for the lock
+// when the TaskQueue is full or empty, which is already the slow path.
 template<class E, MEMFLAGS F, unsigned int N = TASKQUEUE_SIZE>
 class OverflowTaskQueue: public GenericTaskQueue<E, F, N>
 {
@@ -450,12 +467,23 @@ public:
 
   TASKQUEUE_STATS_ONLY(using taskqueue_t::stats;)
 
+  OverflowTaskQueue() : taskqueue_t(), _overflow_lock(0) { }
+
   // Push task t onto the queue or onto the overflow stack.  Return true.
   inline bool push(E t);
 
   // Attempt to pop from the overflow stack; return true if anything was popped.
   inline bool pop_overflow(E& t);
 
+  // Attempt to steal from the overflow stack on behalf of "thief", which
+  // must be the task queue of the calling thread.  If successful, sets t to
+  // the stolen task and moves up to half of the remaining overflow elements
+  // onto the TaskQueue of "thief", where they can be popped locally or
+  // stolen again by other threads.
+  bool pop_overflow_global(OverflowTaskQueue<E, F, N>* thief, E& t);
+
+  // The overflow stack is not synchronized; only use it directly when no
+  // other thread can be stealing from this queue.
   inline overflow_t* overflow_stack() { return &_overflow_stack; }
 
   inline bool taskqueue_empty() const { return taskqueue_t::is_empty(); }
@@ -464,15 +492,45 @@ public:
     return taskqueue_empty() && overflow_empty();
   }
 
+  inline bool peek() const {
+    return taskqueue_t::peek() ||
+           (UseStealableTaskQueueOverflow && !overflow_empty());
+  }
+
 private:
-  overflow_t _overflow_stack;
+  inline void lock_overflow();
+  inline void unlock_overflow();
+
+  overflow_t    _overflow_stack;
+  volatile jint _overflow_lock;
 };
 
+template <class E, MEMFLAGS F, unsigned int N>
+void OverflowTaskQueue<E, F, N>::lock_overflow()
+{
+  while (Atomic::cmpxchg(1, &_overflow_lock, 0) != 0) {
+    SpinPause();
+  }
+}
+
+template <class E, MEMFLAGS F, unsigned int N>
+void OverflowTaskQueue<E, F, N>::unlock_overflow()
+{
+  assert(_overflow_lock == 1, "not locked");
+  OrderAccess::release_store(&_overflow_lock, 0);
+}
+
 template <class E, MEMFLAGS F, unsigned int N>
 bool OverflowTaskQueue<E, F, N>::push(E t)
 {
   if (!taskqueue_t::push(t)) {
-    overflow_stack()->push(t);
+    if (UseStealableTaskQueueOverflow) {
+      lock_overflow();
+      overflow_stack()->push(t);
+      unlock_overflow();
+    } else {
+      overflow_stack()->push(t);
+    }
     TASKQUEUE_STATS_ONLY(stats.record_overflow(overflow_stack()->size()));
   }
   return true;
@@ -482,7 +540,44 @@ template <class E, MEMFLAGS F, unsigned int N>
 bool OverflowTaskQueue<E, F, N>::pop_overflow(E& t)
 {
   if (overflow_empty()) return false;
+  if (!UseStealableTaskQueueOverflow) {
+    t = overflow_stack()->pop();
+    return true;
+  }
+  lock_overflow();
+  // A thief may have emptied the stack since the unlocked check above.
+  bool result = !overflow_empty();
+  if (result) {
+    t = overflow_stack()->pop();
+  }
+  unlock_overflow();
+  return result;
+}
+
+template <class E, MEMFLAGS F, unsigned int N>
+bool OverflowTaskQueue<E, F, N>::pop_overflow_global(OverflowTaskQueue<E, F, N>* thief, E& t)
+{
+  assert(thief != this, "cannot steal from own queue");
+  if (!UseStealableTaskQueueOverflow || overflow_empty()) return false;
+  lock_overflow();
+  if (overflow_empty()) {
+    unlock_overflow();
+    return false;
+  }
   t = overflow_stack()->pop();
+  // Take half of what is left.  The thief's TaskQueue is private to the
+  // calling thread, so pushing onto it needs no further synchronization;
+  // stop early if it fills up.
+  size_t n = overflow_stack()->size() / 2;
+  for (size_t i = 0; i < n; i++) {
+    E e = overflow_stack()->pop();
+    if (!thief->taskqueue_t::push(e)) {
+      overflow_stack()->push(e);
+      break;
+    }
+  }
+  unlock_overflow();
+  TASKQUEUE_STATS_ONLY(thief->stats.record_steal_overflow());
   return true;
 }
 
@@ -492,6 +587,8 @@ protected:
 public:
   // Returns "true" if some TaskQueue in the set contains a task.
   virtual bool peek() = 0;
+  // Returns an estimate of the number of tasks in the set.
+  virtual uint tasks() = 0;
 };
 
 template <MEMFLAGS F> class TaskQueueSetSuperImpl: public CHeapObj<F>, public TaskQueueSetSuper {
@@ -528,6 +625,7 @@ public:
   bool steal(uint queue_num, int* seed, E& t);
 
   bool peek();
+  uint tasks();
 };
 
 template<class T, MEMFLAGS F> void
@@ -563,12 +661,14 @@ GenericTaskQueueSet<T, F>::steal_best_of_2(uint queue_num, int* seed, E& t) {
     // Sample both and try the larger.
     uint sz1 = _queues[k1]->size();
     uint sz2 = _queues[k2]->size();
-    if (sz2 > sz1) return _queues[k2]->pop_global(t);
-    else return _queues[k1]->pop_global(t);
+    uint k = (sz2 > sz1) ? k2 : k1;
+    return _queues[k]->pop_global(t) ||
+           _queues[k]->pop_overflow_global(_queues[queue_num], t);
   } else if (_n == 2) {
     // Just try the other one.
     uint k = (queue_num + 1) % 2;
-    return _queues[k]->pop_global(t);
+    return _queues[k]->pop_global(t) ||
+           _queues[k]->pop_overflow_global(_queues[queue_num], t);
   } else {
     assert(_n == 1, "can't be zero.");
     return false;
@@ -585,6 +685,17 @@ bool GenericTaskQueueSet<T, F>::peek() {
   return false;
 }
 
+template<class T, MEMFLAGS F>
+uint GenericTaskQueueSet<T, F>::tasks() {
+  uint n = 0;
+  for (uint j = 0; j < _n; j++) {
+    uint sz = _queues[j]->size();
+    // A queue with only stealable overflow counts as holding one task.
+    n += (sz > 0 || !_queues[j]->peek()) ? sz : 1;
+  }
+  return n;
+}
+
 // When to terminate from the termination protocol.
 class TerminatorTerminator: public CHeapObj<mtInternal> {
 public:
@@ -593,6 +704,13 @@ public:
 
 // A class to aid in the termination of a set of parallel tasks using
 // TaskQueueSet's for work stealing.
+//
+// With UseOWSTTaskTerminator only one idle thread at a time, the spin
+// master, spins and polls the queue set.  The other idle threads block on
+// a monitor until the spin master sees stealable work and wakes as many of
+// them as there are tasks, or until all threads have offered termination.
+// This keeps the cost of termination roughly independent of the number of
+// threads.  Otherwise every idle thread spins, yields and sleeps on its own.
 
 #undef TRACESPINNING
 
@@ -602,6 +720,18 @@ private:
   TaskQueueSetSuper* _queue_set;
   int _offered_termination;
 
+  // Spin master protocol state, only used with UseOWSTTaskTerminator.
+  Monitor* _blocker;
+  Thread* volatile _spin_master;
+
+  // Statistics since the last reset, only gathered with
+  // PrintTerminationStats.
+  volatile jint  _stat_offers;
+  volatile jint  _stat_spin_masters;
+  volatile jint  _stat_wakeups;
+  volatile jint  _stat_sleeps;
+  volatile jlong _stat_ticks;
+
 #ifdef TRACESPINNING
   static uint _total_yields;
   static uint _total_spins;
@@ -609,6 +739,24 @@ private:
 #endif
 
   bool peek_in_queue_set();
+  bool exit_termination(uint tasks, TerminatorTerminator* terminator);
+
+  bool offer_termination_work(TerminatorTerminator* terminator);
+  // Every idle thread spins, yields and sleeps while polling the queue set.
+  bool offer_termination_spinning(TerminatorTerminator* terminator);
+  // Idle threads block on _blocker while the spin master polls.
+  bool offer_termination_owst(TerminatorTerminator* terminator);
+  // Spin and poll as the spin master.  Returns true if all threads have
+  // offered termination, false if work was found, or if the spin master
+  // role was given up and taken by another thread while sleeping.
+  bool do_spin_master_work(TerminatorTerminator* terminator);
+
+  void reset_stats();
+  void print_stats();
+
+  // Copies would share and double delete _blocker; use reset_for_reuse().
+  ParallelTaskTerminator(const ParallelTaskTerminator&);
+  ParallelTaskTerminator& operator=(const ParallelTaskTerminator&);
 protected:
   virtual void yield();
   void sleep(uint millis);
@@ -618,6 +766,7 @@ public:
   // "n_threads" is the number of threads to be terminated.  "queue_set" is a
   // queue sets of work queues of other threads.
   ParallelTaskTerminator(int n_threads, TaskQueueSetSuper* queue_set);
+  ~ParallelTaskTerminator();
 
   // The current thread has no work, and is ready to terminate if everyone
   // else is.  If returns "true", all threads are terminated.  If returns
@@ -25,13 +25,42 @@
 #include "precompiled.hpp"
 #include "runtime/os.hpp"
 #include "utilities/ticks.inline.hpp"
+#ifdef TARGET_ARCH_x86
+# include "rdtsc_x86.hpp"
+#endif
+
+// Select the time source; runs after VM_Version_init() and before the
+// first Ticks are taken.
+void ticks_init() {
+#ifdef TARGET_ARCH_x86
+  Rdtsc::initialize();
+#endif
+}
+
+jlong ElapsedCounterSource::now() {
+#ifdef TARGET_ARCH_x86
+  if (Rdtsc::is_enabled()) {
+    return Rdtsc::elapsed_counter();
+  }
+#endif
+  return os::elapsed_counter();
+}
+
+jlong ElapsedCounterSource::frequency() {
+#ifdef TARGET_ARCH_x86
+  if (Rdtsc::is_enabled()) {
+    return Rdtsc::frequency();
+  }
+#endif
+  return os::elapsed_frequency();
+}
 
 #ifdef ASSERT
  const jlong Ticks::invalid_time_stamp = -2; // 0xFFFF FFFF`FFFF FFFE
 #endif
 
 void Ticks::stamp() {
-  _stamp_ticks = os::elapsed_counter();
+  _stamp_ticks = ElapsedCounterSource::now();
 }
 
 const Ticks Ticks::now() {
@@ -54,7 +83,7 @@ static ReturnType time_conversion(const Tickspan& span, TicksToTimeHelper::Unit
   assert(TicksToTimeHelper::SECONDS == unit ||
          TicksToTimeHelper::MILLISECONDS == unit, "invalid unit!");
 
-  ReturnType frequency_per_unit = (ReturnType)os::elapsed_frequency() / (ReturnType)unit;
+  ReturnType frequency_per_unit = (ReturnType)ElapsedCounterSource::frequency() / (ReturnType)unit;
 
   return (ReturnType) ((ReturnType)span.value() / frequency_per_unit);
 }
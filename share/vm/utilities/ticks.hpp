@@ -30,6 +30,16 @@
 
 class Ticks;
 
+// The counter behind Ticks and trace event time stamps:
+// os::elapsed_counter(), or on x86 with -XX:+UseFastUnorderedTimeStamps
+// the invariant time-stamp counter, which is much cheaper to read.
+// Raw values are only comparable with values from the same source.
+class ElapsedCounterSource : AllStatic {
+ public:
+  static jlong now();
+  static jlong frequency();
+};
+
 class Tickspan VALUE_OBJ_CLASS_SPEC {
   friend class Ticks;
   friend Tickspan operator-(const Ticks& end, const Ticks& start);
@@ -179,6 +179,16 @@ void FlexibleWorkGang::run_task(AbstractGangTask* task) {
   WorkGang::run_task(task, (uint) active_workers());
 }
 
+void FlexibleWorkGang::run_task(AbstractGangTask* task, uint no_of_parallel_workers) {
+  assert(no_of_parallel_workers > 0, "Trying to run a task on no workers");
+  // Workers only start while needs_more_workers(), so temporarily lower
+  // _active_workers; the task is cleared before it is restored.
+  uint active_workers = _active_workers;
+  _active_workers = MIN2(no_of_parallel_workers, active_workers);
+  WorkGang::run_task(task, _active_workers);
+  _active_workers = active_workers;
+}
+
 void AbstractWorkGang::stop() {
   // Tell all workers to terminate, then wait for them to become inactive.
   MutexLockerEx ml(monitor(), Mutex::_no_safepoint_check_flag);
@@ -335,6 +335,9 @@ class FlexibleWorkGang: public WorkGang {
            "Unless dynamic should use total workers");
   }
   virtual void run_task(AbstractGangTask* task);
+  // Run the task on at most no_of_parallel_workers of the active workers,
+  // without changing active_workers() for later tasks.
+  void run_task(AbstractGangTask* task, uint no_of_parallel_workers);
   virtual bool needs_more_workers() const {
     return _started_workers < _active_workers;
   }